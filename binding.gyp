@@ -29,6 +29,7 @@
         './src/compiler-option.cc',
         './src/utils/os.cc',
         './src/parser/token.cc',
+        './src/utils/number-converter.cc',
         './lib/gtest/gtest-all.cc',
         './test/parser/scanner-keyword-scan-test.cc',
         './test/parser/scanner-operator-scan-test.cc',
@@ -181,6 +181,30 @@ def BuildConfig() :
       '''
     },
   ], 'alignof is required.')
+  builder.CheckStruct(False, [
+    {
+      'name': 'builtin_popcount',
+      'code': '''
+        int Test(unsigned long long x) {return __builtin_popcountll(x) + __builtin_ctzll(x);}
+      '''
+    },
+    {
+      'name': 'popcnt64',
+      'header': ['intrin.h'],
+      'code': '''
+        int Test(unsigned __int64 x) {unsigned long i; _BitScanForward64(&i, x); return static_cast<int>(__popcnt64(x) + i);}
+      '''
+    }
+  ], 'popcount intrinsic is not found.')
+  builder.CheckStruct(False, [
+    {
+      'name': 'sse2',
+      'header': ['emmintrin.h'],
+      'code': '''
+        int Test(const char* p) {return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), _mm_set1_epi8(10)));}
+      '''
+    }
+  ], 'sse2 is not found.')
   builder.AddMacroCode("""
   #if defined(__x86_64__) || defined(_M_X64)
     #define PLATFORM_64BIT
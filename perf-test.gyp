@@ -61,6 +61,146 @@
         './src/utils/os.cc',
         './perfs/utils/intrusive-rb-tree-test.cc',
       ],
+    },
+    {
+      'target_name': "literalbuffer_perf_test",
+      'product_name': 'LiteralBufferPerfTest',
+      'type': 'executable',
+      'defines' : ['UNIT_TEST=1'],
+      'include_dirs': ['/usr/local/include', './lib', './Celero/include'],
+      'sources': [
+        './src/utils/utils.cc',
+        './src/utils/tls.cc',
+        './src/utils/systeminfo.cc',
+        './src/memory/virtual-heap-allocator.cc',
+        './src/memory/aligned-heap-allocator.cc',
+        './src/memory/heap-allocator/chunk-header.cc',
+        './src/memory/heap-allocator/arena.cc',
+        './src/memory/heap-allocator/heap-allocator.cc',
+        './src/parser/unicode-cache.cc',
+        './src/utils/os.cc',
+        './perfs/parser/literalbuffer-perf-test.cc',
+      ],
+    },
+    {
+      'target_name': "packrat_perf_test",
+      'product_name': 'PackratPerfTest',
+      'type': 'executable',
+      'defines' : ['UNIT_TEST=1'],
+      'include_dirs': ['/usr/local/include', './lib', './Celero/include'],
+      'sources': [
+        './src/utils/utils.cc',
+        './src/utils/tls.cc',
+        './src/utils/systeminfo.cc',
+        './src/memory/virtual-heap-allocator.cc',
+        './src/memory/aligned-heap-allocator.cc',
+        './src/memory/heap-allocator/chunk-header.cc',
+        './src/memory/heap-allocator/arena.cc',
+        './src/memory/heap-allocator/heap-allocator.cc',
+        './src/compiler/module-info.cc',
+        './src/utils/path.cc',
+        './src/utils/os.cc',
+        './src/compiler-option.cc',
+        './src/parser/token.cc',
+        './src/utils/number-converter.cc',
+        './src/parser/error-reporter.cc',
+        './src/parser/error-formatter.cc',
+        './src/parser/sourcestream.cc',
+        './src/parser/unicode-cache.cc',
+        './src/utils/environment.cc',
+        './src/ir/node.cc',
+        './src/ir/scope.cc',
+        './src/ir/types.cc',
+        './perfs/parser/packrat-perf-test.cc',
+      ],
+    },
+    {
+      'target_name': "binary_expression_perf_test",
+      'product_name': 'BinaryExpressionPerfTest',
+      'type': 'executable',
+      'defines' : ['UNIT_TEST=1'],
+      'include_dirs': ['/usr/local/include', './lib', './Celero/include'],
+      'sources': [
+        './src/utils/utils.cc',
+        './src/utils/tls.cc',
+        './src/utils/systeminfo.cc',
+        './src/memory/virtual-heap-allocator.cc',
+        './src/memory/aligned-heap-allocator.cc',
+        './src/memory/heap-allocator/chunk-header.cc',
+        './src/memory/heap-allocator/arena.cc',
+        './src/memory/heap-allocator/heap-allocator.cc',
+        './src/compiler/module-info.cc',
+        './src/utils/path.cc',
+        './src/utils/os.cc',
+        './src/compiler-option.cc',
+        './src/parser/token.cc',
+        './src/utils/number-converter.cc',
+        './src/parser/error-reporter.cc',
+        './src/parser/error-formatter.cc',
+        './src/parser/sourcestream.cc',
+        './src/parser/unicode-cache.cc',
+        './src/utils/environment.cc',
+        './src/ir/node.cc',
+        './src/ir/scope.cc',
+        './src/ir/types.cc',
+        './perfs/parser/binary-expression-perf-test.cc',
+      ],
+    },
+    {
+      'target_name': "node_perf_test",
+      'product_name': 'NodePerfTest',
+      'type': 'executable',
+      'defines' : ['UNIT_TEST=1'],
+      'include_dirs': ['/usr/local/include', './lib', './Celero/include'],
+      'sources': [
+        './src/utils/utils.cc',
+        './src/utils/tls.cc',
+        './src/utils/systeminfo.cc',
+        './src/memory/virtual-heap-allocator.cc',
+        './src/memory/aligned-heap-allocator.cc',
+        './src/memory/heap-allocator/chunk-header.cc',
+        './src/memory/heap-allocator/arena.cc',
+        './src/memory/heap-allocator/heap-allocator.cc',
+        './src/compiler/module-info.cc',
+        './src/utils/path.cc',
+        './src/utils/os.cc',
+        './src/compiler-option.cc',
+        './src/parser/token.cc',
+        './src/utils/number-converter.cc',
+        './src/parser/error-reporter.cc',
+        './src/parser/error-formatter.cc',
+        './src/parser/sourcestream.cc',
+        './src/parser/unicode-cache.cc',
+        './src/utils/environment.cc',
+        './src/ir/node.cc',
+        './src/ir/scope.cc',
+        './src/ir/types.cc',
+        './perfs/ir/node-perf-test.cc',
+      ],
+    },
+    {
+      'target_name': "scope_perf_test",
+      'product_name': 'ScopePerfTest',
+      'type': 'executable',
+      'defines' : ['UNIT_TEST=1'],
+      'include_dirs': ['/usr/local/include', './lib', './Celero/include'],
+      'sources': [
+        './src/utils/utils.cc',
+        './src/utils/tls.cc',
+        './src/utils/systeminfo.cc',
+        './src/memory/virtual-heap-allocator.cc',
+        './src/memory/aligned-heap-allocator.cc',
+        './src/memory/heap-allocator/chunk-header.cc',
+        './src/memory/heap-allocator/arena.cc',
+        './src/memory/heap-allocator/heap-allocator.cc',
+        './src/utils/os.cc',
+        './src/parser/unicode-cache.cc',
+        './src/utils/environment.cc',
+        './src/ir/node.cc',
+        './src/ir/scope.cc',
+        './src/ir/types.cc',
+        './perfs/ir/scope-perf-test.cc',
+      ],
     }
   ]
 }
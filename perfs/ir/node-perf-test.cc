@@ -0,0 +1,112 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2013 Taketoshi Aono(brn)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#include <celero/Celero.h>
+#include "../../src/compiler/module-info.h"
+#include "../../src/compiler-option.h"
+#include "../../src/ir/irfactory.h"
+#include "../../src/ir/node.h"
+#include "../../src/ir/scope.h"
+#include "../../src/parser/literalbuffer.h"
+#include "../../src/parser/parser.h"
+#include "../../src/utils/notificator.h"
+
+namespace {
+static const int kSamples = 10;
+static const int kFunctionCount = 512;
+}
+
+
+// The tree of the typical statements and expressions.
+// The traversal reads the children of all nodes,
+// so the time depends on the size of the node and the place of the children.
+class NodeFixture: public celero::TestFixture {
+ public:
+  NodeFixture()
+      : code_(Functions()),
+        root_(nullptr) {
+    root_ = Parse();
+  }
+
+
+  yatsc::ir::Node* Parse() {
+    typedef yatsc::SourceStream::iterator Iterator;
+    auto module_info = yatsc::Heap::NewHandle<yatsc::ModuleInfo>(yatsc::String("anonymous"), code_, true);
+    yatsc::CompilerOption compiler_option;
+    compiler_option.set_language_mode(yatsc::LanguageMode::ES6);
+    auto lb = yatsc::Heap::NewHandle<yatsc::LiteralBuffer>();
+    auto global_scope = yatsc::Heap::NewHandle<yatsc::ir::GlobalScope>(lb);
+    irfactory_ = yatsc::Heap::NewHandle<yatsc::ir::IRFactory>();
+    yatsc::Scanner<Iterator> scanner(module_info->source_stream()->begin(), module_info->source_stream()->end(), lb.Get(), compiler_option);
+    yatsc::Notificator<void(const yatsc::String&)> notificator;
+    yatsc::Parser<Iterator> parser(compiler_option, &scanner, notificator, irfactory_, module_info, global_scope);
+    auto result = parser.Parse();
+    return result? result.value(): nullptr;
+  }
+
+
+  // Visit all nodes in the depth first order.
+  static size_t Traverse(yatsc::ir::Node* node) {
+    size_t count = 1;
+    for (auto child: *node) {
+      if (child != nullptr) {
+        count += Traverse(child);
+      }
+    }
+    return count;
+  }
+
+ protected:
+  static yatsc::String Functions() {
+    yatsc::StringStream ss;
+    for (int i = 0; i < kFunctionCount; i++) {
+      ss << "function f" << i << "(a: number, b) {\n"
+         << "  var x = a.b.c(1, 'value') + b[0] * 2;\n"
+         << "  if (x > 0) {\n"
+         << "    return this.g(x, [1, 2, 3]);\n"
+         << "  } else {\n"
+         << "    return {key: x, value: null};\n"
+         << "  }\n"
+         << "}\n";
+    }
+    return ss.str();
+  }
+
+  
+  yatsc::String code_;
+  yatsc::Handle<yatsc::ir::IRFactory> irfactory_;
+  yatsc::ir::Node* root_;
+};
+
+
+CELERO_MAIN;
+
+
+BASELINE_F(Node, Parse, NodeFixture, kSamples, 10) {
+  celero::DoNotOptimizeAway(Parse());
+}
+
+
+BENCHMARK_F(Node, Traverse, NodeFixture, kSamples, 100) {
+  celero::DoNotOptimizeAway(Traverse(root_));
+}
@@ -0,0 +1,112 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2013 Taketoshi Aono(brn)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+
+#include <celero/Celero.h>
+#include "../../src/ir/irfactory.h"
+#include "../../src/ir/node.h"
+#include "../../src/ir/scope.h"
+#include "../../src/parser/literalbuffer.h"
+
+namespace {
+static const int kSamples = 10;
+static const int kSmallScopeSize = 4;
+static const int kLargeScopeSize = 256;
+}
+
+
+// Declare the variables in the scope and find the all of them.
+// The baseline is the multimap keyed by the copy of the name string,
+// that is the way the scope found the items before the items are keyed by the literal id.
+class ScopeFixture: public celero::TestFixture {
+ public:
+  ScopeFixture()
+      : literal_buffer_(yatsc::Heap::NewHandle<yatsc::LiteralBuffer>()),
+        global_scope_(yatsc::Heap::NewHandle<yatsc::ir::GlobalScope>(literal_buffer_)) {
+    for (int i = 0; i < kLargeScopeSize; i++) {
+      yatsc::UtfString utf_string(("name" + std::to_string(i)).c_str());
+      auto symbol = irfactory_.NewSymbol(yatsc::ir::SymbolType::kVariableName, literal_buffer_->InsertValue(utf_string));
+      variables_.push_back(irfactory_.New<yatsc::ir::VariableView>(
+          irfactory_.New<yatsc::ir::NameView>(symbol), nullptr, nullptr));
+    }
+  }
+
+
+  size_t StringMap(int size) {
+    yatsc::MultiHashMap<std::string, yatsc::ir::GatheredTypeInfo> map;
+    for (int i = 0; i < size; i++) {
+      auto name = variables_[i]->first_child();
+      map.insert(std::make_pair(std::string(name->symbol()->utf8_value()),
+                                yatsc::ir::GatheredTypeInfo(global_scope_->phai_type(), variables_[i],
+                                                            yatsc::ir::Type::Modifier::kPublic)));
+    }
+    size_t found = 0;
+    for (int i = 0; i < size; i++) {
+      auto range = map.equal_range(std::string(variables_[i]->first_child()->symbol()->utf8_value()));
+      found += range.first != map.end()? 1: 0;
+    }
+    return found;
+  }
+
+
+  size_t Scope(int size) {
+    auto scope = yatsc::Heap::NewHandle<yatsc::ir::Scope>(global_scope_, global_scope_);
+    for (int i = 0; i < size; i++) {
+      scope->Declare(variables_[i]);
+    }
+    size_t found = 0;
+    for (int i = 0; i < size; i++) {
+      found += scope->FindDeclaredItem(variables_[i]->first_child()->symbol())? 1: 0;
+    }
+    return found;
+  }
+
+ protected:
+  yatsc::ir::IRFactory irfactory_;
+  yatsc::Handle<yatsc::LiteralBuffer> literal_buffer_;
+  yatsc::Handle<yatsc::ir::GlobalScope> global_scope_;
+  yatsc::Vector<yatsc::ir::Node*> variables_;
+};
+
+
+CELERO_MAIN;
+
+
+BASELINE_F(SmallScope, StringMap, ScopeFixture, kSamples, 10000) {
+  celero::DoNotOptimizeAway(StringMap(kSmallScopeSize));
+}
+
+
+BENCHMARK_F(SmallScope, Scope, ScopeFixture, kSamples, 10000) {
+  celero::DoNotOptimizeAway(Scope(kSmallScopeSize));
+}
+
+
+BASELINE_F(LargeScope, StringMap, ScopeFixture, kSamples, 100) {
+  celero::DoNotOptimizeAway(StringMap(kLargeScopeSize));
+}
+
+
+BENCHMARK_F(LargeScope, Scope, ScopeFixture, kSamples, 100) {
+  celero::DoNotOptimizeAway(Scope(kLargeScopeSize));
+}
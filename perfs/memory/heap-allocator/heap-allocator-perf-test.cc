@@ -286,3 +286,40 @@ BENCHMARK(HeapAllocatorShared, NewHandle, kSamples, 100) {
     vec.push_back(v);
   }
 }
+
+
+
+BASELINE(HandleCopy, Handle, kSamples, 100) {
+  uint64_t ok = 0u;
+  auto handle = yatsc::Heap::NewHandle<Test1<uint64_t>>(&ok);
+  for (size_t i = 0u; i < kSize; i++) {
+    yatsc::Handle<Test1<uint64_t>> copy = handle;
+    celero::DoNotOptimizeAway(copy->x);
+  }
+}
+
+
+BENCHMARK(HandleCopy, LocalHandle, kSamples, 100) {
+  uint64_t ok = 0u;
+  auto handle = yatsc::Heap::NewLocalHandle<Test1<uint64_t>>(&ok);
+  for (size_t i = 0u; i < kSize; i++) {
+    yatsc::LocalHandle<Test1<uint64_t>> copy = handle;
+    celero::DoNotOptimizeAway(copy->x);
+  }
+}
+
+
+BASELINE(HandleNewAndDestroy, Handle, kSamples, 100) {
+  uint64_t ok = 0u;
+  for (size_t i = 0u; i < kSize; i++) {
+    auto handle = yatsc::Heap::NewHandle<Test1<uint64_t>>(&ok);
+  }
+}
+
+
+BENCHMARK(HandleNewAndDestroy, LocalHandle, kSamples, 100) {
+  uint64_t ok = 0u;
+  for (size_t i = 0u; i < kSize; i++) {
+    auto handle = yatsc::Heap::NewLocalHandle<Test1<uint64_t>>(&ok);
+  }
+}
@@ -0,0 +1,99 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2013 Taketoshi Aono(brn)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#include <celero/Celero.h>
+#include "../../src/compiler/module-info.h"
+#include "../../src/compiler-option.h"
+#include "../../src/ir/irfactory.h"
+#include "../../src/ir/scope.h"
+#include "../../src/parser/literalbuffer.h"
+#include "../../src/parser/parser.h"
+#include "../../src/utils/notificator.h"
+
+namespace {
+static const int kSamples = 10;
+static const int kOperandCount = 256;
+static const char* kOperators[] = {"*", "+", "<<", "<", "==", "&", "^", "|", "&&", "||"};
+}
+
+
+// The binary expressions are parsed by the precedence climbing,
+// so the cost of an operand should not depend on the count of the priority levels.
+class BinaryExpressionFixture: public celero::TestFixture {
+ public:
+  BinaryExpressionFixture()
+      : operands_(Join(",")),
+        same_priority_(Join("+")),
+        mixed_priority_(Join(nullptr)) {}
+
+  
+  void Parse(const yatsc::String& code) {
+    typedef yatsc::SourceStream::iterator Iterator;
+    auto module_info = yatsc::Heap::NewHandle<yatsc::ModuleInfo>(yatsc::String("anonymous"), code, true);
+    yatsc::CompilerOption compiler_option;
+    compiler_option.set_language_mode(yatsc::LanguageMode::ES6);
+    auto lb = yatsc::Heap::NewHandle<yatsc::LiteralBuffer>();
+    auto global_scope = yatsc::Heap::NewHandle<yatsc::ir::GlobalScope>(lb);
+    auto irfactory = yatsc::Heap::NewHandle<yatsc::ir::IRFactory>();
+    yatsc::Scanner<Iterator> scanner(module_info->source_stream()->begin(), module_info->source_stream()->end(), lb.Get(), compiler_option);
+    yatsc::Notificator<void(const yatsc::String&)> notificator;
+    yatsc::Parser<Iterator> parser(compiler_option, &scanner, notificator, irfactory, module_info, global_scope);
+    celero::DoNotOptimizeAway(parser.ParseExpression());
+  }
+
+ protected:
+  // Join the operands by the operator,
+  // or by the all binary operators in turn if the operator is nullptr.
+  static yatsc::String Join(const char* op) {
+    yatsc::StringStream ss;
+    ss << "x0";
+    for (int i = 1; i < kOperandCount; i++) {
+      ss << ' ' << (op != nullptr? op: kOperators[i % (sizeof(kOperators) / sizeof(kOperators[0]))]) << " x" << i;
+    }
+    return ss.str();
+  }
+
+  
+  yatsc::String operands_;
+  yatsc::String same_priority_;
+  yatsc::String mixed_priority_;
+};
+
+
+CELERO_MAIN;
+
+
+// The operands that are separated by the comma, no binary operator is parsed.
+BASELINE_F(BinaryExpression, Operands, BinaryExpressionFixture, kSamples, 100) {
+  Parse(operands_);
+}
+
+
+BENCHMARK_F(BinaryExpression, SamePriority, BinaryExpressionFixture, kSamples, 100) {
+  Parse(same_priority_);
+}
+
+
+BENCHMARK_F(BinaryExpression, MixedPriority, BinaryExpressionFixture, kSamples, 100) {
+  Parse(mixed_priority_);
+}
@@ -0,0 +1,119 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2013 Taketoshi Aono(brn)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#include <celero/Celero.h>
+#include <thread>
+#include "../../src/parser/literalbuffer.h"
+#include "../../src/utils/spinlock.h"
+#include "../../src/utils/systeminfo.h"
+
+namespace {
+size_t thread_size = yatsc::SystemInfo::GetOnlineProcessorCount();
+static const size_t kThreadSize = thread_size == 0? 1: thread_size;
+static const size_t kVocabularySize = 2000;
+static const size_t kHotVocabularySize = 256;
+static const size_t kInternCount = 50000;
+static const size_t kSamples = 10;
+}
+
+
+// The single spin-locked HashMap that was used before the sharded buffer.
+class LockedLiteralBuffer {
+  typedef yatsc::HashMap<yatsc::Utf16String, yatsc::Literal> UtfStringBuffer;
+ public:
+  yatsc::Literal* InsertValue(const yatsc::UtfString& utf_string) {
+    yatsc::ScopedSpinLock lock(lock_);
+    UtfStringBuffer::iterator found = buffer_.find(utf_string.utf16_string());
+    if (found != buffer_.end()) {
+      return &(found->second);
+    }
+    auto ret = buffer_.insert(std::make_pair(utf_string.utf16_string(), yatsc::Literal(utf_string)));
+    return &(ret.first->second);
+  }
+  
+ private:
+  yatsc::SpinLock lock_;
+  UtfStringBuffer buffer_;
+};
+
+
+// Each thread interns the identifiers of the small vocabulary repeatedly,
+// like the scanner threads which lex the same names over and over.
+class LiteralBufferFixture: public celero::TestFixture {
+ public:
+  LiteralBufferFixture() {
+    for (size_t i = 0; i < kVocabularySize; i++) {
+      yatsc::StringStream ss;
+      ss << "identifier" << i;
+      vocabulary_.push_back(yatsc::UtfString(ss.str()));
+    }
+  }
+
+
+  template <typename Buffer>
+  void Run(Buffer* buffer, size_t vocabulary_size = kVocabularySize) {
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < kThreadSize; i++) {
+      threads.push_back(std::thread([this, buffer, i, vocabulary_size]() {
+        for (size_t j = 0; j < kInternCount; j++) {
+          celero::DoNotOptimizeAway(buffer->InsertValue(vocabulary_[(j * 31 + i) % vocabulary_size]));
+        }
+      }));
+    }
+    for (auto& th: threads) {
+      th.join();
+    }
+  }
+
+ protected:
+  std::vector<yatsc::UtfString> vocabulary_;
+};
+
+
+CELERO_MAIN;
+
+
+BASELINE_F(ThreadedLiteralBuffer, Baseline, LiteralBufferFixture, kSamples, 10) {
+  LockedLiteralBuffer buffer;
+  Run(&buffer);
+}
+
+
+BENCHMARK_F(ThreadedLiteralBuffer, InsertValue, LiteralBufferFixture, kSamples, 10) {
+  yatsc::LiteralBuffer buffer;
+  Run(&buffer);
+}
+
+
+// Only the few hundreds of the names like this, length or string are interned,
+// so almost all lookups are answered by the LiteralCache of each thread.
+BASELINE_F(HotLiteralBuffer, Baseline, LiteralBufferFixture, kSamples, 10) {
+  LockedLiteralBuffer buffer;
+  Run(&buffer, kHotVocabularySize);
+}
+
+
+BENCHMARK_F(HotLiteralBuffer, InsertValue, LiteralBufferFixture, kSamples, 10) {
+  yatsc::LiteralBuffer buffer;
+  Run(&buffer, kHotVocabularySize);
+}
@@ -0,0 +1,93 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2013 Taketoshi Aono(brn)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <celero/Celero.h>
+#include "../../src/compiler/module-info.h"
+#include "../../src/compiler-option.h"
+#include "../../src/ir/irfactory.h"
+#include "../../src/ir/scope.h"
+#include "../../src/parser/literalbuffer.h"
+#include "../../src/parser/parser.h"
+#include "../../src/utils/notificator.h"
+
+namespace {
+static const int kSamples = 10;
+static const int kShallowDepth = 8;
+static const int kDeepDepth = 16;
+}
+
+
+// The nested assignment patterns like ({a: ({a: x} = y)} = z).
+// Each object literal is parsed again as the assignment pattern,
+// so the parse time is doubled by each nesting level without the memo.
+class PackratFixture: public celero::TestFixture {
+ public:
+  PackratFixture()
+      : shallow_(NestedAssignmentPattern(kShallowDepth)),
+        deep_(NestedAssignmentPattern(kDeepDepth)) {}
+
+  
+  void Parse(const yatsc::String& code) {
+    typedef yatsc::SourceStream::iterator Iterator;
+    auto module_info = yatsc::Heap::NewHandle<yatsc::ModuleInfo>(yatsc::String("anonymous"), code, true);
+    yatsc::CompilerOption compiler_option;
+    compiler_option.set_language_mode(yatsc::LanguageMode::ES6);
+    auto lb = yatsc::Heap::NewHandle<yatsc::LiteralBuffer>();
+    auto global_scope = yatsc::Heap::NewHandle<yatsc::ir::GlobalScope>(lb);
+    auto irfactory = yatsc::Heap::NewHandle<yatsc::ir::IRFactory>();
+    yatsc::Scanner<Iterator> scanner(module_info->source_stream()->begin(), module_info->source_stream()->end(), lb.Get(), compiler_option);
+    yatsc::Notificator<void(const yatsc::String&)> notificator;
+    yatsc::Parser<Iterator> parser(compiler_option, &scanner, notificator, irfactory, module_info, global_scope);
+    celero::DoNotOptimizeAway(parser.ParseExpression());
+  }
+
+ protected:
+  static yatsc::String NestedAssignmentPattern(int depth) {
+    yatsc::StringStream ss;
+    for (int i = 0; i < depth; i++) {
+      ss << "({value" << i << ": ";
+    }
+    ss << "x";
+    for (int i = 0; i < depth; i++) {
+      ss << "} = object" << i << ")";
+    }
+    return ss.str();
+  }
+
+  
+  yatsc::String shallow_;
+  yatsc::String deep_;
+};
+
+
+CELERO_MAIN;
+
+
+BASELINE_F(NestedAssignmentPattern, Shallow, PackratFixture, kSamples, 10) {
+  Parse(shallow_);
+}
+
+
+// With the memo, this should be about twice as slow as the Shallow.
+BENCHMARK_F(NestedAssignmentPattern, Deep, PackratFixture, kSamples, 10) {
+  Parse(deep_);
+}
@@ -28,7 +28,13 @@ namespace yatsc {
 CompilerOption::CompilerOption()
     : language_mode_(LanguageMode::ES6),
       module_type_(ModuleType::ES6),
-      output_language_mode_(LanguageMode::ES5_STRICT) {}
+      output_language_mode_(LanguageMode::ES5_STRICT),
+      parallel_scan_threshold_(1024 * 1024 * 4),
+      parallel_parse_threshold_(0),
+      comment_policy_(CommentPolicy::FULL),
+      lazy_function_body_(false),
+      syntax_check_only_(false),
+      prescan_dependencies_(true) {}
 
 const char* LanguageModeUtil::kEs3 = {"es3"};
 const char* LanguageModeUtil::kEs5Strict = {"es5strict"};
@@ -39,6 +39,15 @@ enum class ModuleType: uint8_t {
   ES6
 };
 
+// How the scanner retains the multi line comments.
+// DROP discards them, SPAN retains only the range in the source,
+// and FULL retains the range and the copy of the text.
+enum class CommentPolicy: uint8_t {
+  DROP = 0,
+  SPAN,
+  FULL
+};
+
 
 class CompilerOption {
  public:
@@ -49,11 +58,41 @@ class CompilerOption {
   YATSC_CONST_PROPERTY(LanguageMode, output_language_mode, output_language_mode_)
   
   YATSC_CONST_PROPERTY(ModuleType, module_type, module_type_)
+
+  // The source which size is larger than this is scanned by the ParallelScanner.
+  // 0 disables the parallel scanning.
+  YATSC_CONST_PROPERTY(size_t, parallel_scan_threshold, parallel_scan_threshold_)
+
+  // The source which size is larger than this is splitted at the file scope statements
+  // and parsed by the ParallelParser.
+  // 0 disables the parallel parsing.
+  YATSC_CONST_PROPERTY(size_t, parallel_parse_threshold, parallel_parse_threshold_)
+
+  YATSC_CONST_PROPERTY(CommentPolicy, comment_policy, comment_policy_)
+
+  // If true, the function bodies are skipped by the preparser
+  // and parsed when they are demanded.
+  YATSC_CONST_PROPERTY(bool, lazy_function_body, lazy_function_body_)
+
+  // If true, the parser only validates the syntax.
+  // The same errors are reported, but the ir is discarded after each file scope statement
+  // and the parser returns the empty file scope.
+  YATSC_CONST_PROPERTY(bool, syntax_check_only, syntax_check_only_)
+
+  // If true, the imported modules are found from the tokens before the module is parsed,
+  // and scheduled without waiting for the parser.
+  YATSC_CONST_PROPERTY(bool, prescan_dependencies, prescan_dependencies_)
   
  private:
   LanguageMode language_mode_;
   LanguageMode output_language_mode_;
   ModuleType module_type_;
+  size_t parallel_scan_threshold_;
+  size_t parallel_parse_threshold_;
+  CommentPolicy comment_policy_;
+  bool lazy_function_body_;
+  bool syntax_check_only_;
+  bool prescan_dependencies_;
 };
 
 
@@ -22,9 +22,50 @@
 
 
 #include "./compilation-unit.h"
+#include "../ir/node-visitor.h"
 
 namespace yatsc {
 
+// Count the bytes of the nodes, the children lists and the scopes of the tree.
+class MemoryUsageVisitor: public ir::NodeVisitor<MemoryUsageVisitor> {
+ public:
+  MemoryUsageVisitor(MemoryUsage* memory_usage)
+      : memory_usage_(memory_usage) {}
+
+
+  ir::VisitResult EnterNode(ir::Node* node) {
+    memory_usage_->set_ir_nodes(memory_usage_->ir_nodes() + node->AllocatedSize());
+    memory_usage_->set_child_lists(memory_usage_->child_lists() + node->node_list().zone_storage_size());
+    return ir::VisitResult::kContinue;
+  }
+
+
+  ir::VisitResult EnterBlockView(ir::BlockView* node) {
+    AddScope(node->scope());
+    return EnterNode(node);
+  }
+
+
+  ir::VisitResult EnterFileScopeView(ir::FileScopeView* node) {
+    AddScope(node->scope());
+    return EnterNode(node);
+  }
+
+ private:
+  // The scope may be shared by the views, so the scope is counted once.
+  void AddScope(Handle<ir::Scope> scope) {
+    if (scope && scopes_.insert(scope.Get()).second) {
+      memory_usage_->set_scopes(memory_usage_->scopes() + scope->AllocatedSize());
+    }
+  }
+
+  
+  MemoryUsage* memory_usage_;
+  HashSet<ir::Scope*> scopes_;
+};
+
+
+
 CompilationUnit::CompilationUnit(ir::Node* root,
                                  Handle<ir::IRFactory> irfactory,
                                  Handle<ModuleInfo> module_info,
@@ -36,18 +77,49 @@ CompilationUnit::CompilationUnit(ir::Node* root,
 
 
 CompilationUnit::CompilationUnit(Handle<ModuleInfo> module_info)
-    : module_info_(module_info) {}
+    : root_(nullptr),
+      module_info_(module_info) {}
 
 
 CompilationUnit::CompilationUnit(const CompilationUnit& compilation_unit)
     : root_(compilation_unit.root_),
+      irfactory_(compilation_unit.irfactory_),
       module_info_(compilation_unit.module_info_),
       literal_buffer_(compilation_unit.literal_buffer_) {}
 
 
 CompilationUnit::CompilationUnit(CompilationUnit&& compilation_unit)
     : root_(std::move(compilation_unit.root_)),
+      irfactory_(std::move(compilation_unit.irfactory_)),
       module_info_(std::move(compilation_unit.module_info_)),
       literal_buffer_(std::move(compilation_unit.literal_buffer_)) {}
 
+
+MemoryUsage CompilationUnit::GetMemoryUsage() const {
+  MemoryUsage memory_usage;
+  Handle<ModuleInfo> module_info = module_info_;
+  memory_usage.set_source(module_info->source_stream()->size());
+
+  size_t errors = 0;
+  auto error_reporter = module_info->error_reporter();
+  for (auto& error: error_reporter->errors()) {
+    errors += sizeof(ErrorDescriptor) + error->message().size();
+  }
+  for (auto& warning: error_reporter->warnings()) {
+    errors += sizeof(ErrorDescriptor) + warning->message().size();
+  }
+  memory_usage.set_errors(errors);
+
+  if (irfactory_) {
+    memory_usage.set_symbols(irfactory_->symbol_count() * sizeof(ir::Symbol));
+    memory_usage.set_ir_zone(irfactory_->zone_size());
+  }
+
+  if (root_ != nullptr) {
+    MemoryUsageVisitor visitor(&memory_usage);
+    visitor.Walk(root_);
+  }
+  return memory_usage;
+}
+
 }
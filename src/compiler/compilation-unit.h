@@ -31,7 +31,9 @@
 #include "../utils/stl.h"
 #include "../ir/node.h"
 #include "./module-info.h"
+#include "./memory-usage.h"
 #include "../ir/irfactory.h"
+#include "../ir/ast-image.h"
 
 
 namespace yatsc {
@@ -61,9 +63,27 @@ class CompilationUnit {
 
   YATSC_GETTER(Handle<ModuleInfo>, module_info, module_info_)
 
+
+  YATSC_GETTER(ir::Node*, root, root_)
+
+
+  YATSC_GETTER(Handle<ir::IRFactory>, irfactory, irfactory_)
+
+
+  // Return the binary image of the ir of the module.
+  // The image is independent of this unit, so it can be passed to the other process.
+  Vector<Byte> ToAstImage() {return ir::AstImage::Write(root_);}
+
+
+  // Return the bytes used by the module for each category.
+  // The ir is walked to count the nodes, so this is not cheap.
+  MemoryUsage GetMemoryUsage() const;
+
   
  private:
   ir::Node* root_;
+  // The nodes and the children lists of the module are allocated in the zone of this factory,
+  // so the whole ir of the module is released with the last CompilationUnit.
   Handle<ir::IRFactory> irfactory_;
   Handle<ModuleInfo> module_info_;
   Handle<LiteralBuffer> literal_buffer_;
@@ -22,11 +22,15 @@
 
 
 #include "./compiler.h"
+#include "../parser/dependency-scanner.h"
 #include "../parser/literalbuffer.h"
+#include "../parser/parallel-parser.h"
+#include "../parser/parallel-scanner.h"
 #include "../parser/parser.h"
 #include "../parser/scanner.h"
 #include "../parser/sourcestream.h"
 #include "../utils/path.h"
+#include "../ir/scope-resolver.h"
 #include "./module-info.h"
 #include "./thread-pool.h"
 #include "../utils/systeminfo.h"
@@ -54,6 +58,45 @@ Vector<Handle<CompilationUnit>> Compiler::Compile(const char* filename) {
 }
 
 
+MemoryUsage Compiler::GetMemoryUsage() {
+  std::lock_guard<SpinLock> lock(lock_);
+  MemoryUsage memory_usage;
+  for (auto& compilation_unit: result_list_) {
+    memory_usage += compilation_unit->GetMemoryUsage();
+  }
+  return memory_usage;
+}
+
+
+Maybe<ir::Node*> Compiler::ParseLazyFunctionBody(Handle<CompilationUnit> compilation_unit, ir::Node* function) {
+  auto module_info = compilation_unit->module_info();
+  auto source_stream = module_info->source_stream();
+  Scanner<SourceStream::iterator> scanner(
+      source_stream->begin(),
+      source_stream->end(),
+      literal_buffer_.Get(),
+      compiler_option_);
+
+  // The modules are already scheduled, so the modules which are found in the body are not notified.
+  Notificator<void(const String&)> notificator;
+  Parser<SourceStream::iterator> parser(compiler_option_, &scanner, notificator, compilation_unit->irfactory(),
+                                        module_info, global_scope_);
+  ParseResult result;
+  try {
+    result = parser.ParseLazyFunctionBody(function);
+  } catch(const FatalParseError& fpe) {
+    return Nothing<ir::Node*>();
+  }
+
+  // The names in the body are bound same as the names in the rest of the module.
+  if (result && !module_info->HasError()) {
+    ir::ScopeResolver scope_resolver;
+    scope_resolver.Resolve(result.value());
+  }
+  return result;
+}
+
+
 void Compiler::Schedule(const String& filename) {
   auto module_info = ModuleInfo::Create(filename);
   
@@ -83,13 +126,53 @@ void Compiler::Run(Handle<ModuleInfo> module_info) {
       literal_buffer_.Get(),
       compiler_option_);
 
+  size_t threshold = compiler_option_.parallel_scan_threshold();
+  size_t parse_threshold = compiler_option_.parallel_parse_threshold();
+  bool parallel_parse = parse_threshold > 0 && source_stream->size() >= parse_threshold;
+  bool parallel_scan = parallel_parse || (threshold > 0 && source_stream->size() >= threshold);
+  Handle<ParallelScanner::SourceTokenArray> token_array;
+  
+  // The ParallelParser splits the module by the tokens and the DependencyScanner finds the modules from the tokens,
+  // so the tokens are scanned before parsing.
+  // The small source is scanned by the single chunk.
+  if (parallel_scan || compiler_option_.prescan_dependencies()) {
+    ParallelScanner parallel_scanner(source_stream, literal_buffer_.Get(), compiler_option_,
+                                     parallel_scan? SystemInfo::GetOnlineProcessorCount(): 1);
+    token_array = parallel_scanner.Scan();
+    scanner.AttachTokenArray(token_array);
+  }
+
+  // The dependencies are scheduled before parsing.
+  // The parser still notifies the modules it finds, so a module which is missed by the DependencyScanner
+  // is scheduled by the parser, and the modules which are already scheduled are skipped by the scheduler.
+  if (compiler_option_.prescan_dependencies()) {
+    DependencyScanner dependency_scanner(module_info, token_array);
+    for (auto& module_name: dependency_scanner.Scan()) {
+      Schedule(module_name);
+    }
+  }
+
   Handle<ir::IRFactory> irfactory = Heap::NewHandle<ir::IRFactory>();
-  Parser<SourceStream::iterator> parser(compiler_option_, &scanner, notificator_, irfactory, module_info, global_scope_);
   
   try {
-    ParseResult root_result = parser.Parse();
-    if (!module_info->HasError() && root_result) {
-      AddResult(Heap::NewHandle<CompilationUnit>(root_result.value(), parser.irfactory(), module_info, literal_buffer_));
+    ParseResult root_result;
+    if (parallel_parse) {
+      ParallelParser parallel_parser(compiler_option_, notificator_, irfactory, module_info, global_scope_,
+                                     literal_buffer_.Get(), token_array, SystemInfo::GetOnlineProcessorCount());
+      root_result = parallel_parser.Parse();
+    } else {
+      Parser<SourceStream::iterator> parser(compiler_option_, &scanner, notificator_, irfactory, module_info, global_scope_);
+      root_result = parser.Parse();
+    }
+    
+    // The syntax check returns the empty tree,
+    // so the unit has only the module info that holds the errors.
+    if (!module_info->HasError() && root_result && !compiler_option_.syntax_check_only()) {
+      // The names are bound to the declarations once,
+      // so the following phases do not search the scopes.
+      ir::ScopeResolver scope_resolver;
+      scope_resolver.Resolve(root_result.value());
+      AddResult(Heap::NewHandle<CompilationUnit>(root_result.value(), irfactory, module_info, literal_buffer_));
     } else {
       AddResult(Heap::NewHandle<CompilationUnit>(module_info));
     }
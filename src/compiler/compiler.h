@@ -28,6 +28,7 @@
 #include "./compilation-unit.h"
 #include "../memory/heap.h"
 #include "../utils/spinlock.h"
+#include "../utils/maybe.h"
 #include "../utils/notificator.h"
 #include "../utils/stl.h"
 #include "./thread-pool.h"
@@ -42,6 +43,17 @@ class Compiler {
   
   Vector<Handle<CompilationUnit>> Compile(const char* filename);
 
+
+  // Return the sum of the memory usage of the compiled modules.
+  MemoryUsage GetMemoryUsage();
+
+
+  // Parse the function body of the compiled module that is skipped by the lazy_function_body option,
+  // and replace the LazyFunctionBodyView child of the function with the parsed body.
+  // The parser of the module is already destroyed, so the body is parsed by the new parser.
+  // This must not be called while the modules are compiled.
+  Maybe<ir::Node*> ParseLazyFunctionBody(Handle<CompilationUnit> compilation_unit, ir::Node* function);
+
   
  private:
 
@@ -95,6 +107,7 @@ class Compiler {
   Vector<Handle<CompilationUnit>> result_list_;
   SpinLock lock_;
   Notificator<void(const String&)> notificator_;
+  
   Handle<LiteralBuffer> literal_buffer_;
   Handle<ir::GlobalScope> global_scope_;
 };
@@ -0,0 +1,117 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2013 Taketoshi Aono(brn)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+
+#ifndef COMPILER_MEMORY_USAGE_H
+#define COMPILER_MEMORY_USAGE_H
+
+#include "../utils/utils.h"
+#include "../utils/stl.h"
+
+
+namespace yatsc {
+
+// The bytes used by the compilation unit for each category.
+// The LiteralBuffer and the GlobalScope are shared by all modules,
+// so they are not counted in any unit.
+class MemoryUsage {
+ public:
+  MemoryUsage()
+      : source_(0),
+        ir_nodes_(0),
+        child_lists_(0),
+        symbols_(0),
+        scopes_(0),
+        errors_(0),
+        ir_zone_(0) {}
+
+
+  // The bytes of the source code.
+  YATSC_CONST_PROPERTY(size_t, source, source_)
+
+  // The bytes of the views of the ir.
+  YATSC_CONST_PROPERTY(size_t, ir_nodes, ir_nodes_)
+
+  // The bytes of the children lists that are allocated in the zone.
+  YATSC_CONST_PROPERTY(size_t, child_lists, child_lists_)
+
+  // The bytes of the symbols interned in the IRFactory.
+  YATSC_CONST_PROPERTY(size_t, symbols, symbols_)
+
+  // The approximate bytes of the scopes and the declared items.
+  YATSC_CONST_PROPERTY(size_t, scopes, scopes_)
+
+  // The bytes of the errors and the warnings.
+  YATSC_CONST_PROPERTY(size_t, errors, errors_)
+
+  // The bytes of the zones of the IRFactory.
+  // The ir nodes, the children lists and the symbols are allocated in the zones,
+  // so this is not included in the total, and the rest is the unused space of the zones
+  // or the dropped nodes and the old children lists.
+  YATSC_CONST_PROPERTY(size_t, ir_zone, ir_zone_)
+
+
+  // The sum of the categories.
+  size_t total() const {
+    return source_ + ir_nodes_ + child_lists_ + symbols_ + scopes_ + errors_;
+  }
+
+
+  MemoryUsage& operator += (const MemoryUsage& memory_usage) {
+    source_ += memory_usage.source_;
+    ir_nodes_ += memory_usage.ir_nodes_;
+    child_lists_ += memory_usage.child_lists_;
+    symbols_ += memory_usage.symbols_;
+    scopes_ += memory_usage.scopes_;
+    errors_ += memory_usage.errors_;
+    ir_zone_ += memory_usage.ir_zone_;
+    return *this;
+  }
+
+
+  String ToString() const {
+    StringStream ss;
+    ss << "source: " << source_
+       << " ir_nodes: " << ir_nodes_
+       << " child_lists: " << child_lists_
+       << " symbols: " << symbols_
+       << " scopes: " << scopes_
+       << " errors: " << errors_
+       << " total: " << total()
+       << " ir_zone: " << ir_zone_;
+    return ss.str();
+  }
+
+ private:
+  size_t source_;
+  size_t ir_nodes_;
+  size_t child_lists_;
+  size_t symbols_;
+  size_t scopes_;
+  size_t errors_;
+  size_t ir_zone_;
+};
+
+}
+
+#endif
@@ -45,6 +45,15 @@ class ModuleInfo {
         typescript_(typescript) {}
 
 
+  // The module info that shares the source with the module info,
+  // but has own error reporter.
+  ModuleInfo(const ModuleInfo& module_info, Handle<ErrorReporter> error_reporter)
+      : source_stream_(module_info.source_stream_),
+        module_name_(module_info.module_name_),
+        error_reporter_(error_reporter),
+        typescript_(module_info.typescript_) {}
+
+
   YATSC_GETTER(Handle<SourceStream>, source_stream, source_stream_)
 
 
@@ -0,0 +1,243 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) Taketoshi Aono(brn)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#include <algorithm>
+#include "./ast-image.h"
+#include "./node-visitor.h"
+
+namespace yatsc { namespace ir {
+
+namespace {
+// Write the nodes to the image in the post order,
+// so the offsets of the children are known when the parent is written.
+class AstImageWriter: public NodeVisitor<AstImageWriter> {
+ public:
+  AstImageWriter() {
+    buffer_.resize(sizeof(AstImageHeader));
+  }
+
+
+  VisitResult EnterNode(Node* node) {
+    child_starts_.push_back(child_offsets_.size());
+    return VisitResult::kContinue;
+  }
+
+
+  VisitResult VisitEmpty(Node* parent) {
+    child_offsets_.push_back(0);
+    return VisitResult::kContinue;
+  }
+
+
+  void LeaveNode(Node* node) {
+    size_t start = child_starts_.back();
+    child_starts_.pop_back();
+
+    AstImageNode record;
+    memset(&record, 0, sizeof(AstImageNode));
+    record.node_type = static_cast<uint8_t>(node->node_type());
+    for (int i = 0; i < 8; i++) {
+      if (node->TestFlag(i)) {
+        record.flags |= 1 << i;
+      }
+    }
+    record.invalid_lhs = node->IsValidLhs()? 0: 1;
+    record.operand = static_cast<uint16_t>(node->operand());
+    record.index = static_cast<uint32_t>(positions_.size());
+    record.value = InternLiteral(node->string_value());
+    record.number = AstImage::kNone;
+    if (node->HasNumberView()) {
+      record.number = static_cast<uint32_t>(numbers_.size());
+      numbers_.push_back(node->double_value());
+    }
+    record.symbol = AstImage::kNone;
+    if (node->HasSymbol()) {
+      record.symbol_type = static_cast<uint8_t>(node->symbol()->type());
+      record.symbol = InternLiteral(node->symbol()->value());
+    }
+    record.child_count = static_cast<uint32_t>(child_offsets_.size() - start);
+
+    AstImagePosition position = {
+      static_cast<uint32_t>(node->source_position().start_offset()),
+      static_cast<uint32_t>(node->source_position().length())
+    };
+    positions_.push_back(position);
+
+    uint32_t offset = Append(&record, sizeof(AstImageNode));
+    if (record.child_count > 0) {
+      Append(child_offsets_.data() + start, record.child_count * sizeof(uint32_t));
+    }
+    child_offsets_.resize(start);
+    child_offsets_.push_back(offset);
+  }
+
+
+  // Append the tables after the nodes and fill the header.
+  Vector<Byte> Finish(bool has_root) {
+    AstImageHeader header;
+    memset(&header, 0, sizeof(AstImageHeader));
+    header.magic = AstImage::kMagic;
+    header.version = AstImage::kVersion;
+    header.header_size = sizeof(AstImageHeader);
+    header.root = has_root? child_offsets_.back(): 0;
+    header.node_count = static_cast<uint32_t>(positions_.size());
+    header.position_table = Append(positions_.data(), positions_.size() * sizeof(AstImagePosition));
+
+    // The strings are placed after the literal table, so the offsets are fixed here.
+    header.literal_table = static_cast<uint32_t>(buffer_.size());
+    header.literal_count = static_cast<uint32_t>(literals_.size());
+    uint32_t string_offset = header.literal_table + static_cast<uint32_t>(literals_.size() * sizeof(AstImageLiteral));
+    for (auto literal: literals_) {
+      AstImageLiteral entry = {string_offset, static_cast<uint32_t>(literal->utf8_length())};
+      Append(&entry, sizeof(AstImageLiteral));
+      string_offset += entry.length + 1;
+    }
+    for (auto literal: literals_) {
+      Append(literal->utf8_value(), literal->utf8_length());
+      buffer_.push_back('\0');
+    }
+
+    buffer_.resize(YATSC_ALIGN_OFFSET(buffer_.size(), sizeof(double)));
+    header.number_table = Append(numbers_.data(), numbers_.size() * sizeof(double));
+    header.number_count = static_cast<uint32_t>(numbers_.size());
+    header.image_size = static_cast<uint32_t>(buffer_.size());
+    memcpy(buffer_.data(), &header, sizeof(AstImageHeader));
+    return std::move(buffer_);
+  }
+
+ private:
+  // Return the offset of the appended bytes.
+  uint32_t Append(const void* data, size_t size) {
+    uint32_t offset = static_cast<uint32_t>(buffer_.size());
+    if (size > 0) {
+      const Byte* bytes = reinterpret_cast<const Byte*>(data);
+      buffer_.insert(buffer_.end(), bytes, bytes + size);
+    }
+    return offset;
+  }
+
+  
+  uint32_t InternLiteral(const Literal* literal) {
+    if (literal == nullptr) {
+      return AstImage::kNone;
+    }
+    auto found = literal_indexes_.find(literal);
+    if (found != literal_indexes_.end()) {
+      return found->second;
+    }
+    uint32_t index = static_cast<uint32_t>(literals_.size());
+    literals_.push_back(literal);
+    literal_indexes_.insert(std::make_pair(literal, index));
+    return index;
+  }
+  
+
+  Vector<Byte> buffer_;
+  Vector<uint32_t> child_offsets_;
+  Vector<size_t> child_starts_;
+  Vector<AstImagePosition> positions_;
+  Vector<const Literal*> literals_;
+  HashMap<const Literal*, uint32_t> literal_indexes_;
+  Vector<double> numbers_;
+};
+}
+
+
+Vector<Byte> AstImage::Write(Node* root) {
+  AstImageWriter writer;
+  writer.Walk(root);
+  return writer.Finish(root != nullptr);
+}
+
+
+bool AstImage::IsValid() const {
+  if (size_ < sizeof(AstImageHeader)) {
+    return false;
+  }
+  const AstImageHeader* h = header();
+  if (h->magic != kMagic || h->version != kVersion || h->header_size != sizeof(AstImageHeader)) {
+    return false;
+  }
+  if (h->image_size > size_ || h->position_table < h->header_size) {
+    return false;
+  }
+  if (h->position_table % alignof(AstImagePosition) != 0 || h->literal_table % alignof(AstImageLiteral) != 0 ||
+      h->number_table % sizeof(double) != 0) {
+    return false;
+  }
+  if (h->position_table + static_cast<size_t>(h->node_count) * sizeof(AstImagePosition) > h->literal_table) {
+    return false;
+  }
+  size_t string_table = h->literal_table + static_cast<size_t>(h->literal_count) * sizeof(AstImageLiteral);
+  if (string_table > h->number_table) {
+    return false;
+  }
+  if (h->number_table + static_cast<size_t>(h->number_count) * sizeof(double) > h->image_size) {
+    return false;
+  }
+
+  // Each string must be placed in the string area and terminated by '\0'.
+  const AstImageLiteral* literals = reinterpret_cast<const AstImageLiteral*>(data_ + h->literal_table);
+  for (uint32_t i = 0; i < h->literal_count; i++) {
+    size_t end = static_cast<size_t>(literals[i].offset) + literals[i].length;
+    if (literals[i].offset < string_table || end >= h->number_table || data_[end] != '\0') {
+      return false;
+    }
+  }
+
+  // The records are written in the post order,
+  // so every child is the record that is placed before the parent.
+  Vector<uint32_t> records;
+  size_t offset = h->header_size;
+  while (offset < h->position_table) {
+    if (offset + sizeof(AstImageNode) > h->position_table) {
+      return false;
+    }
+    const AstImageNode* node = reinterpret_cast<const AstImageNode*>(data_ + offset);
+    if (node->index >= h->node_count ||
+        (node->value != kNone && node->value >= h->literal_count) ||
+        (node->symbol != kNone && node->symbol >= h->literal_count) ||
+        (node->number != kNone && node->number >= h->number_count)) {
+      return false;
+    }
+    size_t children_offset = offset + sizeof(AstImageNode);
+    if (node->child_count > (h->position_table - children_offset) / sizeof(uint32_t)) {
+      return false;
+    }
+    const uint32_t* children = reinterpret_cast<const uint32_t*>(data_ + children_offset);
+    for (uint32_t i = 0; i < node->child_count; i++) {
+      if (children[i] != 0 && !std::binary_search(records.begin(), records.end(), children[i])) {
+        return false;
+      }
+    }
+    records.push_back(static_cast<uint32_t>(offset));
+    offset = children_offset + node->child_count * sizeof(uint32_t);
+  }
+  
+  if (records.size() != h->node_count) {
+    return false;
+  }
+  return h->root == 0 || std::binary_search(records.begin(), records.end(), h->root);
+}
+
+}} //yatsc::ir
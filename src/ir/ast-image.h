@@ -0,0 +1,246 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) Taketoshi Aono(brn)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef IR_AST_IMAGE_H
+#define IR_AST_IMAGE_H
+
+#include <string.h>
+#include <stdint.h>
+#include "../utils/utils.h"
+#include "../utils/stl.h"
+#include "../parser/sourceposition.h"
+#include "../parser/token.h"
+#include "./node.h"
+#include "./symbol.h"
+
+namespace yatsc {namespace ir {
+
+// The binary image of the ir tree.
+// The image is the single buffer that has no pointer, so the image can be written to the file,
+// mapped by the other process and read without the deserialization.
+//
+// Layout (all integers are in the native byte order):
+//   AstImageHeader
+//   AstImageNode records in the post order, each record is followed by the offsets of the children.
+//   AstImagePosition[node_count] indexed by AstImageNode::index.
+//   AstImageLiteral[literal_count].
+//   The utf-8 strings of the literals, each string is terminated by '\0'.
+//   double[number_count] aligned to 8 bytes.
+//
+// All references are the byte offsets from the beginning of the image,
+// and the offset 0 means the empty node because the header is placed there.
+struct AstImageHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t header_size;
+  uint32_t image_size;
+  uint32_t root;
+  uint32_t node_count;
+  uint32_t position_table;
+  uint32_t literal_table;
+  uint32_t literal_count;
+  uint32_t number_table;
+  uint32_t number_count;
+};
+
+
+struct AstImageNode {
+  uint8_t node_type;
+  uint8_t flags;
+  // The SymbolType of the symbol or 0 if the node has no symbol.
+  uint8_t symbol_type;
+  uint8_t invalid_lhs;
+  uint16_t operand;
+  uint16_t reserved;
+  // The index of the AstImagePosition.
+  uint32_t index;
+  // The index of the AstImageLiteral of the string value.
+  uint32_t value;
+  // The index of the AstImageLiteral of the symbol.
+  uint32_t symbol;
+  // The index of the double value of the NumberView.
+  uint32_t number;
+  uint32_t child_count;
+};
+
+
+struct AstImagePosition {
+  uint32_t start_offset;
+  uint32_t length;
+};
+
+
+struct AstImageLiteral {
+  // The offset of the utf-8 string.
+  uint32_t offset;
+  uint32_t length;
+};
+
+
+class AstImage {
+ public:
+  // 'YAST'
+  static const uint32_t kMagic = 0x54534159;
+
+  // Increment this when the layout or the meaning of the NodeType, SymbolType or TokenKind is changed.
+  static const uint16_t kVersion = 1;
+
+  // The index that means no literal or no number.
+  static const uint32_t kNone = 0xFFFFFFFF;
+  
+
+  // The node record in the image.
+  class NodeRef {
+   public:
+    NodeRef()
+        : image_(nullptr),
+          node_(nullptr) {}
+
+
+    NodeRef(const AstImage* image, const AstImageNode* node)
+        : image_(image),
+          node_(node) {}
+
+
+    YATSC_INLINE operator bool() YATSC_NO_SE {return node_ != nullptr;}
+
+
+    YATSC_INLINE NodeType node_type() YATSC_NO_SE {return static_cast<NodeType>(node_->node_type);}
+
+
+    YATSC_INLINE TokenKind operand() YATSC_NO_SE {return static_cast<TokenKind>(node_->operand);}
+
+
+    YATSC_INLINE bool TestFlag(int pos) YATSC_NO_SE {return (node_->flags & (1 << pos)) != 0;}
+
+
+    YATSC_INLINE bool IsValidLhs() YATSC_NO_SE {return node_->invalid_lhs == 0;}
+
+
+    YATSC_INLINE size_t size() YATSC_NO_SE {return node_->child_count;}
+
+
+    // Return the child at the index, the empty slot is returned as the null NodeRef.
+    YATSC_INLINE NodeRef at(size_t index) YATSC_NO_SE {
+      ASSERT(true, index < size());
+      const uint32_t* children = reinterpret_cast<const uint32_t*>(node_ + 1);
+      return image_->NodeAt(children[index]);
+    }
+
+
+    YATSC_INLINE bool has_string_value() YATSC_NO_SE {return node_->value != kNone;}
+
+
+    YATSC_INLINE const char* utf8_string_value() YATSC_NO_SE {return image_->LiteralAt(node_->value);}
+
+
+    YATSC_INLINE bool HasSymbol() YATSC_NO_SE {return node_->symbol_type != 0;}
+
+
+    YATSC_INLINE SymbolType symbol_type() YATSC_NO_SE {return static_cast<SymbolType>(node_->symbol_type);}
+
+
+    YATSC_INLINE const char* utf8_symbol_value() YATSC_NO_SE {return image_->LiteralAt(node_->symbol);}
+
+
+    YATSC_INLINE double double_value() YATSC_NO_SE {
+      ASSERT(true, node_->number != kNone);
+      return image_->NumberAt(node_->number);
+    }
+
+
+    YATSC_INLINE SourcePosition source_position() YATSC_NO_SE {
+      const AstImagePosition& position = image_->PositionAt(node_->index);
+      return SourcePosition(position.start_offset, position.start_offset + position.length);
+    }
+    
+   private:
+    const AstImage* image_;
+    const AstImageNode* node_;
+  };
+
+  
+  // Create the view of the image.
+  // The data must be aligned to 8 bytes, the memory that is returned by mmap or the Heap is enough.
+  AstImage(const Byte* data, size_t size)
+      : data_(data),
+        size_(size) {}
+
+
+  // Check the header, the tables and every node record,
+  // so the NodeRef of the valid image never reads outside of the image.
+  bool IsValid() const;
+
+
+  // Return the root node, or the null NodeRef if the image has no tree.
+  NodeRef root() const {return NodeAt(header()->root);}
+
+
+  YATSC_CONST_GETTER(size_t, node_count, header()->node_count)
+
+
+  YATSC_CONST_GETTER(size_t, literal_count, header()->literal_count)
+
+  
+  // Write the tree to the image in one pass.
+  static Vector<Byte> Write(Node* root);
+  
+ private:
+  YATSC_INLINE const AstImageHeader* header() YATSC_NO_SE {
+    return reinterpret_cast<const AstImageHeader*>(data_);
+  }
+
+
+  YATSC_INLINE NodeRef NodeAt(uint32_t offset) YATSC_NO_SE {
+    if (offset == 0) {
+      return NodeRef();
+    }
+    return NodeRef(this, reinterpret_cast<const AstImageNode*>(data_ + offset));
+  }
+
+
+  YATSC_INLINE const char* LiteralAt(uint32_t index) YATSC_NO_SE {
+    if (index == kNone) {
+      return nullptr;
+    }
+    const AstImageLiteral* literals = reinterpret_cast<const AstImageLiteral*>(data_ + header()->literal_table);
+    return reinterpret_cast<const char*>(data_ + literals[index].offset);
+  }
+
+
+  YATSC_INLINE double NumberAt(uint32_t index) YATSC_NO_SE {
+    return reinterpret_cast<const double*>(data_ + header()->number_table)[index];
+  }
+
+
+  YATSC_INLINE const AstImagePosition& PositionAt(uint32_t index) YATSC_NO_SE {
+    return reinterpret_cast<const AstImagePosition*>(data_ + header()->position_table)[index];
+  }
+  
+
+  const Byte* data_;
+  size_t size_;
+};
+
+}} //yatsc::ir
+
+#endif
@@ -25,13 +25,18 @@
 
 #include "../utils/utils.h"
 #include "../memory/heap.h"
+#include "../utils/stl.h"
+#include "./symbol.h"
+#include "./node.h"
 
 namespace yatsc {namespace ir {
 
 class IRFactory : private Uncopyable {
  public:
 
-  IRFactory() = default;
+  IRFactory()
+      : unsafe_zone_allocator_(kZoneSize) {}
+
   
   template <typename NodeName, typename ... Args>
   inline NodeName* New(Args ... args) {
@@ -40,8 +45,90 @@ class IRFactory : private Uncopyable {
     return ret;
   }
 
+
+  // Return the symbol that is interned for the pair of the type and the literal.
+  // The symbol is allocated in the zone of this factory, so it is released with the nodes
+  // and is referred by the raw pointer without the reference counting.
+  Symbol* NewSymbol(SymbolType type, const Literal* value) {
+    Unique::Id key = (value->id() << kSymbolTypeBits) | static_cast<Unique::Id>(type);
+    auto found = symbol_table_.find(key);
+    if (found != symbol_table_.end()) {
+      return found->second;
+    }
+    Symbol* symbol = unsafe_zone_allocator_.New<Symbol>(type, value);
+    symbol_table_.insert(std::make_pair(key, symbol));
+    return symbol;
+  }
+
+
+  // Return the tree that is identical to the node if it is already interned,
+  // otherwise intern the node and return it.
+  // The interned tree is shared by the multiple parents instead of the duplicated trees,
+  // so the tree must not be modified after this call
+  // and the parent_node of the tree is the first parent.
+  Node* InternSubtree(Node* node) {
+    uint64_t key = node->IdentityHash();
+    auto range = subtree_table_.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second->Identical(node)) {
+        return it->second;
+      }
+    }
+    subtree_table_.insert(std::make_pair(key, node));
+    return node;
+  }
+
+
+  // Keep the nodes created by the irfactory alive while this factory is alive.
+  // This is used to make a tree from the nodes of the multiple factories.
+  void Adopt(Handle<IRFactory> irfactory) {
+    adopted_.push_back(irfactory);
+  }
+
+
+  // The bytes of the zones of this factory and the adopted factories.
+  size_t zone_size() const {
+    size_t size = unsafe_zone_allocator_.reserved_size();
+    for (auto& irfactory: adopted_) {
+      size += irfactory->zone_size();
+    }
+    return size;
+  }
+
+
+  // The count of the symbols interned in this factory and the adopted factories.
+  size_t symbol_count() const {
+    size_t count = symbol_table_.size();
+    for (auto& irfactory: adopted_) {
+      count += irfactory->symbol_count();
+    }
+    return count;
+  }
+
+
+  // Discard all nodes created by this factory.
+  // The memory of the nodes is reused by the nodes created after this call.
+  void Reset() {
+    symbol_table_.clear();
+    subtree_table_.clear();
+    unsafe_zone_allocator_.Reset();
+  }
+
  private:
+  // The size of the zone that has the nodes and the children lists.
+  // The zone and its header fit in the largest small object of the heap,
+  // so the ir of a module is allocated in a few large zones instead of many 1 KB zones.
+  static const size_t kZoneSize = 60 KB;
+
+
+  // The number of the bits that is used for the SymbolType in the key of the symbol_table_.
+  static const int kSymbolTypeBits = 4;
+
+
   UnsafeZoneAllocator unsafe_zone_allocator_;
+  HashMap<Unique::Id, Symbol*> symbol_table_;
+  MultiHashMap<uint64_t, Node*> subtree_table_;
+  Vector<Handle<IRFactory>> adopted_;
 };
 
 }}
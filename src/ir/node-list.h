@@ -0,0 +1,196 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) Taketoshi Aono(brn)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef IR_NODE_LIST_H
+#define IR_NODE_LIST_H
+
+#include <string.h>
+#include <stdint.h>
+#include <initializer_list>
+#include "../utils/utils.h"
+#include "../memory/heap.h"
+
+namespace yatsc {namespace ir {
+
+class Node;
+
+// The children list of the ir::Node.
+// The list does not own the storage of the children.
+// The fixed arity node gives the inline array that is allocated with the node,
+// and the variable length list is allocated in the zone of the node.
+// When the list grows over the storage, the children are moved to the new zone array
+// and the old array is released with the zone.
+class NodeList {
+ public:
+  typedef Node** iterator;
+  typedef Node* const* const_iterator;
+
+
+  // Create the empty list that has no storage.
+  NodeList()
+      : data_(nullptr),
+        size_(0),
+        capacity_(0),
+        zone_storage_(0) {}
+
+
+  NodeList(const NodeList&) = delete;
+
+
+  NodeList& operator = (const NodeList&) = delete;
+
+
+  // Create the list that has the specified storage.
+  // The list is filled by the node_list and the rest of the storage is filled by nullptr.
+  NodeList(Node** storage, size_t capacity, std::initializer_list<Node*> node_list)
+      : data_(storage),
+        size_(static_cast<uint32_t>(capacity)),
+        capacity_(static_cast<uint32_t>(capacity)),
+        zone_storage_(0) {
+    ASSERT(true, node_list.size() <= capacity);
+    size_t i = 0;
+    for (auto node: node_list) {
+      data_[i++] = node;
+    }
+    for (; i < capacity; i++) {
+      data_[i] = nullptr;
+    }
+  }
+
+
+  YATSC_CONST_GETTER(size_t, size, size_)
+
+
+  YATSC_CONST_GETTER(size_t, capacity, capacity_)
+
+
+  // The bytes of the storage that is allocated in the zone.
+  // The inline array of the view is not included.
+  YATSC_INLINE size_t zone_storage_size() YATSC_NO_SE {
+    return zone_storage_? capacity_ * sizeof(Node*): 0;
+  }
+
+
+  YATSC_INLINE bool empty() YATSC_NO_SE {return size_ == 0;}
+
+
+  YATSC_INLINE Node*& operator[](size_t index) YATSC_NOEXCEPT {return data_[index];}
+
+
+  YATSC_INLINE Node* operator[](size_t index) YATSC_NO_SE {return data_[index];}
+
+
+  YATSC_INLINE Node* front() YATSC_NO_SE {return data_[0];}
+
+
+  YATSC_INLINE Node* back() YATSC_NO_SE {return data_[size_ - 1];}
+
+
+  YATSC_INLINE iterator begin() YATSC_NOEXCEPT {return data_;}
+
+
+  YATSC_INLINE iterator end() YATSC_NOEXCEPT {return data_ + size_;}
+
+
+  YATSC_INLINE const_iterator begin() YATSC_NO_SE {return data_;}
+
+
+  YATSC_INLINE const_iterator end() YATSC_NO_SE {return data_ + size_;}
+
+
+  YATSC_INLINE const_iterator cbegin() YATSC_NO_SE {return data_;}
+
+
+  YATSC_INLINE const_iterator cend() YATSC_NO_SE {return data_ + size_;}
+
+
+  // Append the node to the end of the list.
+  YATSC_INLINE void Append(Node* node, UnsafeZoneAllocator* unsafe_zone_allocator) {
+    if (size_ == capacity_) {
+      Grow(unsafe_zone_allocator);
+    }
+    data_[size_++] = node;
+  }
+
+
+  // Insert the node before the position and return the iterator of the inserted node.
+  YATSC_INLINE iterator Insert(iterator position, Node* node, UnsafeZoneAllocator* unsafe_zone_allocator) {
+    size_t index = position - data_;
+    if (size_ == capacity_) {
+      Grow(unsafe_zone_allocator);
+    }
+    memmove(data_ + index + 1, data_ + index, (size_ - index) * sizeof(Node*));
+    data_[index] = node;
+    size_++;
+    return data_ + index;
+  }
+
+
+  // Make the storage able to have the capacity children without growing.
+  // The children are moved to the new zone array if the current storage is not enough.
+  YATSC_INLINE void Reserve(size_t capacity, UnsafeZoneAllocator* unsafe_zone_allocator) {
+    if (capacity <= capacity_) {
+      return;
+    }
+    ASSERT(true, unsafe_zone_allocator != nullptr);
+    Node** data = reinterpret_cast<Node**>(unsafe_zone_allocator->NewPtr(capacity * sizeof(Node*)));
+    if (size_ > 0) {
+      memcpy(data, data_, size_ * sizeof(Node*));
+    }
+    data_ = data;
+    capacity_ = static_cast<uint32_t>(capacity);
+    zone_storage_ = 1;
+  }
+
+
+  // Remove the nodes in the range [first, last).
+  YATSC_INLINE iterator Erase(iterator first, iterator last) YATSC_NOEXCEPT {
+    memmove(first, last, (end() - last) * sizeof(Node*));
+    size_ -= static_cast<uint32_t>(last - first);
+    return first;
+  }
+
+
+  // Remove the node at the position.
+  YATSC_INLINE iterator Erase(iterator position) YATSC_NOEXCEPT {
+    return Erase(position, position + 1);
+  }
+
+ private:
+  static const uint32_t kInitialCapacity = 4;
+
+
+  // Move the children to the new zone array that has the twice capacity.
+  YATSC_INLINE void Grow(UnsafeZoneAllocator* unsafe_zone_allocator) {
+    Reserve(capacity_ == 0? kInitialCapacity: capacity_ * 2, unsafe_zone_allocator);
+  }
+
+
+  Node** data_;
+  uint32_t size_;
+  uint32_t capacity_ : 31;
+  uint32_t zone_storage_ : 1;
+};
+
+}}
+
+#endif
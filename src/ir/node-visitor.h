@@ -0,0 +1,201 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) Taketoshi Aono(brn)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef IR_NODE_VISITOR_H
+#define IR_NODE_VISITOR_H
+
+#include "../utils/utils.h"
+#include "../utils/stl.h"
+#include "./node.h"
+
+namespace yatsc {namespace ir {
+
+// The result of the pre-order hook of the NodeVisitor.
+enum class VisitResult: uint8_t {
+  // Visit the children of the node.
+  kContinue,
+  // Skip the children of the node, the post-order hook of the node is still called.
+  kSkipChildren,
+  // Stop the traversal.
+  kStop
+};
+
+
+// The depth first traversal engine of the ir tree.
+// The Derived class hides the hooks of this class to handle the nodes, like
+//
+//   VisitResult EnterBlockView(BlockView* node);
+//   void LeaveBlockView(BlockView* node);
+//
+// The hooks of the views are dispatched by the NodeType at compile time,
+// so the traversal needs no virtual call, and the hooks that are not hidden
+// fall back to EnterNode and LeaveNode.
+// The tree is walked by the explicit stack instead of the recursion,
+// so the deeply nested tree never overflows the native stack.
+template <typename Derived>
+class NodeVisitor {
+ public:
+  NodeVisitor() = default;
+
+
+  // Walk the tree from the root in the depth first order.
+  // Return false if the traversal is stopped by the hook.
+  bool Walk(Node* root) {
+    stack_.clear();
+    if (root == nullptr) {
+      return true;
+    }
+    if (!Enter(root)) {
+      return false;
+    }
+
+    while (!stack_.empty()) {
+      Frame& frame = stack_.back();
+      Node* node = frame.node;
+      if (frame.next_child < node->size()) {
+        Node* child = node->node_list()[frame.next_child++];
+        if (child == nullptr) {
+          if (derived()->VisitEmpty(node) == VisitResult::kStop) {
+            return false;
+          }
+        } else if (!Enter(child)) {
+          return false;
+        }
+      } else {
+        stack_.pop_back();
+        Leave(node);
+      }
+    }
+    return true;
+  }
+
+
+  // The pre-order hook for the node that has no specific hook.
+  YATSC_INLINE VisitResult EnterNode(Node* node) {return VisitResult::kContinue;}
+
+
+  // The post-order hook for the node that has no specific hook.
+  YATSC_INLINE void LeaveNode(Node* node) {}
+
+
+  // The hook for the empty slot of the children of the parent.
+  // Only kStop is meaningful for the empty slot.
+  YATSC_INLINE VisitResult VisitEmpty(Node* parent) {return VisitResult::kContinue;}
+
+  
+#define DECLARE_HOOK(ViewName, arity)                                   \
+  YATSC_INLINE VisitResult Enter##ViewName(ViewName* node) {            \
+    return derived()->EnterNode(reinterpret_cast<Node*>(node));         \
+  }                                                                     \
+  YATSC_INLINE void Leave##ViewName(ViewName* node) {                   \
+    derived()->LeaveNode(reinterpret_cast<Node*>(node));                \
+  }
+#define DECLARE_FIRST(ViewName, arity)
+  VIEW_LIST(DECLARE_HOOK, DECLARE_FIRST, DECLARE_HOOK)
+#undef DECLARE_HOOK
+#undef DECLARE_FIRST
+
+ protected:
+  // The number of the ancestors of the node that is passed to the current hook.
+  YATSC_INLINE size_t depth() YATSC_NO_SE {return stack_.size();}
+
+
+  // The parent of the node that is passed to the current pre-order hook or VisitEmpty.
+  YATSC_INLINE Node* parent() YATSC_NO_SE {
+    return stack_.empty()? nullptr: stack_.back().node;
+  }
+
+
+  // The index of the node that is passed to the current pre-order hook or VisitEmpty in the parent.
+  YATSC_INLINE size_t child_index() YATSC_NO_SE {
+    return stack_.empty()? 0: stack_.back().next_child - 1;
+  }
+
+ private:
+  struct Frame {
+    Node* node;
+    size_t next_child;
+  };
+
+  
+  YATSC_INLINE Derived* derived() YATSC_NOEXCEPT {return static_cast<Derived*>(this);}
+
+
+  // Call the pre-order hook of the node and push the node if the children are visited.
+  // Return false if the traversal is stopped.
+  bool Enter(Node* node) {
+    VisitResult result = Dispatch(node);
+    switch (result) {
+      case VisitResult::kContinue:
+        stack_.push_back(Frame{node, 0});
+        return true;
+      case VisitResult::kSkipChildren:
+        Leave(node);
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  
+  VisitResult Dispatch(Node* node) {
+    switch (node->node_type()) {
+#define DECLARE_CASE(ViewName, arity)                                   \
+      case NodeType::k##ViewName:                                       \
+        return derived()->Enter##ViewName(reinterpret_cast<ViewName*>(node));
+#define DECLARE_FIRST(ViewName, arity)                                  \
+      case NodeType::k##ViewName:                                       \
+        return derived()->EnterNode(node);
+      VIEW_LIST(DECLARE_CASE, DECLARE_FIRST, DECLARE_CASE)
+#undef DECLARE_CASE
+#undef DECLARE_FIRST
+      default:
+        return derived()->EnterNode(node);
+    }
+  }
+
+
+  void Leave(Node* node) {
+    switch (node->node_type()) {
+#define DECLARE_CASE(ViewName, arity)                                   \
+      case NodeType::k##ViewName:                                       \
+        derived()->Leave##ViewName(reinterpret_cast<ViewName*>(node));  \
+        return;
+#define DECLARE_FIRST(ViewName, arity)                                  \
+      case NodeType::k##ViewName:                                       \
+        derived()->LeaveNode(node);                                     \
+        return;
+      VIEW_LIST(DECLARE_CASE, DECLARE_FIRST, DECLARE_CASE)
+#undef DECLARE_CASE
+#undef DECLARE_FIRST
+      default:
+        derived()->LeaveNode(node);
+    }
+  }
+
+  
+  Vector<Frame> stack_;
+};
+
+}} //yatsc::ir
+
+#endif
@@ -23,14 +23,356 @@
 
 
 #include <float.h>
+#include <string.h>
 #include "./node.h"
+#include "./node-visitor.h"
 #include "../memory/heap.h"
 
 namespace yatsc { namespace ir {
 
+// Return the bits of the double to compare and hash the numbers exactly.
+static YATSC_INLINE uint64_t DoubleBits(double value) {
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+
+// Compare the nodes of the tree with the nodes at the same position of the other tree.
+class Node::EqualsVisitor: public NodeVisitor<Node::EqualsVisitor> {
+ public:
+  EqualsVisitor(const Node* other, bool identical = false)
+      : other_(other),
+        identical_(identical) {}
+
+
+  VisitResult EnterNode(Node* node) {
+    const Node* target = depth() == 0? other_: targets_.back()->node_list_[child_index()];
+    VisitResult result = identical_? CompareIdentical(node, target): Compare(node, target);
+    if (result != VisitResult::kStop) {
+      targets_.push_back(target);
+    }
+    return result;
+  }
+
+
+  void LeaveNode(Node* node) {
+    targets_.pop_back();
+  }
+
+
+  VisitResult VisitEmpty(Node* parent) {
+    return targets_.back()->node_list_[child_index()] == nullptr? VisitResult::kContinue: VisitResult::kStop;
+  }
+
+ private:
+  // Compare the node without the children.
+  // The children are compared only if kContinue is returned.
+  static VisitResult Compare(const Node* self, const Node* node) {
+    if (!node) {
+      return VisitResult::kStop;
+    }
+
+    if (node == self) {
+      return VisitResult::kSkipChildren;
+    }
+  
+    if (self->node_type_ != node->node_type()) {
+      return VisitResult::kStop;
+    }
+  
+    switch (node->node_type()) {
+      case NodeType::kNameView: {
+        if (((self->symbol_->utf16_length() > 0 && node->symbol()->utf16_length() > 0))
+            && !self->SymbolEquals(node)) {
+          return VisitResult::kStop;
+        }
+        return VisitResult::kSkipChildren;
+      }
+      case NodeType::kStringView: {
+        if (((self->string_value_->utf8_length() > 0 && node->string_value_->utf8_length() > 0))
+            && !self->StringEquals(node)) {
+          return VisitResult::kStop;
+        }
+        return VisitResult::kSkipChildren;
+      }
+      case NodeType::kNumberView: {
+        if (node->double_equals(self->double_value_)) {
+          return VisitResult::kSkipChildren;
+        }
+        return VisitResult::kStop;
+      }
+      default: {
+        if (node->operand() != TokenKind::kIllegal &&
+            self->operand_ != TokenKind::kIllegal &&
+            self->operand_ != node->operand_) {
+          return VisitResult::kStop;
+        }
+
+        if (node->size() != self->size()) {
+          return VisitResult::kStop;
+        }
+        return VisitResult::kContinue;
+      }
+    }
+  }
+
+
+  // Compare the node without the children strictly.
+  static VisitResult CompareIdentical(const Node* self, const Node* node) {
+    if (!node) {
+      return VisitResult::kStop;
+    }
+
+    if (node == self) {
+      return VisitResult::kSkipChildren;
+    }
+
+    if (self->node_type_ != node->node_type_ ||
+        self->operand_ != node->operand_ ||
+        self->flags_ != node->flags_ ||
+        self->invalid_lhs_ != node->invalid_lhs_ ||
+        self->symbol_ != node->symbol_ ||
+        self->string_value() != node->string_value() ||
+        self->size() != node->size()) {
+      return VisitResult::kStop;
+    }
+
+    if (self->HasNumberView() &&
+        DoubleBits(self->double_value_) != DoubleBits(node->double_value_)) {
+      return VisitResult::kStop;
+    }
+    return VisitResult::kContinue;
+  }
+
+  
+  const Node* other_;
+  bool identical_;
+  Vector<const Node*> targets_;
+};
+
+
+// Clone the nodes of the tree in the zone of the each node.
+class Node::CloneVisitor: public NodeVisitor<Node::CloneVisitor> {
+ public:
+  CloneVisitor()
+      : root_(nullptr) {}
+
+
+  VisitResult EnterNode(Node* node) {
+    Node* cloned = CloneNode(node);
+    if (clones_.empty()) {
+      root_ = cloned;
+    } else {
+      clones_.back()->InsertLast(cloned);
+    }
+    clones_.push_back(cloned);
+    return VisitResult::kContinue;
+  }
+
+
+  void LeaveNode(Node* node) {
+    // The clone has the same shape, so the cached hash is shared.
+    clones_.back()->structural_hash_ = node->structural_hash_;
+    clones_.pop_back();
+  }
+
+
+  VisitResult VisitEmpty(Node* parent) {
+    clones_.back()->node_list_.Append(Node::Null(), parent->unsafe_zone_allocator_);
+    return VisitResult::kContinue;
+  }
+  
+
+  YATSC_GETTER(Node*, root, root_)
+
+ private:
+  // Clone the node without the children.
+  static Node* CloneNode(Node* node) {
+    UnsafeZoneAllocator* unsafe_zone_allocator = node->unsafe_zone_allocator_;
+    Node* cloned;
+    if (node->HasNumberView()) {
+      cloned = unsafe_zone_allocator->template New<NumberView>(node->string_value(), node->double_value_);
+    } else if (node->HasNameView()) {
+      NameView* name_view = unsafe_zone_allocator->template New<NameView>(node->symbol_);
+      name_view->set_binding(node->ToNameView()->binding());
+      cloned = name_view;
+    } else if (node->HasLazyFunctionBodyView()) {
+      // The scope is kept, so the cloned body can be parsed too.
+      cloned = unsafe_zone_allocator->template New<LazyFunctionBodyView>(node->ToLazyFunctionBodyView()->scope(), false);
+    } else {
+      cloned = unsafe_zone_allocator->template New<Node>(node->node_type_);
+      cloned->string_value_ = node->string_value_;
+    }
+    cloned->set_unsafe_zone_allocator(unsafe_zone_allocator);
+    cloned->flags_ = node->flags_;
+    cloned->invalid_lhs_ = node->invalid_lhs_;
+    cloned->operand_ = node->operand_;
+    cloned->symbol_ = node->symbol_;
+    cloned->source_information_ = node->source_information_;
+    cloned->node_list_.Reserve(node->node_list_.size(), unsafe_zone_allocator);
+    return cloned;
+  }
+
+  
+  Node* root_;
+  Vector<Node*> clones_;
+};
+
+
+// Write the nodes of the tree to the stream with the indent of the depth.
+class Node::ToStringVisitor: public NodeVisitor<Node::ToStringVisitor> {
+ public:
+  ToStringVisitor(const Node* root, StringStream* ss)
+      : root_(root),
+        ss_(ss) {}
+
+
+  VisitResult EnterNode(Node* node) {
+    String indent(depth() * 2, ' ');
+    root_->ToStringSelf(node, indent, *ss_);
+    return VisitResult::kContinue;
+  }
+
+
+  VisitResult VisitEmpty(Node* parent) {
+    (*ss_) << String(depth() * 2, ' ') << "[Empty]" << "\n";
+    return VisitResult::kContinue;
+  }
+
+ private:
+  const Node* root_;
+  StringStream* ss_;
+};
+
+
+// Compute the structural hash of the nodes from the leaves to the root.
+// The node that has the cached hash is not walked again.
+class Node::StructuralHashVisitor: public NodeVisitor<Node::StructuralHashVisitor> {
+ public:
+  VisitResult EnterNode(Node* node) {
+    if (node->structural_hash_ != 0 || IsLeaf(node)) {
+      return VisitResult::kSkipChildren;
+    }
+    return VisitResult::kContinue;
+  }
+
+
+  void LeaveNode(Node* node) {
+    if (node->structural_hash_ != 0) {
+      return;
+    }
+    uint32_t hash = Mix(kOffsetBasis, static_cast<uint32_t>(node->node_type_));
+    if (!IsLeaf(node)) {
+      hash = Mix(hash, static_cast<uint32_t>(node->node_list_.size()));
+      for (auto child: node->node_list_) {
+        hash = Mix(hash, child? child->structural_hash_: kEmptyHash);
+      }
+    }
+    // Fold the hash to 16 bit and avoid 0 that means not computed.
+    uint16_t folded = static_cast<uint16_t>((hash >> 16) ^ hash);
+    node->structural_hash_ = folded == 0? 1: folded;
+  }
+
+ private:
+  static const uint32_t kOffsetBasis = 2166136261u;
+  static const uint32_t kPrime = 16777619u;
+  static const uint32_t kEmptyHash = 0xFFFFu;
+
+
+  // The children of the names, strings and numbers are not compared by Equals.
+  static bool IsLeaf(const Node* node) {
+    return node->HasNameView() || node->HasStringView() || node->HasNumberView();
+  }
+
+
+  static uint32_t Mix(uint32_t hash, uint32_t value) {
+    return (hash ^ value) * kPrime;
+  }
+};
+
+
+// Compute the identity hash of the tree from the leaves to the root.
+// The hash of the each node is kept in the stack until the parent is left.
+class Node::IdentityHashVisitor: public NodeVisitor<Node::IdentityHashVisitor> {
+ public:
+  IdentityHashVisitor()
+      : hash_(0) {}
+
+
+  VisitResult EnterNode(Node* node) {
+    uint64_t hash = Mix(kOffsetBasis, static_cast<uint64_t>(node->node_type_));
+    hash = Mix(hash, static_cast<uint64_t>(node->operand_));
+    hash = Mix(hash, (static_cast<uint64_t>(node->flags_) << 1) | (node->invalid_lhs_? 1: 0));
+    hash = Mix(hash, reinterpret_cast<uintptr_t>(node->symbol_));
+    hash = Mix(hash, reinterpret_cast<uintptr_t>(node->string_value()));
+    if (node->HasNumberView()) {
+      hash = Mix(hash, DoubleBits(node->double_value_));
+    }
+    hashes_.push_back(Mix(hash, static_cast<uint64_t>(node->size())));
+    return VisitResult::kContinue;
+  }
+
+
+  void LeaveNode(Node* node) {
+    uint64_t hash = hashes_.back();
+    hashes_.pop_back();
+    if (hashes_.empty()) {
+      hash_ = hash;
+    } else {
+      hashes_.back() = Mix(hashes_.back(), hash);
+    }
+  }
+
+
+  VisitResult VisitEmpty(Node* parent) {
+    hashes_.back() = Mix(hashes_.back(), kEmptyHash);
+    return VisitResult::kContinue;
+  }
+
+
+  YATSC_CONST_GETTER(uint64_t, hash, hash_)
+
+ private:
+  static const uint64_t kOffsetBasis = 14695981039346656037ull;
+  static const uint64_t kPrime = 1099511628211ull;
+  static const uint64_t kEmptyHash = ~0ull;
+
+
+  static uint64_t Mix(uint64_t hash, uint64_t value) {
+    return (hash ^ value) * kPrime;
+  }
+
+
+  uint64_t hash_;
+  Vector<uint64_t> hashes_;
+};
+
+
+// Set the source position to the descendants of the root.
+class SourcePositionVisitor: public NodeVisitor<SourcePositionVisitor> {
+ public:
+  SourcePositionVisitor(const Node* root, const SourcePosition& source_position)
+      : root_(root),
+        source_position_(source_position) {}
+
+
+  VisitResult EnterNode(Node* node) {
+    if (node != root_) {
+      node->SetInformationForNode(source_position_);
+    }
+    return VisitResult::kContinue;
+  }
+
+ private:
+  const Node* root_;
+  SourcePosition source_position_;
+};
+
+
 // Insert new node to the end of children.
 void Node::InsertLast(Node* node)  {
-  node_list_.push_back(node);
+  AppendChild(node);
   node->set_parent_node(this);
 }
 
@@ -40,7 +382,7 @@ void Node::InsertFront(Node* node) {
   if (node_list_.size() > 0 ) {
     InsertBefore(node, node_list_[0]);
   } else {
-    node_list_.push_back(node);
+    AppendChild(node);
   }
   node->set_parent_node(this);
 }
@@ -48,12 +390,13 @@ void Node::InsertFront(Node* node) {
 
 // Insert new node after old node.
 void Node::InsertAfter(Node* newNode, Node* oldNode) {
+  InvalidateStructuralHash();
   ListIterator end = node_list_.end();
   ListIterator found = std::find(node_list_.begin(), end, oldNode);
   if (found != end && found + 1 != end) {
-    node_list_.insert(found + 1, newNode);
+    node_list_.Insert(found + 1, newNode, unsafe_zone_allocator_);
   } else if (found != end) {
-    node_list_.push_back(newNode);
+    node_list_.Append(newNode, unsafe_zone_allocator_);
   }
   newNode->set_parent_node(this);
 }
@@ -61,95 +404,106 @@ void Node::InsertAfter(Node* newNode, Node* oldNode) {
 
 // Insert new node before old node.
 void Node::InsertBefore(Node* newNode, Node* oldNode) {
+  InvalidateStructuralHash();
   ListIterator found = std::find(node_list_.begin(), node_list_.end(), oldNode);
   if (found != node_list_.end()) {
-    node_list_.insert(found, newNode);
+    node_list_.Insert(found, newNode, unsafe_zone_allocator_);
   }
   newNode->set_parent_node(this);
 }
 
 
 void Node::InsertAt(size_t index, Node* node) {
+  InvalidateStructuralHash();
   node_list_[index] = node;
+  if (node) {
+    node->set_parent_node(this);
+  }
 }
 
 
 bool Node::Equals(const Node* node) YATSC_NO_SE {
-  if (!node) {
+  if (node != nullptr && node != this && node->structural_hash() != structural_hash()) {
     return false;
   }
+  EqualsVisitor visitor(node);
+  return visitor.Walk(const_cast<Node*>(this));
+}
+
 
-  if (node == this) {
-    return true;
+// Return the string value of the node.
+// NumberView keeps the literal in the view because the payload has the double value.
+const Literal* Node::string_value() YATSC_NO_SE {
+  if (HasNumberView()) {
+    return reinterpret_cast<const NumberView*>(this)->literal();
   }
-  
-  if (node_type_ != node->node_type()) {
-    return false;
+  return string_value_;
+}
+
+
+// Return the cached hash of the shape of the tree or compute it.
+uint16_t Node::structural_hash() YATSC_NO_SE {
+  if (structural_hash_ == 0) {
+    StructuralHashVisitor visitor;
+    visitor.Walk(const_cast<Node*>(this));
   }
-  
-  switch (node->node_type()) {
-    case NodeType::kNameView: {
-      if (((symbol_->utf16_length() > 0 && node->symbol()->utf16_length() > 0))
-          && !SymbolEquals(node)) {
-        return false;
-      }
-      return true;
-    }
-    case NodeType::kStringView: {
-      if (((string_value_->utf8_length() > 0 && node->string_value_->utf8_length() > 0))
-          && !StringEquals(node)) {
-        return false;
-      }
-      return true;
-    }
-    case NodeType::kNumberView: {
-      if (node->double_equals(double_value_)) {
-        return true;
-      }
-      return false;
-    }
-    default: {
-      if (node->operand() != TokenKind::kIllegal &&
-          operand_ != TokenKind::kIllegal &&
-          operand_ != node->operand_) {
-        return false;
-      }
+  return structural_hash_;
+}
 
-      if (node->size() != size()) {
-        return false;
-      }
 
-      for (size_t i = 0; i < node_list_.size(); i++) {
-        if (!node->node_list_[i] && node_list_[i]) {
-          return false;
-        }
-        if (!node_list_[i]->Equals(node->node_list_[i])) {
-          return false;
-        }
-      }
-      return true;
-    }
+// The size of the view.
+// EmptyStatement is only declared and the node of kEmptyStatement is created as the Empty.
+template <typename T>
+struct ViewSize {static const size_t value = sizeof(T);};
+template <>
+struct ViewSize<EmptyStatement> {static const size_t value = sizeof(Empty);};
+
+
+// The size of the each view.
+static const uint16_t kNodeSizeList[] = {
+#define DECLARE(ViewName, arity) ViewSize<ViewName>::value,
+#define DECLARE_LAST(ViewName, arity) ViewSize<ViewName>::value
+    VIEW_LIST(DECLARE, DECLARE, DECLARE_LAST)
+#undef DECLARE
+#undef DECLARE_LAST
+  };
+
+
+// Return the bytes of the view of this node.
+size_t Node::AllocatedSize() YATSC_NO_SE {
+  return kNodeSizeList[static_cast<uint8_t>(node_type_)];
+}
+
+
+// Compare the tree with the other tree strictly.
+bool Node::Identical(const Node* node) YATSC_NO_SE {
+  if (node != nullptr && node != this && node->structural_hash() != structural_hash()) {
+    return false;
   }
+  EqualsVisitor visitor(node, true);
+  return visitor.Walk(const_cast<Node*>(this));
+}
+
+
+// Compute the hash of the tree that includes the values of the nodes.
+uint64_t Node::IdentityHash() YATSC_NO_SE {
+  IdentityHashVisitor visitor;
+  visitor.Walk(const_cast<Node*>(this));
+  return visitor.hash();
 }
 
 
 // Clone node and node's children.
 Node* Node::Clone() YATSC_NOEXCEPT {
-  Node* cloned = this->unsafe_zone_allocator_->template New<Node>(node_type_, capacity_);
-  cloned->double_value_ = double_value_;
-  cloned->string_value_ = string_value_;
-  cloned->operand_ = operand_;
-  cloned->source_information_ = source_information_;
-  for (size_t i = 0u; i < node_list_.size(); i++) {
-    Node* node = node_list_[i];
-    if (node) {
-      Node* ret = node->Clone();
-      cloned->node_list_.push_back(ret);
-    } else {
-      cloned->node_list_.push_back(Node::Null());
-    }
-  }
-  return cloned;
+  CloneVisitor visitor;
+  visitor.Walk(this);
+  return visitor.root();
+}
+
+
+// Attach source information to this node.
+void Node::SetInformationForNode(const SourcePosition& source_position) YATSC_NOEXCEPT {
+  source_information_.source_position_ = source_position;
 }
 
 
@@ -161,13 +515,8 @@ void Node::SetInformationForNode(const Token& token_info) YATSC_NOEXCEPT {
 
 // Attach source information to this node and children.
 void Node::SetInformationForTree(const Token& token_info) YATSC_NOEXCEPT  {
-  for (size_t i = 0u; i < node_list_.size(); i++) {
-    Node* node = node_list_[i];
-    if (node) {
-      node->SetInformationForNode(token_info);
-      node->SetInformationForTree(token_info);
-    }
-  }
+  SourcePositionVisitor visitor(this, token_info.source_position());
+  visitor.Walk(this);
 }
 
 
@@ -179,13 +528,8 @@ void Node::SetInformationForNode(const Node* node) YATSC_NOEXCEPT {
 
 // Attach source information to this node and children.
 void Node::SetInformationForTree(const Node* node) YATSC_NOEXCEPT  {
-  for (size_t i = 0u; i < node_list_.size(); i++) {
-    Node* target = node_list_[i];
-    if (target) {
-      target->SetInformationForNode(node);
-      target->SetInformationForTree(node);
-    }
-  }
+  SourcePositionVisitor visitor(this, node->source_position());
+  visitor.Walk(this);
 }
 
 
@@ -204,29 +548,13 @@ String Node::DoToString() const {
 
 String Node::ToStringTree() const {
   StringStream ss;
-  String indent = "";
-  ToStringSelf(this, indent, ss);
-  indent += "  ";
-  DoToStringTree(indent, ss);
+  ToStringVisitor visitor(this, &ss);
+  visitor.Walk(const_cast<Node*>(this));
   String ret = std::move(ss.str());
   return std::move(ret.substr(0, ret.size() - 1));
 }
 
 
-void Node::DoToStringTree(String& indent, StringStream& ss) const {
-  for (size_t i = 0u; i < node_list_.size(); i++) {
-    Node* target = node_list_[i];
-    if (target) {
-      ToStringSelf(target, indent, ss);
-      String nindent = indent + "  ";
-      target->DoToStringTree(nindent, ss);
-    } else {
-      ss << indent << "[Empty]" << "\n";
-    }
-  }
-}
-
-
 void Node::ToStringSelf(const Node* target, String& indent, StringStream& ss) const {
   ss << indent << '[' << target->DoToString() << ']';
   if (target->has_string_value() && !target->HasNumberView()) {
@@ -30,12 +30,14 @@
 #include <string>
 #include <vector>
 #include <stdint.h>
+#include <type_traits>
 #include <math.h>
 #include <float.h>
 #include "../utils/utils.h"
 #include "../utils/stl.h"
 #include "../memory/heap.h"
 #include "../parser/token.h"
+#include "./node-list.h"
 #include "./scope.h"
 #include "./properties.h"
 #include "./symbol.h"
@@ -43,138 +45,143 @@
 namespace yatsc {namespace ir {
 
 // The list of the views.
+// The second column is the number of the children that is reserved for the view.
+// The fixed arity view has the children in the inline array of that size,
+// and the variable length view reserves that number of the zone slots
+// when the first child is inserted.
 #define VIEW_LIST(DECLARE, DECLARE_FIRST, DECLARE_LAST) \
-  DECLARE_FIRST(Node)                                   \
-  DECLARE(FileScopeView)                                \
-  DECLARE(StatementView)                                \
-  DECLARE(VariableDeclView)                             \
-  DECLARE(LexicalDeclView)                              \
-  DECLARE(TrueView)                                     \
-  DECLARE(FalseView)                                    \
-  DECLARE(BlockView)                                    \
-  DECLARE(ModuleDeclView)                               \
-  DECLARE(ExportView)                                   \
-  DECLARE(NamedExportListView)                          \
-  DECLARE(NamedExportView)                              \
-  DECLARE(ImportView)                                   \
-  DECLARE(ImportClauseView)                             \
-  DECLARE(NamedImportListView)                          \
-  DECLARE(NamedImportView)                              \
-  DECLARE(ExternalModuleReference)                      \
-  DECLARE(ModuleImportView)                             \
-  DECLARE(VariableView)                                 \
-  DECLARE(IfStatementView)                              \
-  DECLARE(ContinueStatementView)                        \
-  DECLARE(ReturnStatementView)                          \
-  DECLARE(BreakStatementView)                           \
-  DECLARE(WithStatementView)                            \
-  DECLARE(LabelledStatementView)                        \
-  DECLARE(SwitchStatementView)                          \
-  DECLARE(CaseView)                                     \
-  DECLARE(CaseBody)                                     \
-  DECLARE(CaseListView)                                 \
-  DECLARE(TryStatementView)                             \
-  DECLARE(CatchStatementView)                           \
-  DECLARE(FinallyStatementView)                         \
-  DECLARE(ThrowStatementView)                           \
-  DECLARE(ForStatementView)                             \
-  DECLARE(ForInStatementView)                           \
-  DECLARE(ForOfStatementView)                           \
-  DECLARE(WhileStatementView)                           \
-  DECLARE(DoWhileStatementView)                         \
-  DECLARE(EnumDeclView)                                 \
-  DECLARE(EnumBodyView)                                 \
-  DECLARE(EnumFieldView)                                \
-  DECLARE(ClassDeclView)                                \
-  DECLARE(ClassBasesView)                               \
-  DECLARE(ClassImplsView)                               \
-  DECLARE(ClassFieldListView)                           \
-  DECLARE(ClassFieldModifiersView)                      \
-  DECLARE(ClassFieldAccessLevelView)                    \
-  DECLARE(ClassHeritageView)                            \
-  DECLARE(MemberVariableView)                           \
-  DECLARE(MemberFunctionDefinitionView)                 \
-  DECLARE(MemberFunctionOverloadsView)                  \
-  DECLARE(MemberFunctionOverloadView)                   \
-  DECLARE(MemberFunctionView)                           \
-  DECLARE(InterfaceView)                                \
-  DECLARE(InterfaceExtendsView)                         \
-  DECLARE(SimpleTypeExprView)                           \
-  DECLARE(IndexSignatureView)                           \
-  DECLARE(GenericTypeExprView)                          \
-  DECLARE(TypeConstraintsView)                          \
-  DECLARE(TypeArgumentsView)                            \
-  DECLARE(TypeQueryView)                                \
-  DECLARE(ArrayTypeExprView)                            \
-  DECLARE(ObjectTypeExprView)                           \
-  DECLARE(UnionTypeExprView)                            \
-  DECLARE(PropertySignatureView)                        \
-  DECLARE(MethodSignatureView)                          \
-  DECLARE(FunctionTypeExprView)                         \
-  DECLARE(ConstructSignatureView)                       \
-  DECLARE(AccessorTypeExprView)                         \
-  DECLARE(TypeParametersView)                           \
-  DECLARE(CommaExprView)                                \
-  DECLARE(FunctionOverloadsView)                        \
-  DECLARE(FunctionOverloadView)                         \
-  DECLARE(FunctionView)                                 \
-  DECLARE(ArrowFunctionView)                            \
-  DECLARE(ParameterView)                                \
-  DECLARE(RestParamView)                                \
-  DECLARE(ParamList)                                    \
-  DECLARE(CallView)                                     \
-  DECLARE(CallSignatureView)                            \
-  DECLARE(ArgumentsView)                                \
-  DECLARE(CallArgsView)                                 \
-  DECLARE(NewCallView)                                  \
-  DECLARE(NameView)                                     \
-  DECLARE(BindingPropListView)                          \
-  DECLARE(BindingArrayView)                             \
-  DECLARE(BindingElementView)                           \
-  DECLARE(DefaultView)                                  \
-  DECLARE(YieldView)                                    \
-  DECLARE(SuperView)                                    \
-  DECLARE(PostfixView)                                  \
-  DECLARE(GetPropView)                                  \
-  DECLARE(GetElemView)                                  \
-  DECLARE(AssignmentView)                               \
-  DECLARE(TemaryExprView)                               \
-  DECLARE(CastView)                                     \
-  DECLARE(BinaryExprView)                               \
-  DECLARE(UnaryExprView)                                \
-  DECLARE(ThisView)                                     \
-  DECLARE(NumberView)                                   \
-  DECLARE(NullView)                                     \
-  DECLARE(NaNView)                                      \
-  DECLARE(StringView)                                   \
-  DECLARE(RegularExprView)                              \
-  DECLARE(ObjectElementView)                            \
-  DECLARE(ObjectLiteralView)                            \
-  DECLARE(ArrayLiteralView)                             \
-  DECLARE(UndefinedView)                                \
-  DECLARE(TemplateLiteralView)                          \
-  DECLARE(ComprehensionExprView)                        \
-  DECLARE(AmbientVariableView)                          \
-  DECLARE(AmbientFunctionDeclarationView)               \
-  DECLARE(AmbientClassDeclarationView)                  \
-  DECLARE(AmbientClassFieldsView)                       \
-  DECLARE(AmbientConstructorView)                       \
-  DECLARE(AmbientMemberFunctionView)                    \
-  DECLARE(AmbientMemberVariableView)                    \
-  DECLARE(AmbientEnumDeclarationView)                   \
-  DECLARE(AmbientEnumBodyView)                          \
-  DECLARE(AmbientEnumFieldView)                         \
-  DECLARE(AmbientModuleView)                            \
-  DECLARE(AmbientModuleBody)                            \
-  DECLARE(EmptyStatement)                               \
-  DECLARE_LAST(DebuggerView)
+  DECLARE_FIRST(Node, 0)                               \
+  DECLARE(FileScopeView, 8)                            \
+  DECLARE(StatementView, 1)                            \
+  DECLARE(VariableDeclView, 1)                         \
+  DECLARE(LexicalDeclView, 1)                          \
+  DECLARE(TrueView, 0)                                 \
+  DECLARE(FalseView, 0)                                \
+  DECLARE(BlockView, 4)                                \
+  DECLARE(LazyFunctionBodyView, 0)                     \
+  DECLARE(ModuleDeclView, 2)                           \
+  DECLARE(ExportView, 2)                               \
+  DECLARE(NamedExportListView, 2)                      \
+  DECLARE(NamedExportView, 2)                          \
+  DECLARE(ImportView, 2)                               \
+  DECLARE(ImportClauseView, 2)                         \
+  DECLARE(NamedImportListView, 2)                      \
+  DECLARE(NamedImportView, 2)                          \
+  DECLARE(ExternalModuleReference, 0)                  \
+  DECLARE(ModuleImportView, 2)                         \
+  DECLARE(VariableView, 3)                             \
+  DECLARE(IfStatementView, 3)                          \
+  DECLARE(ContinueStatementView, 1)                    \
+  DECLARE(ReturnStatementView, 1)                      \
+  DECLARE(BreakStatementView, 1)                       \
+  DECLARE(WithStatementView, 2)                        \
+  DECLARE(LabelledStatementView, 2)                    \
+  DECLARE(SwitchStatementView, 2)                      \
+  DECLARE(CaseView, 2)                                 \
+  DECLARE(CaseBody, 2)                                 \
+  DECLARE(CaseListView, 4)                             \
+  DECLARE(TryStatementView, 3)                         \
+  DECLARE(CatchStatementView, 2)                       \
+  DECLARE(FinallyStatementView, 1)                     \
+  DECLARE(ThrowStatementView, 1)                       \
+  DECLARE(ForStatementView, 4)                         \
+  DECLARE(ForInStatementView, 3)                       \
+  DECLARE(ForOfStatementView, 3)                       \
+  DECLARE(WhileStatementView, 2)                       \
+  DECLARE(DoWhileStatementView, 2)                     \
+  DECLARE(EnumDeclView, 2)                             \
+  DECLARE(EnumBodyView, 4)                             \
+  DECLARE(EnumFieldView, 2)                            \
+  DECLARE(ClassDeclView, 4)                            \
+  DECLARE(ClassBasesView, 2)                           \
+  DECLARE(ClassImplsView, 1)                           \
+  DECLARE(ClassFieldListView, 4)                       \
+  DECLARE(ClassFieldModifiersView, 2)                  \
+  DECLARE(ClassFieldAccessLevelView, 0)                \
+  DECLARE(ClassHeritageView, 1)                        \
+  DECLARE(MemberVariableView, 4)                       \
+  DECLARE(MemberFunctionDefinitionView, 5)             \
+  DECLARE(MemberFunctionOverloadsView, 2)              \
+  DECLARE(MemberFunctionOverloadView, 5)               \
+  DECLARE(MemberFunctionView, 5)                       \
+  DECLARE(InterfaceView, 4)                            \
+  DECLARE(InterfaceExtendsView, 1)                     \
+  DECLARE(SimpleTypeExprView, 1)                       \
+  DECLARE(IndexSignatureView, 2)                       \
+  DECLARE(GenericTypeExprView, 2)                      \
+  DECLARE(TypeConstraintsView, 2)                      \
+  DECLARE(TypeArgumentsView, 1)                        \
+  DECLARE(TypeQueryView, 1)                            \
+  DECLARE(ArrayTypeExprView, 1)                        \
+  DECLARE(ObjectTypeExprView, 4)                       \
+  DECLARE(UnionTypeExprView, 2)                        \
+  DECLARE(PropertySignatureView, 2)                    \
+  DECLARE(MethodSignatureView, 2)                      \
+  DECLARE(FunctionTypeExprView, 2)                     \
+  DECLARE(ConstructSignatureView, 1)                   \
+  DECLARE(AccessorTypeExprView, 2)                     \
+  DECLARE(TypeParametersView, 1)                       \
+  DECLARE(CommaExprView, 2)                            \
+  DECLARE(FunctionOverloadsView, 2)                    \
+  DECLARE(FunctionOverloadView, 2)                     \
+  DECLARE(FunctionView, 4)                             \
+  DECLARE(ArrowFunctionView, 2)                        \
+  DECLARE(ParameterView, 4)                            \
+  DECLARE(RestParamView, 1)                            \
+  DECLARE(ParamList, 2)                                \
+  DECLARE(CallView, 2)                                 \
+  DECLARE(CallSignatureView, 3)                        \
+  DECLARE(ArgumentsView, 2)                            \
+  DECLARE(CallArgsView, 2)                             \
+  DECLARE(NewCallView, 2)                              \
+  DECLARE(NameView, 0)                                 \
+  DECLARE(BindingPropListView, 2)                      \
+  DECLARE(BindingArrayView, 2)                         \
+  DECLARE(BindingElementView, 2)                       \
+  DECLARE(DefaultView, 0)                              \
+  DECLARE(YieldView, 1)                                \
+  DECLARE(SuperView, 0)                                \
+  DECLARE(PostfixView, 1)                              \
+  DECLARE(GetPropView, 2)                              \
+  DECLARE(GetElemView, 2)                              \
+  DECLARE(AssignmentView, 2)                           \
+  DECLARE(TemaryExprView, 3)                           \
+  DECLARE(CastView, 2)                                 \
+  DECLARE(BinaryExprView, 2)                           \
+  DECLARE(UnaryExprView, 1)                            \
+  DECLARE(ThisView, 0)                                 \
+  DECLARE(NumberView, 0)                               \
+  DECLARE(NullView, 0)                                 \
+  DECLARE(NaNView, 0)                                  \
+  DECLARE(StringView, 0)                               \
+  DECLARE(RegularExprView, 0)                          \
+  DECLARE(ObjectElementView, 2)                        \
+  DECLARE(ObjectLiteralView, 2)                        \
+  DECLARE(ArrayLiteralView, 2)                         \
+  DECLARE(UndefinedView, 0)                            \
+  DECLARE(TemplateLiteralView, 0)                      \
+  DECLARE(ComprehensionExprView, 2)                    \
+  DECLARE(AmbientVariableView, 2)                      \
+  DECLARE(AmbientFunctionDeclarationView, 2)           \
+  DECLARE(AmbientClassDeclarationView, 4)              \
+  DECLARE(AmbientClassFieldsView, 4)                   \
+  DECLARE(AmbientConstructorView, 2)                   \
+  DECLARE(AmbientMemberFunctionView, 3)                \
+  DECLARE(AmbientMemberVariableView, 3)                \
+  DECLARE(AmbientEnumDeclarationView, 2)               \
+  DECLARE(AmbientEnumBodyView, 4)                      \
+  DECLARE(AmbientEnumFieldView, 2)                     \
+  DECLARE(AmbientModuleView, 2)                        \
+  DECLARE(AmbientModuleBody, 4)                        \
+  DECLARE(EmptyStatement, 0)                           \
+  DECLARE_LAST(DebuggerView, 0)
 
 
 // Node types.
 enum class NodeType: uint8_t {
-#define DECLARE_ENUM(ViewName) k##ViewName,
-#define DECLARE_FIRST(ViewName) k##ViewName = 0,
-#define DECLARE_LAST(ViewName) k##ViewName
+#define DECLARE_ENUM(ViewName, arity) k##ViewName,
+#define DECLARE_FIRST(ViewName, arity) k##ViewName = 0,
+#define DECLARE_LAST(ViewName, arity) k##ViewName
   VIEW_LIST(DECLARE_ENUM, DECLARE_FIRST, DECLARE_LAST)
 #undef DECLARE_ENUM
 #undef DECLARE_FIRST
@@ -183,7 +190,7 @@ enum class NodeType: uint8_t {
 
 
 // Forward declarations.
-#define FORWARD_DECL(ViewName) class ViewName;
+#define FORWARD_DECL(ViewName, arity) class ViewName;
 VIEW_LIST(FORWARD_DECL, FORWARD_DECL, FORWARD_DECL)
 #undef FORWARD_DECL
 // End forward declarations.
@@ -191,8 +198,8 @@ VIEW_LIST(FORWARD_DECL, FORWARD_DECL, FORWARD_DECL)
 
 static const char* kNodeTypeStringList[] = {
     // Forward declarations.
-#define DECLARE(ViewName) #ViewName,
-#define DECLARE_LAST(ViewName) #ViewName
+#define DECLARE(ViewName, arity) #ViewName,
+#define DECLARE_LAST(ViewName, arity) #ViewName
     VIEW_LIST(DECLARE, DECLARE, DECLARE_LAST)
 #undef DECLARE
 #undef DECLARE_LAST
@@ -200,6 +207,16 @@ static const char* kNodeTypeStringList[] = {
   };
 
 
+// The number of the children that is reserved for each view.
+static const uint8_t kNodeArityList[] = {
+#define DECLARE(ViewName, arity) arity,
+#define DECLARE_LAST(ViewName, arity) arity
+    VIEW_LIST(DECLARE, DECLARE, DECLARE_LAST)
+#undef DECLARE
+#undef DECLARE_LAST
+  };
+
+
 // Define getter accessor.
 #define NODE_GETTER(name, pos)                                        \
   YATSC_INLINE Node* name() YATSC_NOEXCEPT {return node_list_[pos];}
@@ -208,6 +225,7 @@ static const char* kNodeTypeStringList[] = {
 // Define setter accessor.
 #define NODE_SETTER(name, pos)                            \
   YATSC_INLINE void set_##name(Node* name) {       \
+    InvalidateStructuralHash();                           \
     node_list_[pos] = name;                               \
     if (name) name->set_parent_node(this);  \
   }
@@ -241,7 +259,7 @@ static const char* kNodeTypeStringList[] = {
 
 
 // Source information holder.
-class SourceInformation: private Unmovable{
+class SourceInformation {
   friend class Node;
  public:
   // Use default constructor.
@@ -275,43 +293,34 @@ class SourceInformation: private Unmovable{
 // The IR Tree representation class.
 // This class has all tree properties and accessible from Node type.
 // All other **View classes are only view of this Node class.
-class Node : private Uncopyable, private Unmovable {
+// The node has no vtable and the destructor is never called,
+// because all nodes are allocated in the zone of the IRFactory and released with the zone.
+// Uncopyable and Unmovable are not used because they have the virtual destructor.
+class Node {
  public:
 
-  typedef Vector<Node*> List;
+  typedef NodeList List;
   typedef List::iterator ListIterator;
 
 
-  // Create Node.
-  YATSC_INLINE Node(NodeType node_type, size_t capacity = 0)
-      : node_type_(node_type),
-        capacity_(capacity),
-        operand_(TokenKind::kIllegal),
-        double_value_(0l),
+  // Create the node that has no children storage.
+  // The storage of the children is allocated in the zone when the first child is inserted.
+  YATSC_INLINE Node(NodeType node_type)
+      : parent_node_(nullptr),
+        unsafe_zone_allocator_(nullptr),
+        node_type_(node_type),
+        flags_(0),
         invalid_lhs_(false),
-        string_value_(nullptr) {
-    if (capacity != 0) {
-      node_list_.resize(capacity);
-    }
-  }
+        operand_(TokenKind::kIllegal),
+        structural_hash_(0),
+        string_value_(nullptr),
+        symbol_(nullptr) {}
 
 
-  // Create Node.
-  YATSC_INLINE Node(NodeType node_type, size_t capacity, std::initializer_list<Node*> node_list)
-      : node_list_(node_list),
-        node_type_(node_type),
-        capacity_(capacity),
-        operand_(TokenKind::kIllegal),
-        double_value_(0l),
-        invalid_lhs_(false),
-        string_value_(nullptr) {
-    if (capacity != 0) {
-      node_list_.resize(capacity);
-    }
-  }
+  Node(const Node&) = delete;
 
-  
-  virtual ~Node() {}
+
+  Node& operator = (const Node&) = delete;
 
 
   static Node* Null() {return nullptr;}
@@ -354,7 +363,7 @@ class Node : private Uncopyable, private Unmovable {
   YATSC_INLINE List::const_iterator cbegin() const {return node_list_.cbegin();}
 
 
-  YATSC_INLINE const List::const_iterator cend() const {return node_list_.cend();}
+  YATSC_INLINE List::const_iterator cend() const {return node_list_.cend();}
 
 
   YATSC_INLINE bool HasLiteralView() YATSC_NO_SE {
@@ -411,29 +420,30 @@ class Node : private Uncopyable, private Unmovable {
 
 
   // Set string value.
+  // NumberView keeps the double value in the payload, so the literal is passed to the constructor.
   YATSC_INLINE void set_string_value(const Literal* value) YATSC_NOEXCEPT {
+    ASSERT(false, HasNumberView());
     string_value_ = value;
   }
 
 
   // Return string value.
   YATSC_INLINE bool has_string_value() YATSC_NO_SE {
-    return string_value_ != nullptr;
+    return string_value() != nullptr;
   }
 
 
   // Return string value.
-  YATSC_INLINE const Literal* string_value() YATSC_NO_SE {
-    return string_value_;
-  }
+  const Literal* string_value() YATSC_NO_SE;
 
 
-  YATSC_INLINE void set_symbol(Handle<Symbol> symbol) {
+  // The symbol is interned by the IRFactory and lives in the same zone as the node.
+  YATSC_INLINE void set_symbol(Symbol* symbol) {
     symbol_ = symbol;
   }
   
 
-  YATSC_INLINE Handle<Symbol> symbol() YATSC_NO_SE {
+  YATSC_INLINE Symbol* symbol() YATSC_NO_SE {
     return symbol_;
   }
 
@@ -449,7 +459,7 @@ class Node : private Uncopyable, private Unmovable {
 
 
   YATSC_INLINE bool HasSymbol() YATSC_NO_SE {
-    return static_cast<bool>(symbol_);
+    return symbol_ != nullptr;
   }
 
 
@@ -457,7 +467,7 @@ class Node : private Uncopyable, private Unmovable {
     if (!node) {
       return false;
     }
-    return node->string_value()->Equals(string_value_);
+    return node->string_value()->Equals(string_value());
   }
 
 
@@ -471,25 +481,26 @@ class Node : private Uncopyable, private Unmovable {
 
   // Return string value.
   YATSC_INLINE const char* utf8_string_value() YATSC_NO_SE {
-    return string_value_->utf8_value();
+    return string_value()->utf8_value();
   }
 
 
   // Return string value.
   YATSC_INLINE const UC16* utf16_string_value() YATSC_NO_SE {
-    return string_value_->utf16_value();
+    return string_value()->utf16_value();
   }
 
 
   // Set double value.
   YATSC_INLINE void set_double_value(double d) YATSC_NOEXCEPT {
+    ASSERT(true, HasNumberView());
     double_value_ = d;
   }
 
 
   // Return double value.
   YATSC_INLINE double double_value() YATSC_NO_SE {
-    return double_value_;
+    return HasNumberView()? double_value_: 0;
   }
 
 
@@ -499,7 +510,7 @@ class Node : private Uncopyable, private Unmovable {
 
 
   YATSC_INLINE bool double_equals(double double_value) YATSC_NO_SE {
-    return fabs(double_value_ - double_value) >= DBL_EPSILON;
+    return fabs(this->double_value() - double_value) >= DBL_EPSILON;
   }
 
 
@@ -515,24 +526,24 @@ class Node : private Uncopyable, private Unmovable {
 
 
   YATSC_INLINE void set_flag(int pos) YATSC_NOEXCEPT {
-    flags_.set(pos);
+    flags_ |= 1 << pos;
   }
 
 
   YATSC_INLINE void set_flag(int pos, bool value) YATSC_NOEXCEPT {
     if (value) {
-      flags_.set(pos);
+      set_flag(pos);
     }
   }
 
 
   YATSC_INLINE bool TestFlag(int pos) YATSC_NO_SE {
-    return 1 == flags_.test(pos);
+    return (flags_ & (1 << pos)) != 0;
   }
 
 
   YATSC_INLINE void ClearFlag(size_t pos) YATSC_NOEXCEPT {
-    flags_.reset(pos);
+    flags_ &= ~(1 << pos);
   }
 
 
@@ -544,15 +555,18 @@ class Node : private Uncopyable, private Unmovable {
 
   // Remove specified node from children.
   YATSC_INLINE void Remove(Node* block) {
-    node_list_.erase(std::remove(node_list_.begin(), node_list_.end(), block), node_list_.end());
+    InvalidateStructuralHash();
+    node_list_.Erase(std::remove(node_list_.begin(), node_list_.end(), block), node_list_.end());
     block->set_parent_node(nullptr);
   }
 
 
   // Remove a specified iterator from children.
   YATSC_INLINE void Remove(Node::ListIterator iterator) {
-    node_list_.erase(iterator);
-    (*iterator)->set_parent_node(nullptr);
+    InvalidateStructuralHash();
+    Node* node = *iterator;
+    node_list_.Erase(iterator);
+    node->set_parent_node(nullptr);
   }
 
 
@@ -583,8 +597,40 @@ class Node : private Uncopyable, private Unmovable {
   // Set source information to this node and children.
   void SetInformationForTree(const Node* node) YATSC_NOEXCEPT;
 
+  // Compare the tree with the other tree.
+  // The trees that have the different structural_hash() are rejected
+  // without walking the children.
   bool Equals(const Node* node) YATSC_NO_SE;
 
+
+  // Return the hash of the shape of the tree.
+  // The shape is the node types, the sizes and the empty children,
+  // the names, strings, numbers and operands are not included
+  // because Equals treats the empty values and kIllegal as the wildcard.
+  // So the trees that have the different hash never be equal,
+  // but the trees that have the same hash may not be equal.
+  // The hash is computed at the first call and cached until
+  // the children of the node or the descendants are changed.
+  uint16_t structural_hash() YATSC_NO_SE;
+
+
+  // Return the bytes of the view of this node.
+  // The storage of the children in the zone is not included.
+  size_t AllocatedSize() YATSC_NO_SE;
+
+
+  // Compare the tree with the other tree strictly.
+  // Unlike Equals, the empty values and kIllegal are not the wildcard
+  // and the symbols and the strings are compared by the identity,
+  // only the source positions are not compared.
+  bool Identical(const Node* node) YATSC_NO_SE;
+
+
+  // Return the hash of the tree that includes the values of the nodes.
+  // The identical trees have the same hash.
+  // This hash is not cached because the values can be changed by the setters.
+  uint64_t IdentityHash() YATSC_NO_SE;
+
   // Clone this node and all children.
   Node* Clone() YATSC_NOEXCEPT;
 
@@ -601,7 +647,7 @@ class Node : private Uncopyable, private Unmovable {
   }
 
 
-#define DECLARE_CAST(ViewName) DEF_CAST(ViewName)
+#define DECLARE_CAST(ViewName, arity) DEF_CAST(ViewName)
   // Define cast methods like To[ViewName].
   VIEW_LIST(DECLARE_CAST, DECLARE_CAST, DECLARE_CAST)
 #undef DEF_CAST
@@ -621,54 +667,130 @@ class Node : private Uncopyable, private Unmovable {
   String ToStringTree() const;
 
  protected:
+  // Create the node that stores the children in the storage of the view.
+  // The storage is the inline array of the view that has the capacity.
+  YATSC_INLINE Node(NodeType node_type, Node** storage, size_t capacity, std::initializer_list<Node*> node_list)
+      : node_list_(storage, capacity, node_list),
+        parent_node_(nullptr),
+        unsafe_zone_allocator_(nullptr),
+        node_type_(node_type),
+        flags_(0),
+        invalid_lhs_(false),
+        operand_(TokenKind::kIllegal),
+        structural_hash_(0),
+        string_value_(nullptr),
+        symbol_(nullptr) {
+    // The parent is needed to invalidate the structural hash of the ancestors.
+    for (auto node: node_list) {
+      if (node) {
+        node->set_parent_node(this);
+      }
+    }
+  }
+
+
+  // Clear the cached structural hash of this node and the ancestors.
+  // The ancestors that have no cache have not computed the hash
+  // since the last change, so the walk is stopped at that node.
+  YATSC_INLINE void InvalidateStructuralHash() YATSC_NOEXCEPT {
+    for (Node* node = this; node != nullptr && node->structural_hash_ != 0; node = node->parent_node_) {
+      node->structural_hash_ = 0;
+    }
+  }
+
   
   List node_list_;
   
  private:
+  // Append the node to the end of the children.
+  // The variable length node has no storage until the first child is appended,
+  // so reserve the slots by the arity of the VIEW_LIST at that time.
+  YATSC_INLINE void AppendChild(Node* node) {
+    InvalidateStructuralHash();
+    if (node_list_.capacity() == 0) {
+      node_list_.Reserve(kNodeArityList[static_cast<uint8_t>(node_type_)], unsafe_zone_allocator_);
+    }
+    node_list_.Append(node, unsafe_zone_allocator_);
+  }
+
+
+  // The visitors that walk the tree for Clone, Equals, ToStringTree and structural_hash.
+  class CloneVisitor;
+  class EqualsVisitor;
+  class ToStringVisitor;
+  class StructuralHashVisitor;
+  class IdentityHashVisitor;
 
-  String DoToString() const;
-  
   
-  void DoToStringTree(String& indent, StringStream& ss) const;
+  String DoToString() const;
 
 
   void ToStringSelf(const Node* target, String& indent, StringStream& ss) const;
   
   
-  std::bitset<8> flags_;
+  Node* parent_node_;
+  UnsafeZoneAllocator* unsafe_zone_allocator_;
   SourceInformation source_information_;
   NodeType node_type_;
-  size_t capacity_;
-  Node* parent_node_;
-  TokenKind operand_;
-  double double_value_;
+  uint8_t flags_;
   bool invalid_lhs_;
-  const Literal* string_value_;
-  Handle<Symbol> symbol_;
-  UnsafeZoneAllocator* unsafe_zone_allocator_;
+  TokenKind operand_;
+  // The cache of the structural_hash(), 0 means the hash is not computed.
+  mutable uint16_t structural_hash_;
+
+  // The payload of the node that is selected by the node_type_.
+  // NumberView has the double_value_ and the other nodes have the string_value_.
+  union {
+    double double_value_;
+    const Literal* string_value_;
+  };
+  Symbol* symbol_;
 };
 
 
-
-class ScopedNode: public Node, public Scope {
+// The node that has the fixed number of the children.
+// The children are stored in the inline array that is allocated with the node,
+// so the fixed arity node needs no other allocation for the children.
+template <size_t N>
+class FixedNode: public Node {
  protected:
-  ScopedNode(NodeType type, size_t count, Handle<Scope> scope, std::initializer_list<Node*> nodes)
-      : Node(type, count, nodes),
-        scope_(scope) {}
+  FixedNode(NodeType node_type, std::initializer_list<Node*> node_list = {})
+      : Node(node_type, inline_children_, N, node_list) {}
 
 
-  ScopedNode(NodeType type, size_t count, Handle<Scope> scope)
-      : Node(type, count),
-        scope_(scope) {}
+  // Create the node that uses the first size slots of the inline array.
+  FixedNode(NodeType node_type, size_t size, std::initializer_list<Node*> node_list = {})
+      : Node(node_type, inline_children_, size, node_list) {
+    ASSERT(true, size <= N);
+  }
+
+ private:
+  Node* inline_children_[N];
+};
 
 
+// The node that has no inline children.
+template <>
+class FixedNode<0>: public Node {
+ protected:
+  FixedNode(NodeType node_type)
+      : Node(node_type) {}
+};
+
+
+
+class ScopedNode: public Node {
+ protected:
   ScopedNode(NodeType type, Handle<Scope> scope)
-      : Node(type, 0u),
+      : Node(type),
         scope_(scope) {}
 
 
  public:
   Handle<Scope> scope() {return scope_;}
+
+
+  void set_scope(Handle<Scope> scope) {scope_ = scope;}
   
 
  private:
@@ -676,20 +798,16 @@ class ScopedNode: public Node, public Scope {
 };
 
 
-class PropertyNode: public Node, public Properties {
+template <size_t N>
+class PropertyNode: public FixedNode<N> {
  protected:
-  PropertyNode(NodeType type, size_t count, std::initializer_list<Node*> nodes)
-      : Node(type, count, nodes),
-        properties_(Heap::NewHandle<Properties>()) {}
-
-
-  PropertyNode(NodeType type, size_t count)
-      : Node(type, count),
+  PropertyNode(NodeType type, std::initializer_list<Node*> nodes)
+      : FixedNode<N>(type, nodes),
         properties_(Heap::NewHandle<Properties>()) {}
 
 
   PropertyNode(NodeType type)
-      : Node(type, 0u),
+      : FixedNode<N>(type),
         properties_(Heap::NewHandle<Properties>()) {}
 
 
@@ -709,24 +827,46 @@ class BlockView: public ScopedNode {
 };
 
 
+// Represent the function body that is skipped by the preparser.
+// The source position covers the body from '{' to '}', and the scope is the scope that the body is declared in,
+// so the body is parsed into the BlockView by Parser::ParseLazyFunctionBody of any parser of the module on demand.
+// The uses_* flags are conservative, they are also set if the nested function uses them.
+class LazyFunctionBodyView: public ScopedNode {
+ public:
+  LazyFunctionBodyView(Handle<Scope> scope, bool generator)
+      : ScopedNode(NodeType::kLazyFunctionBodyView, scope) {
+    set_generator(generator);
+  }
+
+
+  NODE_FLAG_PROPERTY(generator, 0)
+
+
+  NODE_FLAG_PROPERTY(uses_yield, 1)
+
+
+  NODE_FLAG_PROPERTY(uses_super, 2)
+
+
+  NODE_FLAG_PROPERTY(uses_arguments, 3)
+};
+
+
 // Represent file root of script.
 class FileScopeView: public ScopedNode {
  public:
-  FileScopeView(Handle<Scope> scope, std::initializer_list<Node*> body): ScopedNode(NodeType::kFileScopeView, 0u, scope, body){}
-
-  
-  FileScopeView(Handle<Scope> scope): ScopedNode(NodeType::kFileScopeView, 0u, scope){}
+  FileScopeView(Handle<Scope> scope): ScopedNode(NodeType::kFileScopeView, scope){}
 };
 
 
 // Represent statement.
-class StatementView : public Node {
+class StatementView : public FixedNode<1> {
  public:
   StatementView():
-      Node(NodeType::kStatementView, 1u){}
+      FixedNode<1>(NodeType::kStatementView){}
 
   StatementView(Node* expr):
-      Node(NodeType::kStatementView, 1u, {expr}) {}
+      FixedNode<1>(NodeType::kStatementView, {expr}) {}
 
   // Getter and Setter for exp.
   NODE_PROPERTY(expr, 0)
@@ -737,11 +877,7 @@ class StatementView : public Node {
 class VariableDeclView: public Node {
  public:
   VariableDeclView():
-      Node(NodeType::kVariableDeclView, 0) {}
-
-  
-  VariableDeclView(std::initializer_list<Node*> vars):
-      Node(NodeType::kVariableDeclView, 0, vars) {}
+      Node(NodeType::kVariableDeclView) {}
 };
 
 
@@ -749,13 +885,7 @@ class VariableDeclView: public Node {
 class LexicalDeclView: public Node {
  public:
   LexicalDeclView(TokenKind op):
-      Node(NodeType::kLexicalDeclView, 0) {
-    set_operand(op);
-  }
-
-  
-  LexicalDeclView(TokenKind op, std::initializer_list<Node*> vars):
-      Node(NodeType::kLexicalDeclView, 0, vars) {
+      Node(NodeType::kLexicalDeclView) {
     set_operand(op);
   }
 };
@@ -764,26 +894,26 @@ class LexicalDeclView: public Node {
 // Represent true.
 class TrueView: public Node {
  public:
-  TrueView(): Node(NodeType::kTrueView, 0) {}
+  TrueView(): Node(NodeType::kTrueView) {}
 };
 
 
 // Represent false.
 class FalseView: public Node {
  public:
-  FalseView(): Node(NodeType::kFalseView, 0) {}
+  FalseView(): Node(NodeType::kFalseView) {}
 };
 
 
 // Represent module.
-class ModuleDeclView: public PropertyNode {
+class ModuleDeclView: public PropertyNode<2> {
  public:
   ModuleDeclView():
-      PropertyNode(NodeType::kModuleDeclView, 2u) {}
+      PropertyNode<2>(NodeType::kModuleDeclView) {}
 
 
   ModuleDeclView(Node* name, Node* body):
-      PropertyNode(NodeType::kModuleDeclView, 2u, {name, body}) {}
+      PropertyNode<2>(NodeType::kModuleDeclView, {name, body}) {}
 
   
   NODE_PROPERTY(name, 0)
@@ -793,20 +923,20 @@ class ModuleDeclView: public PropertyNode {
 
 
 // Represent export.
-class ExportView: public Node {
+class ExportView: public FixedNode<2> {
  public:
   ExportView(bool default_export, Node* export_clause, Node* from_clause)
-      : Node(NodeType::kExportView, 2u, {export_clause, from_clause}) {
+      : FixedNode<2>(NodeType::kExportView, {export_clause, from_clause}) {
     set_flag(0, default_export);
   }
 
   
   ExportView(Node* export_clause, Node* from_clause)
-      : Node(NodeType::kExportView, 2u, {export_clause, from_clause}) {}
+      : FixedNode<2>(NodeType::kExportView, {export_clause, from_clause}) {}
 
 
   ExportView()
-      : Node(NodeType::kExportView, 2u) {}
+      : FixedNode<2>(NodeType::kExportView) {}
 
   
   NODE_PROPERTY(export_clause, 0)
@@ -819,23 +949,19 @@ class ExportView: public Node {
 
 class NamedExportListView: public Node {
  public:
-  NamedExportListView(std::initializer_list<Node*> binding)
-      : Node(NodeType::kNamedExportListView, 0u, binding) {}
-
-
   NamedExportListView()
-      : Node(NodeType::kNamedExportListView, 0u) {}
+      : Node(NodeType::kNamedExportListView) {}
 };
 
 
-class NamedExportView: public Node {
+class NamedExportView: public FixedNode<2> {
  public:
   NamedExportView(Node* name, Node* binding)
-      : Node(NodeType::kNamedExportView, 2u, {name, binding}) {}
+      : FixedNode<2>(NodeType::kNamedExportView, {name, binding}) {}
 
 
   NamedExportView()
-      : Node(NodeType::kNamedExportView, 2u) {}
+      : FixedNode<2>(NodeType::kNamedExportView) {}
 
 
   NODE_PROPERTY(name, 0)
@@ -846,14 +972,14 @@ class NamedExportView: public Node {
 
 
 // Represent import.
-class ImportView: public Node {
+class ImportView: public FixedNode<2> {
  public:
   ImportView(Node* import_clause, Node* from_expr)
-      : Node(NodeType::kImportView, 2u, {import_clause, from_expr}) {}
+      : FixedNode<2>(NodeType::kImportView, {import_clause, from_expr}) {}
 
 
   ImportView()
-      : Node(NodeType::kImportView, 2u) {}
+      : FixedNode<2>(NodeType::kImportView) {}
 
   
   NODE_PROPERTY(import_clause, 0)
@@ -863,14 +989,14 @@ class ImportView: public Node {
 };
 
 
-class ModuleImportView: public Node {
+class ModuleImportView: public FixedNode<2> {
  public:
   ModuleImportView(Node* binding, Node* module_specifier)
-      : Node(NodeType::kModuleImportView, 2u, {binding, module_specifier}) {}
+      : FixedNode<2>(NodeType::kModuleImportView, {binding, module_specifier}) {}
 
 
   ModuleImportView()
-      : Node(NodeType::kModuleImportView, 2u) {}
+      : FixedNode<2>(NodeType::kModuleImportView) {}
 
 
   NODE_PROPERTY(binding, 0)
@@ -880,14 +1006,14 @@ class ModuleImportView: public Node {
 };
 
 
-class ImportClauseView: public Node {
+class ImportClauseView: public FixedNode<2> {
  public:
   ImportClauseView(Node* first, Node* second)
-      : Node(NodeType::kImportClauseView, 2u, {first, second}) {}
+      : FixedNode<2>(NodeType::kImportClauseView, {first, second}) {}
 
 
   ImportClauseView()
-      : Node(NodeType::kImportClauseView, 2u) {}
+      : FixedNode<2>(NodeType::kImportClauseView) {}
 
 
   NODE_PROPERTY(first, 0)
@@ -899,23 +1025,19 @@ class ImportClauseView: public Node {
 
 class NamedImportListView: public Node {
  public:
-  NamedImportListView(Node* binding)
-      : Node(NodeType::kNamedImportListView, 0u, {binding}) {}
-
-
   NamedImportListView()
-      : Node(NodeType::kNamedImportListView, 0u) {}
+      : Node(NodeType::kNamedImportListView) {}
 };
 
 
-class NamedImportView: public Node {
+class NamedImportView: public FixedNode<2> {
  public:
   NamedImportView(Node* name, Node* binding)
-      : Node(NodeType::kNamedImportView, 2u, {name, binding}) {}
+      : FixedNode<2>(NodeType::kNamedImportView, {name, binding}) {}
 
 
   NamedImportView()
-      : Node(NodeType::kNamedImportView, 2u) {}
+      : FixedNode<2>(NodeType::kNamedImportView) {}
 
 
   NODE_PROPERTY(name, 0)
@@ -927,26 +1049,26 @@ class NamedImportView: public Node {
 
 class ExternalModuleReference: public Node {
  public:
-  ExternalModuleReference(Handle<Symbol> symbol)
-      : Node(NodeType::kExternalModuleReference, 0u) {
+  ExternalModuleReference(Symbol* symbol)
+      : Node(NodeType::kExternalModuleReference) {
     set_symbol(symbol);
   }
 
 
   ExternalModuleReference()
-      : Node(NodeType::kExternalModuleReference, 0u) {}
+      : Node(NodeType::kExternalModuleReference) {}
 };
 
 
 // Represent variable.
-class VariableView : public Node {
+class VariableView : public FixedNode<3> {
  public:
   VariableView(Node* binding_identifier, Node* value, Node* type):
-      Node(NodeType::kVariableView, 3u, {binding_identifier, value, type}) {}
+      FixedNode<3>(NodeType::kVariableView, {binding_identifier, value, type}) {}
 
 
   VariableView():
-      Node(NodeType::kVariableView, 3u) {}
+      FixedNode<3>(NodeType::kVariableView) {}
 
 
   NODE_PROPERTY(binding_identifier, 0)
@@ -956,14 +1078,14 @@ class VariableView : public Node {
 
 
 // Represent if statement.
-class IfStatementView : public Node {
+class IfStatementView : public FixedNode<3> {
  public:
   IfStatementView(Node* expr, Node* if_block_Node, Node* else_block_node)
-      : Node(NodeType::kIfStatementView, 3u, {expr, if_block_Node, else_block_node}) {}
+      : FixedNode<3>(NodeType::kIfStatementView, {expr, if_block_Node, else_block_node}) {}
 
 
   IfStatementView()
-      : Node(NodeType::kIfStatementView, 3u) {}
+      : FixedNode<3>(NodeType::kIfStatementView) {}
 
   // Getter and setter for expr.
   NODE_PROPERTY(expr, 0)
@@ -977,14 +1099,14 @@ class IfStatementView : public Node {
 
 
 // Represent continue statement.
-class ContinueStatementView: public Node {
+class ContinueStatementView: public FixedNode<1> {
  public:
   ContinueStatementView()
-      : Node(NodeType::kContinueStatementView, 1u){}
+      : FixedNode<1>(NodeType::kContinueStatementView){}
 
 
   ContinueStatementView(Node* labelled_identifier)
-      : Node(NodeType::kContinueStatementView, 1u, {labelled_identifier}) {}
+      : FixedNode<1>(NodeType::kContinueStatementView, {labelled_identifier}) {}
 
 
   NODE_PROPERTY(label, 0)
@@ -992,14 +1114,14 @@ class ContinueStatementView: public Node {
 
 
 // Represent return statement.
-class ReturnStatementView: public Node {
+class ReturnStatementView: public FixedNode<1> {
  public:
   ReturnStatementView(Node* expr)
-      : Node(NodeType::kReturnStatementView, 1u, {expr}) {}
+      : FixedNode<1>(NodeType::kReturnStatementView, {expr}) {}
 
 
   ReturnStatementView()
-      : Node(NodeType::kReturnStatementView, 1u) {}
+      : FixedNode<1>(NodeType::kReturnStatementView) {}
   
 
   // Getter and Setter for expr_.
@@ -1008,13 +1130,13 @@ class ReturnStatementView: public Node {
 
 
 // Represent break statement.
-class BreakStatementView: public Node {
+class BreakStatementView: public FixedNode<1> {
  public:
   BreakStatementView(Node* label)
-      : Node(NodeType::kBreakStatementView, 1u, {label}) {}
+      : FixedNode<1>(NodeType::kBreakStatementView, {label}) {}
 
   BreakStatementView()
-      : Node(NodeType::kBreakStatementView, 1u) {}
+      : FixedNode<1>(NodeType::kBreakStatementView) {}
 
 
   // Getter and Setter for label.
@@ -1023,14 +1145,14 @@ class BreakStatementView: public Node {
 
 
 // Represent with statement.
-class WithStatementView: public Node {
+class WithStatementView: public FixedNode<2> {
  public:
   WithStatementView(Node* expr, Node* statement)
-      : Node(NodeType::kWithStatementView, 2u, {expr, statement}) {}
+      : FixedNode<2>(NodeType::kWithStatementView, {expr, statement}) {}
 
 
   WithStatementView()
-      : Node(NodeType::kWithStatementView, 2u) {}
+      : FixedNode<2>(NodeType::kWithStatementView) {}
 
   // Getter and Setter for expr.
   NODE_PROPERTY(expr, 0)
@@ -1042,14 +1164,14 @@ class WithStatementView: public Node {
 
 
 // Represent labell.
-class LabelledStatementView: public Node {
+class LabelledStatementView: public FixedNode<2> {
  public:
   LabelledStatementView(Node* name, Node* statement)
-      : Node(NodeType::kLabelledStatementView, 2u, {name, statement}) {}
+      : FixedNode<2>(NodeType::kLabelledStatementView, {name, statement}) {}
 
 
   LabelledStatementView()
-      : Node(NodeType::kLabelledStatementView, 2u) {}
+      : FixedNode<2>(NodeType::kLabelledStatementView) {}
 
 
   // Getter and Setter for name_.
@@ -1061,14 +1183,14 @@ class LabelledStatementView: public Node {
 
 
 // Represent switch statement.
-class SwitchStatementView: public Node {
+class SwitchStatementView: public FixedNode<2> {
  public:
   SwitchStatementView(Node* expr, Node* case_list)
-      : Node(NodeType::kSwitchStatementView, 2u, {expr, case_list}) {}
+      : FixedNode<2>(NodeType::kSwitchStatementView, {expr, case_list}) {}
 
 
   SwitchStatementView()
-      : Node(NodeType::kSwitchStatementView, 2u) {}
+      : FixedNode<2>(NodeType::kSwitchStatementView) {}
 
 
   // Getter and Setter for expr.
@@ -1082,24 +1204,20 @@ class SwitchStatementView: public Node {
 
 class CaseListView: public Node {
  public:
-  CaseListView(std::initializer_list<Node*> case_list)
-      : Node(NodeType::kCaseListView, 0, case_list) {}
-
-
   CaseListView()
-      : Node(NodeType::kCaseListView, 0) {}
+      : Node(NodeType::kCaseListView) {}
 };
 
 
 // Represent case.
-class CaseView: public Node {
+class CaseView: public FixedNode<2> {
  public:
   CaseView(Node* condition, Node* body)
-      : Node(NodeType::kCaseView, 2u, {condition, body}) {}
+      : FixedNode<2>(NodeType::kCaseView, {condition, body}) {}
 
 
   CaseView()
-      : Node(NodeType::kCaseView, 2u) {}
+      : FixedNode<2>(NodeType::kCaseView) {}
 
 
   // Getter and Setter for condition.
@@ -1114,24 +1232,20 @@ class CaseView: public Node {
 // Represent case.
 class CaseBody: public Node {
  public:
-  CaseBody(std::initializer_list<Node*> case_body)
-      : Node(NodeType::kCaseBody, 0u, case_body) {}
-
-
   CaseBody()
-      : Node(NodeType::kCaseBody, 0u) {}
+      : Node(NodeType::kCaseBody) {}
 };
 
 
 // Represent try catch finally statement.
-class TryStatementView: public Node {
+class TryStatementView: public FixedNode<3> {
  public:
   TryStatementView(Node* statement, Node* catch_statement, Node* finally_statement)
-      : Node(NodeType::kTryStatementView, 3u, {statement, catch_statement, finally_statement}) {}
+      : FixedNode<3>(NodeType::kTryStatementView, {statement, catch_statement, finally_statement}) {}
 
   
   TryStatementView()
-      : Node(NodeType::kTryStatementView, 3u) {}
+      : FixedNode<3>(NodeType::kTryStatementView) {}
 
 
   // Getter and Setter for statement.
@@ -1147,14 +1261,14 @@ class TryStatementView: public Node {
 };
 
 
-class CatchStatementView: public Node {
+class CatchStatementView: public FixedNode<2> {
  public:
   CatchStatementView(Node* error_name, Node* body)
-      : Node(NodeType::kCatchStatementView, 2u, {error_name, body}) {}
+      : FixedNode<2>(NodeType::kCatchStatementView, {error_name, body}) {}
 
 
   CatchStatementView()
-      : Node(NodeType::kCatchStatementView, 2u) {}
+      : FixedNode<2>(NodeType::kCatchStatementView) {}
 
 
   // Getter and Setter for error_name.
@@ -1167,14 +1281,14 @@ class CatchStatementView: public Node {
 
 
 // Represent finally statement.
-class FinallyStatementView: public Node {
+class FinallyStatementView: public FixedNode<1> {
  public:
   FinallyStatementView(Node* body)
-      : Node(NodeType::kFinallyStatementView, 1u, {body}) {}
+      : FixedNode<1>(NodeType::kFinallyStatementView, {body}) {}
 
 
   FinallyStatementView()
-      : Node(NodeType::kFinallyStatementView, 1u) {}
+      : FixedNode<1>(NodeType::kFinallyStatementView) {}
 
 
   NODE_PROPERTY(body, 0)
@@ -1182,10 +1296,10 @@ class FinallyStatementView: public Node {
 
 
 // Represent throw statement.
-class ThrowStatementView: public Node {
+class ThrowStatementView: public FixedNode<1> {
  public:
   ThrowStatementView(Node* expr)
-      : Node(NodeType::kThrowStatementView, 1u, {expr}) {}
+      : FixedNode<1>(NodeType::kThrowStatementView, {expr}) {}
 
   
   // Getter and Setter for expr.
@@ -1193,13 +1307,13 @@ class ThrowStatementView: public Node {
 };
 
 
-class ForStatementView: public Node {
+class ForStatementView: public FixedNode<4> {
  public:
   ForStatementView(Node* cond_init, Node* cond_cmp, Node* cond_upd, Node* body)
-      : Node(NodeType::kForStatementView, 4u, {cond_init, cond_cmp, cond_upd, body}) {}
+      : FixedNode<4>(NodeType::kForStatementView, {cond_init, cond_cmp, cond_upd, body}) {}
 
   ForStatementView()
-      : Node(NodeType::kForStatementView, 4u) {}
+      : FixedNode<4>(NodeType::kForStatementView) {}
 
 
   // Getter and Setter for cond_init.
@@ -1220,13 +1334,13 @@ class ForStatementView: public Node {
 
 
 // Represent for in statement.
-class ForInStatementView: public Node {
+class ForInStatementView: public FixedNode<3> {
  public:
   ForInStatementView(Node* property_name, Node* expr, Node* body)
-      : Node(NodeType::kForInStatementView, 3u, {property_name, expr, body}) {}
+      : FixedNode<3>(NodeType::kForInStatementView, {property_name, expr, body}) {}
 
   ForInStatementView()
-      : Node(NodeType::kForInStatementView, 3u) {}
+      : FixedNode<3>(NodeType::kForInStatementView) {}
 
 
   // Getter and Setter for cond_init.
@@ -1243,13 +1357,13 @@ class ForInStatementView: public Node {
 
 
 // Represent for in statement.
-class ForOfStatementView: public Node {
+class ForOfStatementView: public FixedNode<3> {
  public:
   ForOfStatementView(Node* property_name, Node* expr, Node* body)
-      : Node(NodeType::kForOfStatementView, 3u, {property_name, expr, body}) {}
+      : FixedNode<3>(NodeType::kForOfStatementView, {property_name, expr, body}) {}
 
   ForOfStatementView()
-      : Node(NodeType::kForOfStatementView, 3u) {}
+      : FixedNode<3>(NodeType::kForOfStatementView) {}
 
 
   // Getter and Setter for cond_init.
@@ -1266,13 +1380,13 @@ class ForOfStatementView: public Node {
 
 
 // Represent while statement
-class WhileStatementView: public Node {
+class WhileStatementView: public FixedNode<2> {
  public:
   WhileStatementView(Node* expr, Node* body)
-      : Node(NodeType::kWhileStatementView, 2u, {expr, body}) {}
+      : FixedNode<2>(NodeType::kWhileStatementView, {expr, body}) {}
 
   WhileStatementView()
-      : Node(NodeType::kWhileStatementView, 2u) {}
+      : FixedNode<2>(NodeType::kWhileStatementView) {}
 
 
   // Getter and Setter for expr.
@@ -1285,14 +1399,14 @@ class WhileStatementView: public Node {
 
 
 // Represent do while statement.
-class DoWhileStatementView: public Node {
+class DoWhileStatementView: public FixedNode<2> {
  public:
   DoWhileStatementView(Node* expr, Node* body)
-      : Node(NodeType::kDoWhileStatementView, 2u, {expr, body}) {}
+      : FixedNode<2>(NodeType::kDoWhileStatementView, {expr, body}) {}
 
 
   DoWhileStatementView()
-      : Node(NodeType::kDoWhileStatementView, 2u) {}
+      : FixedNode<2>(NodeType::kDoWhileStatementView) {}
 
 
   // Getter and Setter for expr.
@@ -1304,14 +1418,14 @@ class DoWhileStatementView: public Node {
 };
 
 
-class EnumDeclView: public Node {
+class EnumDeclView: public FixedNode<2> {
  public:
   EnumDeclView(Node* name, Node* body)
-      : Node(NodeType::kEnumDeclView, 2u, {name, body}) {}
+      : FixedNode<2>(NodeType::kEnumDeclView, {name, body}) {}
 
 
   EnumDeclView()
-      : Node(NodeType::kEnumDeclView, 2u) {}
+      : FixedNode<2>(NodeType::kEnumDeclView) {}
 
 
   NODE_PROPERTY(name, 0)
@@ -1323,22 +1437,19 @@ class EnumDeclView: public Node {
 
 class EnumBodyView: public Node {
  public:
-  EnumBodyView(std::initializer_list<Node*> fields)
-      : Node(NodeType::kEnumBodyView, 0u, fields) {}
-
   EnumBodyView()
-      : Node(NodeType::kEnumBodyView, 0u) {}
+      : Node(NodeType::kEnumBodyView) {}
 };
 
 
-class EnumFieldView: public Node {
+class EnumFieldView: public FixedNode<2> {
  public:
   EnumFieldView(Node* name, Node* value)
-      : Node(NodeType::kEnumFieldView, 2u, {name, value}) {}
+      : FixedNode<2>(NodeType::kEnumFieldView, {name, value}) {}
 
 
   EnumFieldView()
-      : Node(NodeType::kEnumFieldView, 2u) {}
+      : FixedNode<2>(NodeType::kEnumFieldView) {}
 
 
   NODE_PROPERTY(name, 0)
@@ -1348,13 +1459,13 @@ class EnumFieldView: public Node {
 };
 
 
-class ClassBasesView: public Node {
+class ClassBasesView: public FixedNode<2> {
  public:
   ClassBasesView(Node* base, Node* impls)
-      : Node(NodeType::kClassBasesView, 2u, {base, impls}) {}
+      : FixedNode<2>(NodeType::kClassBasesView, {base, impls}) {}
 
   ClassBasesView()
-      : Node(NodeType::kClassBasesView, 2u) {}
+      : FixedNode<2>(NodeType::kClassBasesView) {}
 
   
   NODE_PROPERTY(base, 0)
@@ -1366,17 +1477,17 @@ class ClassBasesView: public Node {
 class ClassImplsView: public Node {
  public:
   ClassImplsView()
-      : Node(NodeType::kClassImplsView, 0u) {}
+      : Node(NodeType::kClassImplsView) {}
 };
 
 
-class ClassDeclView: public PropertyNode {
+class ClassDeclView: public PropertyNode<4> {
  public:
   ClassDeclView(Node* name, Node* type_parameters, Node* bases, Node* field_list)
-      : PropertyNode(NodeType::kClassDeclView, 4u, {name, type_parameters, bases, field_list}) {}
+      : PropertyNode<4>(NodeType::kClassDeclView, {name, type_parameters, bases, field_list}) {}
   
   ClassDeclView()
-      : PropertyNode(NodeType::kClassDeclView, 4u) {}
+      : PropertyNode<4>(NodeType::kClassDeclView) {}
   
 
   // Getter and Setter for name.
@@ -1396,14 +1507,14 @@ class ClassDeclView: public PropertyNode {
 };
 
 
-class ClassHeritageView: public Node {
+class ClassHeritageView: public FixedNode<1> {
  public:
   ClassHeritageView(Node* ref)
-      : Node(NodeType::kClassHeritageView, 1u, {ref}) {}
+      : FixedNode<1>(NodeType::kClassHeritageView, {ref}) {}
 
 
   ClassHeritageView()
-      : Node(NodeType::kClassHeritageView, 1u) {}
+      : FixedNode<1>(NodeType::kClassHeritageView) {}
 
 
   NODE_PROPERTY(type_reference, 0)
@@ -1412,29 +1523,22 @@ class ClassHeritageView: public Node {
 
 class ClassFieldListView: public Node {
  public:
-  ClassFieldListView(std::initializer_list<Node*> fields)
-      : Node(NodeType::kClassFieldListView, 0, fields) {}
-
-
   ClassFieldListView()
-      : Node(NodeType::kClassFieldListView, 0) {}
+      : Node(NodeType::kClassFieldListView) {}
 };
 
 
 class ClassFieldModifiersView: public Node {
  public:
-  ClassFieldModifiersView(std::initializer_list<Node*> modifiers)
-      : Node(NodeType::kClassFieldModifiersView, 0, modifiers) {}
-
   ClassFieldModifiersView()
-      : Node(NodeType::kClassFieldModifiersView, 0) {}
+      : Node(NodeType::kClassFieldModifiersView) {}
 };
 
 
 class ClassFieldAccessLevelView: public Node {
  public:
   ClassFieldAccessLevelView(TokenKind op)
-      : Node(NodeType::kClassFieldAccessLevelView, 0u) {
+      : Node(NodeType::kClassFieldAccessLevelView) {
     set_operand(op);
   }
 
@@ -1444,13 +1548,13 @@ class ClassFieldAccessLevelView: public Node {
 };
 
 
-class MemberVariableView: public Node {
+class MemberVariableView: public FixedNode<4> {
  public:
   MemberVariableView(Node* accessor, Node* name, Node* type, Node* value)
-      : Node(NodeType::kMemberVariableView, 4u, {accessor, name, type, value}) {}
+      : FixedNode<4>(NodeType::kMemberVariableView, {accessor, name, type, value}) {}
 
   MemberVariableView()
-      : Node(NodeType::kMemberVariableView, 4u) {}
+      : FixedNode<4>(NodeType::kMemberVariableView) {}
 
   NODE_PROPERTY(accessor, 0)
 
@@ -1462,25 +1566,25 @@ class MemberVariableView: public Node {
 };
 
 
-class MemberFunctionDefinitionView: public Node {
+// The inline array has the slots for MemberFunctionView,
+// and MemberFunctionOverloadView uses the first three slots of it.
+class MemberFunctionDefinitionView: public FixedNode<5> {
  protected:
   MemberFunctionDefinitionView(NodeType node_type, bool getter, bool setter, bool generator, size_t size, std::initializer_list<Node*> list)
-      : Node(node_type, size, list) {
+      : FixedNode<5>(node_type, size, list) {
     set_flag(0, getter);
     set_flag(1, setter);
     set_flag(2, generator);
   }
 
   MemberFunctionDefinitionView(NodeType node_type, size_t size, std::initializer_list<Node*> list)
-      : Node(node_type, size, list) {}
+      : FixedNode<5>(node_type, size, list) {}
 
   
   MemberFunctionDefinitionView(NodeType node_type, size_t size)
-      : Node(node_type, size) {}
+      : FixedNode<5>(node_type, size) {}
 
  public:
-
-
   NODE_PROPERTY(modifiers, 0)
   
   NODE_PROPERTY(name, 1)
@@ -1497,11 +1601,8 @@ class MemberFunctionDefinitionView: public Node {
 
 class MemberFunctionOverloadsView: public Node {
  public:
-  MemberFunctionOverloadsView(std::initializer_list<Node*> overloads)
-      : Node(NodeType::kMemberFunctionOverloadsView, 0u, overloads) {}
-
   MemberFunctionOverloadsView()
-      : Node(NodeType::kMemberFunctionOverloadsView, 0u) {}
+      : Node(NodeType::kMemberFunctionOverloadsView) {}
 };
 
 
@@ -1539,13 +1640,13 @@ class MemberFunctionView: public MemberFunctionDefinitionView {
 
 
 // Represent interface.
-class InterfaceView: public Node {
+class InterfaceView: public FixedNode<4> {
  public:
   InterfaceView(Node* name, Node* type_parameters, Node* extends, Node* interface_field_list)
-      : Node(NodeType::kInterfaceView, 4u, {name, type_parameters, extends, interface_field_list}) {}
+      : FixedNode<4>(NodeType::kInterfaceView, {name, type_parameters, extends, interface_field_list}) {}
 
   InterfaceView()
-      : Node(NodeType::kInterfaceView, 4u) {}
+      : FixedNode<4>(NodeType::kInterfaceView) {}
 
   
   // Getter and Setter for name.
@@ -1567,21 +1668,17 @@ class InterfaceView: public Node {
 
 class InterfaceExtendsView: public Node {
  public:
-  InterfaceExtendsView(std::initializer_list<Node*> extends)
-      : Node(NodeType::kInterfaceExtendsView, 0u, extends) {}
-
-
   InterfaceExtendsView()
-      : Node(NodeType::kInterfaceExtendsView, 0u) {}
+      : Node(NodeType::kInterfaceExtendsView) {}
 };
 
 
 // Represent type expression like `var x: string`
-class SimpleTypeExprView: public Node {
+class SimpleTypeExprView: public FixedNode<1> {
  public:
   
   SimpleTypeExprView(Node* type_name)
-      : Node(NodeType::kSimpleTypeExprView, 1u, {type_name}) {}
+      : FixedNode<1>(NodeType::kSimpleTypeExprView, {type_name}) {}
   
 
   // Getter and Setter for type_name_.
@@ -1589,16 +1686,16 @@ class SimpleTypeExprView: public Node {
 };
 
 
-class IndexSignatureView: public Node {
+class IndexSignatureView: public FixedNode<2> {
  public:
   IndexSignatureView(Node* identifier, Node* type, bool string_type)
-      : Node(NodeType::kIndexSignatureView, 2u, {identifier, type}) {
+      : FixedNode<2>(NodeType::kIndexSignatureView, {identifier, type}) {
     set_flag(0, string_type);
   }
 
 
   IndexSignatureView()
-      : Node(NodeType::kIndexSignatureView, 2u) {}
+      : FixedNode<2>(NodeType::kIndexSignatureView) {}
 
 
   NODE_PROPERTY(identifier, 0)
@@ -1609,11 +1706,11 @@ class IndexSignatureView: public Node {
 
 
 // Represent type expression like `var x: string`
-class GenericTypeExprView: public Node {
+class GenericTypeExprView: public FixedNode<2> {
  public:
   
   GenericTypeExprView(Node* type_name, Node* type_arguments)
-      : Node(NodeType::kGenericTypeExprView, 2u, {type_name, type_arguments}) {}
+      : FixedNode<2>(NodeType::kGenericTypeExprView, {type_name, type_arguments}) {}
   
 
   // Getter and Setter for type_name_.
@@ -1626,11 +1723,11 @@ class GenericTypeExprView: public Node {
 
 
 // Represent type expression like `var x: string`
-class TypeConstraintsView: public Node {
+class TypeConstraintsView: public FixedNode<2> {
  public:
   
   TypeConstraintsView(Node* derived, Node* base)
-      : Node(NodeType::kTypeConstraintsView, 2u, {derived, base}) {}
+      : FixedNode<2>(NodeType::kTypeConstraintsView, {derived, base}) {}
   
 
   // Getter and Setter for type_name_.
@@ -1645,28 +1742,28 @@ class TypeArgumentsView: public Node {
  public:
   
   TypeArgumentsView()
-      : Node(NodeType::kTypeArgumentsView, 0u) {}
+      : Node(NodeType::kTypeArgumentsView) {}
 };
 
 
-class TypeQueryView: public Node {
+class TypeQueryView: public FixedNode<1> {
  public:
   
   TypeQueryView(Node* var_name)
-      : Node(NodeType::kTypeQueryView, 1u, {var_name}) {}
+      : FixedNode<1>(NodeType::kTypeQueryView, {var_name}) {}
 
 
   TypeQueryView()
-      : Node(NodeType::kTypeQueryView, 1u) {}
+      : FixedNode<1>(NodeType::kTypeQueryView) {}
 };
 
 
 // Represent type expression like `var x: string`
-class ArrayTypeExprView: public Node {
+class ArrayTypeExprView: public FixedNode<1> {
  public:
   
   ArrayTypeExprView(Node* type_name)
-      : Node(NodeType::kArrayTypeExprView, 1u, {type_name}) {}
+      : FixedNode<1>(NodeType::kArrayTypeExprView, {type_name}) {}
   
 
   // Getter and Setter for type_name_.
@@ -1677,30 +1774,22 @@ class ArrayTypeExprView: public Node {
 // Represent type expression like `var x: string`
 class ObjectTypeExprView: public Node {
  public:
-  
-  ObjectTypeExprView(std::initializer_list<Node*> type_member_list)
-      : Node(NodeType::kObjectTypeExprView, 0u, type_member_list) {}
-  
-
   ObjectTypeExprView()
-      : Node(NodeType::kObjectTypeExprView, 0u) {}
+      : Node(NodeType::kObjectTypeExprView) {}
 };
 
 
 class UnionTypeExprView: public Node {
  public:
-  UnionTypeExprView(std::initializer_list<Node*> union_member_list)
-      : Node(NodeType::kUnionTypeExprView, 0u, union_member_list) {}
-
   UnionTypeExprView()
-      : Node(NodeType::kUnionTypeExprView, 0u) {}
+      : Node(NodeType::kUnionTypeExprView) {}
 };
 
 
-class PropertySignatureView: public Node {
+class PropertySignatureView: public FixedNode<2> {
  public:
   PropertySignatureView(bool opt, Node* property_name, Node* type_expr)
-      : Node(NodeType::kPropertySignatureView, 2u, {property_name, type_expr}) {
+      : FixedNode<2>(NodeType::kPropertySignatureView, {property_name, type_expr}) {
     if (opt) {
       set_flag(0);
     }
@@ -1708,7 +1797,7 @@ class PropertySignatureView: public Node {
 
 
   PropertySignatureView()
-      : Node(NodeType::kPropertySignatureView, 2u) {}
+      : FixedNode<2>(NodeType::kPropertySignatureView) {}
   
 
   NODE_PROPERTY(property_name, 0)
@@ -1721,10 +1810,10 @@ class PropertySignatureView: public Node {
 };
 
 
-class MethodSignatureView: public Node {
+class MethodSignatureView: public FixedNode<2> {
  public:
   MethodSignatureView(bool opt, bool getter, bool setter, bool generator, Node* property_name, Node* type_expr)
-      : Node(NodeType::kMethodSignatureView, 2u, {property_name, type_expr}) {
+      : FixedNode<2>(NodeType::kMethodSignatureView, {property_name, type_expr}) {
     set_flag(0, opt);
     set_flag(1, getter);
     set_flag(2, setter);
@@ -1733,7 +1822,7 @@ class MethodSignatureView: public Node {
 
 
   MethodSignatureView()
-      : Node(NodeType::kMethodSignatureView, 2u) {}
+      : FixedNode<2>(NodeType::kMethodSignatureView) {}
   
 
   NODE_PROPERTY(property_name, 0)
@@ -1747,14 +1836,14 @@ class MethodSignatureView: public Node {
 
 
 // Represent function type expression like, `var x:(a:string, b:string) => string;`
-class FunctionTypeExprView: public Node {
+class FunctionTypeExprView: public FixedNode<2> {
  public:
   FunctionTypeExprView(Node* param_list, Node* return_type, Node* type_parameters)
-      : Node(NodeType::kFunctionTypeExprView, 2u, {param_list, return_type}) {}
+      : FixedNode<2>(NodeType::kFunctionTypeExprView, {param_list, return_type}) {}
 
 
   FunctionTypeExprView()
-      : Node(NodeType::kFunctionTypeExprView, 2u) {}
+      : FixedNode<2>(NodeType::kFunctionTypeExprView) {}
 
 
   // Getter and setter for param_list_.
@@ -1770,14 +1859,14 @@ class FunctionTypeExprView: public Node {
 
 
 // Represent function type expression like, `var x:(a:string, b:string) => string;`
-class ConstructSignatureView: public Node {
+class ConstructSignatureView: public FixedNode<1> {
  public:
   ConstructSignatureView(Node* call_signature)
-      : Node(NodeType::kConstructSignatureView, 1u, {call_signature}) {}
+      : FixedNode<1>(NodeType::kConstructSignatureView, {call_signature}) {}
 
 
   ConstructSignatureView()
-      : Node(NodeType::kConstructSignatureView, 1u) {}
+      : FixedNode<1>(NodeType::kConstructSignatureView) {}
 
 
   // Getter and setter for type_parameters.
@@ -1786,14 +1875,14 @@ class ConstructSignatureView: public Node {
 
 
 // Represent accessor type expression like, `interface x {[index:int]}`
-class AccessorTypeExprView: public Node {
+class AccessorTypeExprView: public FixedNode<2> {
  public:
   AccessorTypeExprView(Node* name, Node* type_expression):
-      Node(NodeType::kAccessorTypeExprView, 2u, {name, type_expression}) {}
+      FixedNode<2>(NodeType::kAccessorTypeExprView, {name, type_expression}) {}
 
 
   AccessorTypeExprView():
-      Node(NodeType::kAccessorTypeExprView, 2u) {}
+      FixedNode<2>(NodeType::kAccessorTypeExprView) {}
 
   
   // Getter and setter for name_.
@@ -1807,36 +1896,29 @@ class AccessorTypeExprView: public Node {
 
 class TypeParametersView: public Node {
  public:
-  TypeParametersView(std::initializer_list<Node*> type_arguments)
-      : Node(NodeType::kTypeParametersView, 0u, type_arguments) {}
-
-
   TypeParametersView()
-      : Node(NodeType::kTypeParametersView, 0u) {}
+      : Node(NodeType::kTypeParametersView) {}
 };
 
 
 class CommaExprView: public Node {
  public:
-  CommaExprView(std::initializer_list<Node*> exprs)
-      : Node(NodeType::kCommaExprView, 0u, exprs) {}
-
   CommaExprView()
-      : Node(NodeType::kCommaExprView, 0u) {}
+      : Node(NodeType::kCommaExprView) {}
 };
 
 
-class FunctionOverloadView: public Node {
+class FunctionOverloadView: public FixedNode<2> {
  public:
   FunctionOverloadView(bool generator, Node* name, Node* call_signature)
-      : Node(NodeType::kFunctionOverloadView, 2u, {name, call_signature}) {
+      : FixedNode<2>(NodeType::kFunctionOverloadView, {name, call_signature}) {
     if (generator) {
       set_flag(0);
     }
   }
 
   FunctionOverloadView()
-      : Node(NodeType::kFunctionOverloadView, 2u) {}
+      : FixedNode<2>(NodeType::kFunctionOverloadView) {}
 
   NODE_PROPERTY(name, 0)
 
@@ -1848,19 +1930,16 @@ class FunctionOverloadView: public Node {
 
 class FunctionOverloadsView: public Node {
  public:
-  FunctionOverloadsView(std::initializer_list<Node*> overloads)
-      : Node(NodeType::kFunctionOverloadsView, 0u, overloads) {}
-
   FunctionOverloadsView()
-      : Node(NodeType::kFunctionOverloadsView, 0u) {}
+      : Node(NodeType::kFunctionOverloadsView) {}
 };
 
 
 // Represent function.
-class FunctionView: public Node {
+class FunctionView: public FixedNode<4> {
  public:
   FunctionView(bool getter, bool setter, bool generator, Node* overloads, Node* name, Node* call_signature, Node* body)
-      : Node(NodeType::kFunctionView, 4u, {overloads, name, call_signature, body}) {
+      : FixedNode<4>(NodeType::kFunctionView, {overloads, name, call_signature, body}) {
     if (getter) {
       set_flag(0);
     } else if (setter) {
@@ -1871,11 +1950,11 @@ class FunctionView: public Node {
   }
 
   FunctionView(Node* overloads, Node* name, Node* call_signature, Node* body)
-      : Node(NodeType::kFunctionView, 4u, {overloads, name, call_signature, body}) {}
+      : FixedNode<4>(NodeType::kFunctionView, {overloads, name, call_signature, body}) {}
 
   
   FunctionView()
-      : Node(NodeType::kFunctionView, 4u) {}
+      : FixedNode<4>(NodeType::kFunctionView) {}
 
   NODE_PROPERTY(overloads, 0)
   
@@ -1897,10 +1976,10 @@ class FunctionView: public Node {
 
 
 // Represent function.
-class ArrowFunctionView: public Node {
+class ArrowFunctionView: public FixedNode<2> {
  public:
   ArrowFunctionView(Node* call_signature, Node* body)
-      : Node(NodeType::kArrowFunctionView, 2u, {call_signature, body}) {}
+      : FixedNode<2>(NodeType::kArrowFunctionView, {call_signature, body}) {}
 
   // Getter for param_list_.
   NODE_GETTER(call_signature, 0)
@@ -1910,10 +1989,10 @@ class ArrowFunctionView: public Node {
 };
 
 
-class ParameterView: public Node {
+class ParameterView: public FixedNode<4> {
  public:
   ParameterView(bool optional, Node* name, Node* value, Node* type_expr, Node* access_level)
-      : Node(NodeType::kParameterView, 4u, {name, value, type_expr, access_level}){
+      : FixedNode<4>(NodeType::kParameterView, {name, value, type_expr, access_level}){
     if (optional) {
       set_flag(0);
     }
@@ -1921,7 +2000,7 @@ class ParameterView: public Node {
 
 
   ParameterView()
-      : Node(NodeType::kParameterView, 4u){}
+      : FixedNode<4>(NodeType::kParameterView){}
 
 
   NODE_PROPERTY(name, 0)
@@ -1936,14 +2015,14 @@ class ParameterView: public Node {
 };
 
 
-class RestParamView: public Node {
+class RestParamView: public FixedNode<1> {
  public:
   RestParamView(Node* parameter)
-      : Node(NodeType::kRestParamView, 1u, {parameter}){}
+      : FixedNode<1>(NodeType::kRestParamView, {parameter}){}
 
   
   RestParamView()
-      : Node(NodeType::kRestParamView, 1u){}
+      : FixedNode<1>(NodeType::kRestParamView){}
 
 
   NODE_PROPERTY(parameter, 0)
@@ -1952,19 +2031,15 @@ class RestParamView: public Node {
 
 class ParamList: public Node {
  public:
-  ParamList(std::initializer_list<Node*> args)
-      : Node(NodeType::kParamList, 0u, args) {}
-
-
   ParamList()
-      : Node(NodeType::kParamList, 0u) {}
+      : Node(NodeType::kParamList) {}
 };
 
 
-class CallView: public Node {
+class CallView: public FixedNode<2> {
  public:
   CallView(Node* target, Node* arguments)
-      : Node(NodeType::kCallView, 2u, {target, arguments}) {}
+      : FixedNode<2>(NodeType::kCallView, {target, arguments}) {}
 
   
   NODE_PROPERTY(target, 0)
@@ -1974,10 +2049,10 @@ class CallView: public Node {
 };
 
 
-class CallSignatureView: public Node {
+class CallSignatureView: public FixedNode<3> {
  public:
   CallSignatureView(Node* param_list, Node* return_type, Node* type_parameters)
-      : Node(NodeType::kCallSignatureView, 3u, {param_list, return_type, type_parameters}) {}
+      : FixedNode<3>(NodeType::kCallSignatureView, {param_list, return_type, type_parameters}) {}
 
   
   NODE_PROPERTY(param_list, 0)
@@ -1990,14 +2065,14 @@ class CallSignatureView: public Node {
 };
 
 
-class ArgumentsView: public Node {
+class ArgumentsView: public FixedNode<2> {
  public:
   ArgumentsView(Node* type_parameters, Node* call_args)
-      : Node(NodeType::kArgumentsView, 2u, {type_parameters, call_args}) {}
+      : FixedNode<2>(NodeType::kArgumentsView, {type_parameters, call_args}) {}
 
 
   ArgumentsView(Node* call_args)
-      : Node(NodeType::kArgumentsView, 2u, {Node::Null(), call_args}) {}
+      : FixedNode<2>(NodeType::kArgumentsView, {Node::Null(), call_args}) {}
 
 
   NODE_PROPERTY(type_parameters, 0)
@@ -2009,23 +2084,19 @@ class ArgumentsView: public Node {
 
 class CallArgsView: public Node {
  public:
-  CallArgsView(std::initializer_list<Node*> args)
-      : Node(NodeType::kCallArgsView, 0, args) {}
-
-
   CallArgsView()
-      : Node(NodeType::kCallArgsView, 0) {}
+      : Node(NodeType::kCallArgsView) {}
 };
 
 
-class NewCallView: public Node {
+class NewCallView: public FixedNode<2> {
  public:
   NewCallView(Node* target, Node* args)
-      : Node(NodeType::kNewCallView, 2u, {target, args}) {}
+      : FixedNode<2>(NodeType::kNewCallView, {target, args}) {}
 
 
   NewCallView()
-      : Node(NodeType::kNewCallView, 2u) {}
+      : FixedNode<2>(NodeType::kNewCallView) {}
 
 
   NODE_PROPERTY(target, 0)
@@ -2037,34 +2108,41 @@ class NewCallView: public Node {
 
 class NameView: public Node {
  public:
-  NameView(Handle<Symbol> name)
-      : Node(NodeType::kNameView, 0u) {
+  NameView(Symbol* name)
+      : Node(NodeType::kNameView) {
     set_symbol(name);
   }
+
+
+  // The item that the name refers, that is set by the ScopeResolver.
+  YATSC_CONST_PROPERTY(const Binding&, binding, binding_)
+
+ private:
+  Binding binding_;
 };
 
 
 class BindingPropListView: public Node {
  public:
   BindingPropListView()
-      : Node(NodeType::kBindingPropListView, 0u) {}
+      : Node(NodeType::kBindingPropListView) {}
 };
 
 
 class BindingArrayView: public Node {
  public:
   BindingArrayView()
-      : Node(NodeType::kBindingArrayView, 0u) {}
+      : Node(NodeType::kBindingArrayView) {}
 };
 
 
-class BindingElementView: public Node {
+class BindingElementView: public FixedNode<2> {
  public:
   BindingElementView(Node* prop, Node* value)
-      : Node(NodeType::kBindingElementView, 2u, {prop, value}) {}
+      : FixedNode<2>(NodeType::kBindingElementView, {prop, value}) {}
 
   BindingElementView()
-      : Node(NodeType::kBindingElementView, 2u) {}
+      : FixedNode<2>(NodeType::kBindingElementView) {}
 
   
   NODE_PROPERTY(prop, 0)
@@ -2075,21 +2153,21 @@ class BindingElementView: public Node {
 class DefaultView: public Node {
  public:
   DefaultView()
-      : Node(NodeType::kDefaultView, 0u) {}
+      : Node(NodeType::kDefaultView) {}
 };
 
 
-class YieldView: public Node {
+class YieldView: public FixedNode<1> {
  public:
   YieldView(bool continuation, Node* expr)
-      : Node(NodeType::kYieldView, 1u, {expr}) {
+      : FixedNode<1>(NodeType::kYieldView, {expr}) {
     if (continuation) {
       set_flag(0);
     }
   }
 
   YieldView()
-      : Node(NodeType::kYieldView, 1u) {}
+      : FixedNode<1>(NodeType::kYieldView) {}
 
   NODE_PROPERTY(expr, 0)
 
@@ -2100,30 +2178,30 @@ class YieldView: public Node {
 class SuperView: public Node {
  public:
   SuperView()
-      : Node(NodeType::kSuperView, 0u) {}
+      : Node(NodeType::kSuperView) {}
 };
 
 
-class PostfixView: public Node {
+class PostfixView: public FixedNode<1> {
  public:
   PostfixView(Node* target, TokenKind op)
-      : Node(NodeType::kPostfixView, 1u, {target}) {
+      : FixedNode<1>(NodeType::kPostfixView, {target}) {
     set_operand(op);
   }
 
   PostfixView()
-      : Node(NodeType::kPostfixView, 1u) {}
+      : FixedNode<1>(NodeType::kPostfixView) {}
 };
 
 
-class GetPropView: public Node {
+class GetPropView: public FixedNode<2> {
  public:
   GetPropView(Node* target, Node* prop)
-      : Node(NodeType::kGetPropView, 2u, {target, prop}) {}
+      : FixedNode<2>(NodeType::kGetPropView, {target, prop}) {}
 
 
   GetPropView()
-      : Node(NodeType::kGetPropView, 2u) {}
+      : FixedNode<2>(NodeType::kGetPropView) {}
 
   // Getter and Setter for target.
   NODE_PROPERTY(target, 0)
@@ -2133,10 +2211,10 @@ class GetPropView: public Node {
 };
 
 
-class GetElemView: public Node {
+class GetElemView: public FixedNode<2> {
  public:
   GetElemView(Node* target, Node* prop)
-      : Node(NodeType::kGetElemView, 2u, {target, prop}) {}
+      : FixedNode<2>(NodeType::kGetElemView, {target, prop}) {}
 
   
   // Getter and Setter for target.
@@ -2148,10 +2226,10 @@ class GetElemView: public Node {
 };
 
 
-class AssignmentView: public Node {
+class AssignmentView: public FixedNode<2> {
  public:
   AssignmentView(TokenKind op, Node* target, Node* expr)
-      : Node(NodeType::kAssignmentView, 2u, {target, expr}) {
+      : FixedNode<2>(NodeType::kAssignmentView, {target, expr}) {
     set_operand(op);
   }
 
@@ -2165,10 +2243,10 @@ class AssignmentView: public Node {
 };
 
 
-class TemaryExprView: public Node {
+class TemaryExprView: public FixedNode<3> {
  public :
   TemaryExprView(Node* cond, Node* then_expr, Node* else_expr)
-      : Node(NodeType::kTemaryExprView, 3u, {cond, then_expr, else_expr}) {}
+      : FixedNode<3>(NodeType::kTemaryExprView, {cond, then_expr, else_expr}) {}
 
 
   // Getter and Setter for cond.
@@ -2184,10 +2262,10 @@ class TemaryExprView: public Node {
 };
 
 
-class BinaryExprView: public Node {
+class BinaryExprView: public FixedNode<2> {
  public:
   BinaryExprView(TokenKind op, Node* first, Node* second)
-      : Node(NodeType::kBinaryExprView, 2u, {first, second}) {
+      : FixedNode<2>(NodeType::kBinaryExprView, {first, second}) {
     set_operand(op);
   }
 
@@ -2200,10 +2278,10 @@ class BinaryExprView: public Node {
 
 
 // Represent cast.
-class CastView: public Node {
+class CastView: public FixedNode<2> {
  public:
   CastView(Node* type_expr, Node* expr)
-      : Node(NodeType::kCastView, 2u, {type_expr, expr}) {}
+      : FixedNode<2>(NodeType::kCastView, {type_expr, expr}) {}
 
 
   // Getter and setter for type_expr.
@@ -2214,10 +2292,10 @@ class CastView: public Node {
 };
 
 
-class UnaryExprView: public Node {
+class UnaryExprView: public FixedNode<1> {
  public:
   UnaryExprView(TokenKind op, Node* expr)
-      : Node(NodeType::kUnaryExprView, 1u, {expr}) {
+      : FixedNode<1>(NodeType::kUnaryExprView, {expr}) {
     set_operand(op);
   }
 
@@ -2229,41 +2307,46 @@ class UnaryExprView: public Node {
 class ThisView: public Node {
  public:
   ThisView()
-      : Node(NodeType::kThisView, 0) {}
+      : Node(NodeType::kThisView) {}
 };
 
 
 class NumberView: public Node {
  public:
-  NumberView(const Literal* value)
-      : Node(NodeType::kNumberView, 0) {
-    const char* val = value->utf8_value();
-    set_string_value(value);
-    double d = 0l;
-    sscanf(val, "%lf", &d);
-    set_double_value(d);
+  // The value is the numeric value that is already converted by the scanner.
+  // The value is kept in the payload of the node and the literal is kept in this view.
+  NumberView(const Literal* literal, double value)
+      : Node(NodeType::kNumberView),
+        literal_(literal) {
+    set_double_value(value);
   }
+
+
+  YATSC_CONST_GETTER(const Literal*, literal, literal_)
+
+ private:
+  const Literal* literal_;
 };
 
 
 class NullView: public Node {
  public:
   NullView()
-      : Node(NodeType::kNullView, 0) {}
+      : Node(NodeType::kNullView) {}
 };
 
 
 class NaNView: public Node {
  public:
   NaNView()
-      : Node(NodeType::kNaNView, 0) {}
+      : Node(NodeType::kNaNView) {}
 };
 
 
 class StringView: public Node {
  public:
   StringView(const Literal* str)
-      : Node(NodeType::kStringView, 0) {
+      : Node(NodeType::kStringView) {
     set_string_value(str);
   }
 };
@@ -2272,16 +2355,16 @@ class StringView: public Node {
 class RegularExprView: public Node {
  public:
   RegularExprView(const Literal* str)
-      : Node(NodeType::kRegularExprView, 0) {
+      : Node(NodeType::kRegularExprView) {
     set_string_value(str);
   }
 };
 
 
-class ObjectElementView: public Node {
+class ObjectElementView: public FixedNode<2> {
  public:
   ObjectElementView(Node* key, Node* value)
-      : Node(NodeType::kObjectElementView, 2u, {key, value}) {}
+      : FixedNode<2>(NodeType::kObjectElementView, {key, value}) {}
 
   // Getter and setter for key_.
   NODE_PROPERTY(key, 0)
@@ -2292,39 +2375,31 @@ class ObjectElementView: public Node {
 };
 
 
-class ObjectLiteralView: public PropertyNode {
+class ObjectLiteralView: public PropertyNode<0> {
  public:
-  ObjectLiteralView(std::initializer_list<Node*> properties)
-      : PropertyNode(NodeType::kObjectLiteralView, 0, properties) {}
-
-
   ObjectLiteralView()
-      : PropertyNode(NodeType::kObjectLiteralView, 0) {}
+      : PropertyNode<0>(NodeType::kObjectLiteralView) {}
 };
 
 
 class ArrayLiteralView: public Node {
  public:
-  ArrayLiteralView(std::initializer_list<Node*> elements)
-      : Node(NodeType::kArrayLiteralView, 0, elements) {}
-
-
   ArrayLiteralView()
-      : Node(NodeType::kArrayLiteralView, 0) {}
+      : Node(NodeType::kArrayLiteralView) {}
 };
 
 
 class UndefinedView: public Node {
  public:
   UndefinedView():
-      Node(NodeType::kUndefinedView, 0){}
+      Node(NodeType::kUndefinedView){}
 };
 
 
 class TemplateLiteralView: public Node {
  public:
   TemplateLiteralView(const Literal* expr):
-      Node(NodeType::kUndefinedView, 0) {
+      Node(NodeType::kUndefinedView) {
     set_string_value(expr);
   }
 };
@@ -2333,21 +2408,21 @@ class TemplateLiteralView: public Node {
 class DebuggerView: public Node {
  public:
   DebuggerView():
-      Node(NodeType::kDebuggerView, 0){}
+      Node(NodeType::kDebuggerView){}
 };
 
 
-class ComprehensionExprView: public Node {
+class ComprehensionExprView: public FixedNode<2> {
  public:
   ComprehensionExprView(bool generator, Node* for_expr, Node* tail)
-      : Node(NodeType::kComprehensionExprView, 2, {for_expr, tail}) {
+      : FixedNode<2>(NodeType::kComprehensionExprView, {for_expr, tail}) {
     if (generator) {
       set_flag(0);
     }
   }
 
   ComprehensionExprView()
-      : Node(NodeType::kComprehensionExprView, 2) {}
+      : FixedNode<2>(NodeType::kComprehensionExprView) {}
 
   
   NODE_PROPERTY(for_expr, 0)
@@ -2358,16 +2433,16 @@ class ComprehensionExprView: public Node {
 };
 
 
-class AmbientFunctionDeclarationView: public Node {
+class AmbientFunctionDeclarationView: public FixedNode<2> {
  public:
   AmbientFunctionDeclarationView(bool generator, Node* identifier, Node* call_signature)
-      : Node(NodeType::kAmbientFunctionDeclarationView, 2u, {identifier, call_signature}) {
+      : FixedNode<2>(NodeType::kAmbientFunctionDeclarationView, {identifier, call_signature}) {
     set_flag(0, generator);
   }
 
 
   AmbientFunctionDeclarationView()
-      : Node(NodeType::kAmbientFunctionDeclarationView, 2u) {}
+      : FixedNode<2>(NodeType::kAmbientFunctionDeclarationView) {}
 
 
   NODE_PROPERTY(identifier, 0)
@@ -2380,13 +2455,13 @@ class AmbientFunctionDeclarationView: public Node {
 };
 
 
-class AmbientClassDeclarationView: public Node {
+class AmbientClassDeclarationView: public FixedNode<4> {
  public:
   AmbientClassDeclarationView(Node* identifier, Node* type_parameters, Node* bases, Node* body)
-      : Node(NodeType::kAmbientClassDeclarationView, 4u, {identifier, type_parameters, bases, body}) {}
+      : FixedNode<4>(NodeType::kAmbientClassDeclarationView, {identifier, type_parameters, bases, body}) {}
 
   AmbientClassDeclarationView()
-      : Node(NodeType::kAmbientClassDeclarationView, 4u) {}
+      : FixedNode<4>(NodeType::kAmbientClassDeclarationView) {}
 
 
   NODE_PROPERTY(identifier, 0)
@@ -2405,18 +2480,18 @@ class AmbientClassDeclarationView: public Node {
 class AmbientClassFieldsView: public Node {
  public:
   AmbientClassFieldsView()
-      : Node(NodeType::kAmbientClassFieldsView, 0u) {}
+      : Node(NodeType::kAmbientClassFieldsView) {}
 };
 
 
-class AmbientVariableView: public Node {
+class AmbientVariableView: public FixedNode<2> {
  public:
   AmbientVariableView(Node* identifier, Node* type)
-      : Node(NodeType::kAmbientVariableView, 2u, {identifier, type}) {}
+      : FixedNode<2>(NodeType::kAmbientVariableView, {identifier, type}) {}
 
   
   AmbientVariableView()
-      : Node(NodeType::kAmbientVariableView, 2u) {}
+      : FixedNode<2>(NodeType::kAmbientVariableView) {}
 
 
   NODE_PROPERTY(identifier, 0)
@@ -2426,14 +2501,14 @@ class AmbientVariableView: public Node {
 };
 
 
-class AmbientConstructorView: public Node {
+class AmbientConstructorView: public FixedNode<2> {
  public:
   AmbientConstructorView(Node* modifiers, Node* call_signature)
-      : Node(NodeType::kAmbientConstructorView, 2u, {modifiers, call_signature}) {}
+      : FixedNode<2>(NodeType::kAmbientConstructorView, {modifiers, call_signature}) {}
 
 
   AmbientConstructorView()
-      : Node(NodeType::kAmbientConstructorView, 2u) {}
+      : FixedNode<2>(NodeType::kAmbientConstructorView) {}
 
 
   NODE_PROPERTY(modifiers, 0)
@@ -2443,10 +2518,10 @@ class AmbientConstructorView: public Node {
 };
 
 
-class AmbientMemberFunctionView: public Node {
+class AmbientMemberFunctionView: public FixedNode<3> {
  public:
   AmbientMemberFunctionView(bool getter, bool setter, bool generator, Node* modifiers, Node* identifier, Node* call_signature)
-      : Node(NodeType::kAmbientMemberFunctionView, 3u, {modifiers, identifier, call_signature}) {
+      : FixedNode<3>(NodeType::kAmbientMemberFunctionView, {modifiers, identifier, call_signature}) {
     set_flag(0, getter);
     set_flag(1, setter);
     set_flag(2, generator);
@@ -2454,7 +2529,7 @@ class AmbientMemberFunctionView: public Node {
 
 
   AmbientMemberFunctionView()
-      : Node(NodeType::kAmbientMemberFunctionView, 3u) {}
+      : FixedNode<3>(NodeType::kAmbientMemberFunctionView) {}
 
 
   NODE_PROPERTY(modifiers, 0)
@@ -2467,14 +2542,14 @@ class AmbientMemberFunctionView: public Node {
 };
 
 
-class AmbientMemberVariableView: public Node {
+class AmbientMemberVariableView: public FixedNode<3> {
  public:
   AmbientMemberVariableView(Node* modifiers, Node* identifier, Node* type)
-      : Node(NodeType::kAmbientMemberVariableView, 3u, {modifiers, identifier, type}) {}
+      : FixedNode<3>(NodeType::kAmbientMemberVariableView, {modifiers, identifier, type}) {}
 
 
   AmbientMemberVariableView()
-      : Node(NodeType::kAmbientMemberVariableView, 3u) {}
+      : FixedNode<3>(NodeType::kAmbientMemberVariableView) {}
 
 
   NODE_PROPERTY(modifiers, 0)
@@ -2487,14 +2562,14 @@ class AmbientMemberVariableView: public Node {
 };
 
 
-class AmbientEnumDeclarationView: public Node {
+class AmbientEnumDeclarationView: public FixedNode<2> {
  public:
   AmbientEnumDeclarationView(Node* identifier, Node* body)
-      : Node(NodeType::kAmbientEnumDeclarationView, 2u, {identifier, body}) {}
+      : FixedNode<2>(NodeType::kAmbientEnumDeclarationView, {identifier, body}) {}
 
 
   AmbientEnumDeclarationView()
-      : Node(NodeType::kAmbientEnumDeclarationView, 2u) {}
+      : FixedNode<2>(NodeType::kAmbientEnumDeclarationView) {}
 
 
   NODE_PROPERTY(identifier, 0)
@@ -2507,18 +2582,18 @@ class AmbientEnumDeclarationView: public Node {
 class AmbientEnumBodyView: public Node {
  public:
   AmbientEnumBodyView()
-      : Node(NodeType::kAmbientEnumBodyView, 0u) {}
+      : Node(NodeType::kAmbientEnumBodyView) {}
 };
 
 
-class AmbientEnumFieldView: public Node {
+class AmbientEnumFieldView: public FixedNode<2> {
  public:
   AmbientEnumFieldView(Node* property_name, Node* value)
-      : Node(NodeType::kAmbientEnumFieldView, 2u, {property_name, value}) {}
+      : FixedNode<2>(NodeType::kAmbientEnumFieldView, {property_name, value}) {}
 
 
   AmbientEnumFieldView()
-      : Node(NodeType::kAmbientEnumFieldView, 2u) {}
+      : FixedNode<2>(NodeType::kAmbientEnumFieldView) {}
 
 
   NODE_PROPERTY(property_name, 0)
@@ -2528,16 +2603,16 @@ class AmbientEnumFieldView: public Node {
 };
 
 
-class AmbientModuleView: public Node {
+class AmbientModuleView: public FixedNode<2> {
  public:
   AmbientModuleView(bool external, Node* identifier, Node* body)
-      : Node(NodeType::kAmbientModuleView, 2u, {identifier, body}) {
+      : FixedNode<2>(NodeType::kAmbientModuleView, {identifier, body}) {
     set_flag(0, external);
   }
 
 
   AmbientModuleView()
-      : Node(NodeType::kAmbientModuleView, 2u) {}
+      : FixedNode<2>(NodeType::kAmbientModuleView) {}
 
 
   NODE_PROPERTY(identifier, 0)
@@ -2553,22 +2628,36 @@ class AmbientModuleView: public Node {
 class AmbientModuleBody: public Node {
  public:
   AmbientModuleBody()
-      : Node(NodeType::kAmbientModuleBody, 0u) {}
+      : Node(NodeType::kAmbientModuleBody) {}
 };
 
 
 class Empty: public Node {
  public:
   Empty()
-      : Node(NodeType::kEmptyStatement, 0){}
+      : Node(NodeType::kEmptyStatement){}
 };
 
+
+// Check that the arity of the VIEW_LIST is same as the inline array size of the fixed arity view.
+// The views that are not derived from the FixedNode or have no inline array are not checked.
+template <size_t N>
+std::integral_constant<size_t, N> InlineArityOf(const FixedNode<N>*);
+std::integral_constant<size_t, 0> InlineArityOf(const Node*);
+std::integral_constant<size_t, 0> InlineArityOf(const void*);
+
+#define CHECK_ARITY(ViewName, arity)                                    \
+  static_assert(decltype(InlineArityOf(static_cast<ViewName*>(nullptr)))::value == 0 || \
+                decltype(InlineArityOf(static_cast<ViewName*>(nullptr)))::value == arity, \
+                #ViewName " has the inline children that is different from the arity of the VIEW_LIST.");
+VIEW_LIST(CHECK_ARITY, CHECK_ARITY, CHECK_ARITY)
+#undef CHECK_ARITY
+
 }} //yatsc::ir
 
 #undef NODE_PROPERTY
 #undef NODE_GETTER
 #undef NODE_SETTER
 #undef DEF_CAST
-#undef VIEW_LIST
 
 #endif
@@ -47,13 +47,13 @@ class Properties: private Uncopyable {
   ~Properties() = default;
 
 
-  void Declare(Handle<Symbol> symbol, Node* prop) {
-    properties_.insert(std::make_pair(symbol, prop));
+  void Declare(Symbol* symbol, Node* prop) {
+    properties_.insert(std::make_pair(symbol->id(), prop));
   }
 
 
-  YATSC_INLINE Property FindDeclaredItem(Handle<Symbol> symbol) {
-    return *(properties_.find(symbol));
+  YATSC_INLINE Property FindDeclaredItem(Symbol* symbol) {
+    return *(properties_.find(symbol->id()));
   }
 
 
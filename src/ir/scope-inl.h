@@ -23,17 +23,36 @@
 
 namespace yatsc { namespace ir {
 
-Maybe<DeclaredRange> Scope::FindDeclaredItem(Handle<Symbol> name) {
-  DeclaredRange range = declared_items_.equal_range(name->utf8_value());
-  if (range.first == declared_items_.end()) {
-    if (parent_scope_) {
-      return parent_scope_->FindDeclaredItem(name);
-    } else if (global_scope_) {
-      return global_scope_->FindDeclaredItem(name);
+Scope* Scope::outer_scope() YATSC_NOEXCEPT {
+  if (parent_scope_) {
+    return parent_scope_.Get();
+  }
+  return global_scope_? global_scope_.Get(): nullptr;
+}
+
+
+DeclaredItem& Scope::ItemAt(const Binding& binding) {
+  Scope* scope = this;
+  for (uint32_t i = 0; i < binding.depth(); i++) {
+    scope = scope->outer_scope();
+  }
+  return scope->declared_items_[binding.slot()];
+}
+
+
+// Find the item from this scope to the global scope.
+// The chain is walked by the loop, so the inlined function does not call itself.
+Maybe<DeclaredRange> Scope::FindDeclaredItem(Symbol* name) {
+  Scope* scope = this;
+  while (scope != nullptr) {
+    uint32_t index = scope->FindNewestItem(name->value());
+    if (index != DeclaredIterator::kEnd) {
+      DeclaredItems* items = &scope->declared_items_;
+      return Just(MakeRange(DeclaredIterator(items, index), DeclaredIterator(items, DeclaredIterator::kEnd)));
     }
-    return Nothing<DeclaredRange>();
+    scope = scope->outer_scope();
   }
-  return Just(range);
+  return Nothing<DeclaredRange>();
 }
 
 }}
@@ -0,0 +1,158 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) Taketoshi Aono(brn)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+
+#ifndef IR_SCOPE_RESOLVER_H
+#define IR_SCOPE_RESOLVER_H
+
+#include "../utils/utils.h"
+#include "../utils/stl.h"
+#include "../utils/flat-id-map.h"
+#include "./node.h"
+#include "./node-visitor.h"
+#include "./scope.h"
+
+namespace yatsc { namespace ir {
+
+// Set the binding to the each variable name of the tree.
+// The scopes of the BlockView and the FileScopeView are entered in the order of the tree,
+// and the binding of the name is cached in the each scope,
+// so the same name in the same scope is resolved without searching the scopes again.
+// The binding of the inner scope is made from the binding of the outer scope
+// if the name is not declared in the inner scope, so the each scope is searched only once for the each name.
+class ScopeResolver: public NodeVisitor<ScopeResolver> {
+ public:
+  ScopeResolver()
+      : resolved_count_(0) {}
+
+
+  // Resolve the names of the tree and return the count of the resolved names.
+  size_t Resolve(Node* root) {
+    frames_.clear();
+    bindings_.clear();
+    resolved_count_ = 0;
+    Walk(root);
+    return resolved_count_;
+  }
+
+
+  VisitResult EnterFileScopeView(FileScopeView* node) {
+    EnterScope(node->scope());
+    return VisitResult::kContinue;
+  }
+
+
+  void LeaveFileScopeView(FileScopeView* node) {
+    frames_.pop_back();
+  }
+
+
+  VisitResult EnterBlockView(BlockView* node) {
+    EnterScope(node->scope());
+    return VisitResult::kContinue;
+  }
+
+
+  void LeaveBlockView(BlockView* node) {
+    frames_.pop_back();
+  }
+
+
+  VisitResult EnterNameView(NameView* node) {
+    Symbol* symbol = node->symbol();
+    if (!frames_.empty() && symbol != nullptr && symbol->type() == SymbolType::kVariableName) {
+      Binding binding = Lookup(symbol->value());
+      node->set_binding(binding);
+      if (binding.resolved()) {
+        resolved_count_++;
+      }
+    }
+    return VisitResult::kSkipChildren;
+  }
+
+ private:
+  // The scope and the cache of the bindings that are resolved in the scope.
+  // The cache has the index of the bindings_.
+  struct Frame {
+    Scope* scope;
+    FlatIdMap cache;
+  };
+
+
+  void EnterScope(Handle<Scope> scope) {
+    frames_.push_back(Frame());
+    frames_.back().scope = scope.Get();
+  }
+
+
+  // Find the binding from the innermost frame to the frame that has the cache or the item,
+  // and cache the binding to the frames that are passed.
+  Binding Lookup(const Literal* name) {
+    size_t i = frames_.size();
+    Binding binding;
+    while (i > 0) {
+      Frame& frame = frames_[--i];
+      uint32_t cached = frame.cache.Find(name->id());
+      if (cached != FlatIdMap::kNotFound) {
+        binding = bindings_[cached];
+        break;
+      }
+
+      uint32_t slot = frame.scope->FindNewestItem(name);
+      if (slot != DeclaredIterator::kEnd) {
+        binding = Binding(0, slot);
+        Cache(&frame, name, binding);
+        break;
+      }
+
+      // The outer scope that is not entered, like the GlobalScope, is searched by the scope.
+      Scope* outer_scope = frame.scope->outer_scope();
+      if (i == 0 || frames_[i - 1].scope != outer_scope) {
+        binding = outer_scope != nullptr? outer_scope->Resolve(name).Outer(): Binding();
+        Cache(&frame, name, binding);
+        break;
+      }
+    }
+
+    for (size_t j = i + 1; j < frames_.size(); j++) {
+      binding = binding.Outer();
+      Cache(&frames_[j], name, binding);
+    }
+    return binding;
+  }
+
+
+  void Cache(Frame* frame, const Literal* name, const Binding& binding) {
+    frame->cache.Set(name->id(), static_cast<uint32_t>(bindings_.size()));
+    bindings_.push_back(binding);
+  }
+
+
+  Vector<Frame> frames_;
+  Vector<Binding> bindings_;
+  size_t resolved_count_;
+};
+
+}}
+
+#endif
@@ -40,11 +40,11 @@ Scope::Scope() {}
 Scope::~Scope() {}
 
 
-void Scope::Declare(Node* var, Handle<Type> type) {
+void Scope::Declare(Node* var, const Handle<Type>& type) {
   if (var->HasVariableView()) {
     if (var->first_child()->HasNameView()) {
       auto info = GatheredTypeInfo(type, var, ir::Type::Modifier::kPublic);
-      declared_items_.insert(std::make_pair(var->first_child()->symbol()->utf8_value(), info));
+      Insert(var->first_child()->symbol()->value(), std::move(info));
     } else if (var->first_child()->HasBindingPropListView()) {
       Declare(var->first_child());
     }
@@ -52,7 +52,7 @@ void Scope::Declare(Node* var, Handle<Type> type) {
     for (auto node: *var) {
       if (!node->node_list()[0]) {
         auto info = GatheredTypeInfo(type, node->node_list()[0], ir::Type::Modifier::kPublic);
-        declared_items_.insert(std::make_pair(node->node_list()[0]->symbol()->utf8_value(), info));
+        Insert(node->node_list()[0]->symbol()->value(), std::move(info));
       } else {
         Declare(node->node_list()[0]);
       }
@@ -61,30 +61,121 @@ void Scope::Declare(Node* var, Handle<Type> type) {
     Node* name = var->node_list()[1];
     if (name && name->HasNameView()) {
       auto info = GatheredTypeInfo(type, var, ir::Type::Modifier::kPublic);
-      declared_items_.insert(std::make_pair(name->symbol()->utf8_value(), info));
+      Insert(name->symbol()->value(), std::move(info));
     }
   } else if (var->HasClassDeclView() || var->HasInterfaceView() || var->HasEnumDeclView()) {
     Node* name = var->first_child();
     if (name && name->HasNameView()) {
       auto info = GatheredTypeInfo(type, var, ir::Type::Modifier::kPublic);
-      declared_items_.insert(std::make_pair(name->symbol()->utf8_value(), info));
+      Insert(name->symbol()->value(), std::move(info));
     }
   }
 }
 
 
+size_t Scope::AllocatedSize() const {
+  size_t size = sizeof(*this);
+  size += declared_items_.capacity() * sizeof(DeclaredItem);
+  size += declared_index_.capacity() * (sizeof(Unique::Id) + sizeof(uint32_t));
+  size += child_scope_list_.capacity() * sizeof(Handle<Scope>);
+  return size;
+}
+
+
 void Scope::Declare(Node* var) {
   Declare(var, global_scope_->phai_type());
 }
 
 
+// Remove the items that are declared after the count was taken.
+// The items are removed from the newest one, so the newest item of the name
+// is restored to the item that is linked from the removed item.
+void Scope::UndoDeclarations(size_t count) {
+  while (declared_items_.size() > count) {
+    DeclaredItem& item = declared_items_.back();
+    if (!declared_index_.empty()) {
+      if (item.next() == DeclaredIterator::kEnd) {
+        declared_index_.Erase(item.name()->id());
+      } else {
+        declared_index_.Set(item.name()->id(), item.next());
+      }
+    }
+    declared_items_.pop_back();
+  }
+}
+
+
+void Scope::Merge(Handle<Scope> scope) {
+  for (auto& item: scope->declared_items_) {
+    Insert(item.name(), GatheredTypeInfo(item.info()));
+  }
+}
+
+
+void Scope::Insert(const Literal* name, GatheredTypeInfo&& info) {
+  uint32_t index = static_cast<uint32_t>(declared_items_.size());
+  declared_items_.emplace_back(name, std::move(info), FindNewestItem(name));
+  if (!declared_index_.empty()) {
+    declared_index_.Set(name->id(), index);
+  } else if (declared_items_.size() > kLinearSearchLimit) {
+    // The items are indexed in the declaration order, so the newest item of the each name is left.
+    for (uint32_t i = 0; i < declared_items_.size(); i++) {
+      declared_index_.Set(declared_items_[i].name()->id(), i);
+    }
+  }
+}
+
+
+Binding Scope::Resolve(const Literal* name) {
+  uint32_t depth = 0;
+  for (Scope* scope = this; scope != nullptr; scope = scope->outer_scope(), depth++) {
+    uint32_t slot = scope->FindNewestItem(name);
+    if (slot != DeclaredIterator::kEnd) {
+      return Binding(depth, slot);
+    }
+  }
+  return Binding();
+}
+
+
+uint32_t Scope::FindNewestItem(const Literal* name) const {
+  if (!declared_index_.empty()) {
+    return declared_index_.Find(name->id());
+  }
+  for (size_t i = declared_items_.size(); i > 0; i--) {
+    if (declared_items_[i - 1].name()->id() == name->id()) {
+      return static_cast<uint32_t>(i - 1);
+    }
+  }
+  return DeclaredIterator::kEnd;
+}
+
+
 void GlobalScope::Initialize() {
-  // string_type_ = DeclareBuiltin("string",  Heap::NewHandle<ir::StringType>());
-  // number_type_ = DeclareBuiltin("number",  Heap::NewHandle<ir::NumberType>());
-  // boolean_type_ = DeclareBuiltin("boolean", Heap::NewHandle<ir::BooleanType>());
-  // void_type_ = DeclareBuiltin("void",    Heap::NewHandle<ir::VoidType>());
-  // any_type_ = DeclareBuiltin("any",     Heap::NewHandle<ir::AnyType>());
-  //phai_type_ = Heap::NewHandle<ir::PhaiType>();
+  string_type_ = Heap::NewHandle<ir::StringType>();
+  number_type_ = Heap::NewHandle<ir::NumberType>();
+  boolean_type_ = Heap::NewHandle<ir::BooleanType>();
+  void_type_ = Heap::NewHandle<ir::VoidType>();
+  any_type_ = Heap::NewHandle<ir::AnyType>();
+  phai_type_ = Heap::NewHandle<ir::PhaiType>();
+}
+
+
+// The names of the builtin types are the atoms,
+// so the name is checked by the id without the string comparison.
+Handle<ir::Type> GlobalScope::FindBuiltinType(const Literal* name) const {
+  if (name->Is(Atom::kString)) {
+    return string_type_;
+  } else if (name->Is(Atom::kNumber)) {
+    return number_type_;
+  } else if (name->Is(Atom::kBoolean)) {
+    return boolean_type_;
+  } else if (name->Is(Atom::kVoid)) {
+    return void_type_;
+  } else if (name->Is(Atom::kAny)) {
+    return any_type_;
+  }
+  return Handle<ir::Type>();
 }
 
 
@@ -27,6 +27,7 @@
 #include "../utils/utils.h"
 #include "../utils/stl.h"
 #include "../utils/unicode.h"
+#include "../utils/flat-id-map.h"
 #include "./symbol.h"
 #include "./types.h"
 
@@ -43,11 +44,123 @@ class GlobalScope;
 
 
 typedef Vector<Handle<Scope>> Scopes;
-typedef MultiHashMap<std::string, GatheredTypeInfo> DeclaredMap;
-typedef IteratorRange<DeclaredMap::const_iterator, DeclaredMap::const_iterator> DeclaredRange;
+
+
+// The item declared in the scope.
+class DeclaredItem {
+ public:
+  DeclaredItem(const Literal* name, GatheredTypeInfo&& info, uint32_t next)
+      : name_(name),
+        info_(std::move(info)),
+        next_(next) {}
+
+
+  YATSC_CONST_GETTER(const Literal*, name, name_)
+
+
+  YATSC_GETTER(GatheredTypeInfo&, info, info_)
+
+
+  // The index of the item that has the same name and is declared before this item.
+  YATSC_CONST_GETTER(uint32_t, next, next_)
+
+ private:
+  const Literal* name_;
+  GatheredTypeInfo info_;
+  uint32_t next_;
+};
+
+
+typedef Vector<DeclaredItem> DeclaredItems;
+
+
+// The iterator of the items that have the same name, from the newest to the oldest.
+// The iterator keeps the index instead of the pointer,
+// so the iterator is not invalidated by the following declarations.
+class DeclaredIterator: public std::iterator<std::forward_iterator_tag, DeclaredItem> {
+ public:
+  static const uint32_t kEnd = FlatIdMap::kNotFound;
+
+  DeclaredIterator(DeclaredItems* items, uint32_t index)
+      : items_(items),
+        index_(index) {}
+
+
+  YATSC_INLINE DeclaredItem& operator *() YATSC_NO_SE {return (*items_)[index_];}
+
+
+  YATSC_INLINE DeclaredItem* operator ->() YATSC_NO_SE {return &(*items_)[index_];}
+
+
+  YATSC_INLINE DeclaredIterator& operator ++() {
+    index_ = (*items_)[index_].next();
+    return *this;
+  }
+
+
+  YATSC_INLINE DeclaredIterator operator ++(int) {
+    DeclaredIterator ret = *this;
+    ++(*this);
+    return ret;
+  }
+
+
+  YATSC_INLINE bool operator == (const DeclaredIterator& it) YATSC_NO_SE {return index_ == it.index_;}
+
+
+  YATSC_INLINE bool operator != (const DeclaredIterator& it) YATSC_NO_SE {return index_ != it.index_;}
+
+ private:
+  DeclaredItems* items_;
+  uint32_t index_;
+};
+
+
+typedef IteratorRange<DeclaredIterator, DeclaredIterator> DeclaredRange;
+
+
+// The place of the item that the name refers.
+// The depth is the count of the outer scopes from the scope of the name to the scope of the item,
+// and the slot is the index of the item in the scope.
+class Binding {
+ public:
+  static const uint32_t kUnresolved = ~0u;
+
+  Binding()
+      : depth_(kUnresolved),
+        slot_(kUnresolved) {}
+
+
+  Binding(uint32_t depth, uint32_t slot)
+      : depth_(depth),
+        slot_(slot) {}
+
+
+  YATSC_CONST_GETTER(uint32_t, depth, depth_)
+
+
+  YATSC_CONST_GETTER(uint32_t, slot, slot_)
+
+
+  YATSC_INLINE bool resolved() YATSC_NO_SE {return slot_ != kUnresolved;}
+
+
+  // Return the binding that is seen from the inner scope.
+  YATSC_INLINE Binding Outer() YATSC_NO_SE {
+    return resolved()? Binding(depth_ + 1, slot_): Binding();
+  }
+
+ private:
+  uint32_t depth_;
+  uint32_t slot_;
+};
 typedef IteratorRange<Scopes::iterator, Scopes::iterator> ScopeRange;
 
 
+// The scope keeps the declared items in the declaration order and finds the item by the id of the Literal.
+// The name is interned by the LiteralBuffer, so the name is not copied or hashed as the string.
+// Most scopes have a few items, so the items are searched linearly from the newest one
+// and the FlatIdMap is built only after the scope has more than kLinearSearchLimit items.
 class Scope: private Uncopyable {
  public:
   Scope(Handle<Scope> parent_scope, Handle<GlobalScope> global_scope);
@@ -62,10 +175,41 @@ class Scope: private Uncopyable {
   void Declare(Node* variable);
 
 
-  void Declare(Node* variable, Handle<ir::Type> type);
+  void Declare(Node* variable, const Handle<ir::Type>& type);
+
+
+  YATSC_INLINE Maybe<DeclaredRange> FindDeclaredItem(Symbol* name);
+
 
+  // Return the binding of the newest item that has the name in this scope or the outer scopes.
+  Binding Resolve(const Literal* name);
 
-  YATSC_INLINE Maybe<DeclaredRange> FindDeclaredItem(Handle<Symbol> name);
+
+  // Return the item of the binding that is resolved from this scope.
+  // The outer scopes are followed by the depth, so the names are not searched again.
+  YATSC_INLINE DeclaredItem& ItemAt(const Binding& binding);
+
+
+  // Return the index of the newest item that has the name in this scope or DeclaredIterator::kEnd.
+  uint32_t FindNewestItem(const Literal* name) const;
+
+
+  // The scope that is searched after this scope,
+  // that is the parent scope, the global scope or nullptr.
+  YATSC_INLINE Scope* outer_scope() YATSC_NOEXCEPT;
+
+
+  // The count of the items declared in this scope.
+  // The count is used as the mark that is passed to the UndoDeclarations.
+  YATSC_INLINE size_t declaration_count() YATSC_NO_SE {return declared_items_.size();}
+
+
+  // Remove the items which are declared after the declaration_count was taken.
+  void UndoDeclarations(size_t count);
+
+
+  // Declare the items of the scope in this scope, in the order of the declaration.
+  void Merge(Handle<Scope> scope);
 
 
   void AddChild(Handle<Scope> child) {
@@ -78,8 +222,21 @@ class Scope: private Uncopyable {
 
   YATSC_PROPERTY(Handle<Scope>, parent_scope, parent_scope_)
 
+
+  // Return the approximate bytes of this scope and the declared items.
+  // The parent and the children scopes are not included.
+  size_t AllocatedSize() const;
+
  private:
-  DeclaredMap declared_items_;
+  static const size_t kLinearSearchLimit = 8;
+
+  
+  void Insert(const Literal* name, GatheredTypeInfo&& info);
+
+  
+  DeclaredItems declared_items_;
+  // The index of the newest item of each name, that is empty until the scope has many items.
+  FlatIdMap declared_index_;
   Handle<Scope> parent_scope_;
   Handle<GlobalScope> global_scope_;
   Scopes child_scope_list_;
@@ -100,6 +257,11 @@ class GlobalScope: public Scope {
   YATSC_CONST_GETTER(Handle<AnyType>, any_type, any_type_)
   YATSC_CONST_GETTER(Handle<PhaiType>, phai_type, phai_type_)
 
+
+  // Return the builtin type that has the specified name,
+  // or the empty handle if the name is not the builtin type.
+  Handle<ir::Type> FindBuiltinType(const Literal* name) const;
+
   
  private:
   void Initialize();
@@ -59,6 +59,8 @@ enum class SymbolType: uint8_t {
 #undef DECLARE_SYMBOL_LAST
 
 
+// The symbols are interned by the IRFactory for each pair of the SymbolType and the Literal,
+// so the symbol is shared by the all nodes that have the same name and must not be modified.
 class Symbol {
  public:
   Symbol(SymbolType symbol_type, const Literal* value)
@@ -71,7 +73,7 @@ class Symbol {
   YATSC_CONST_GETTER(Unique::Id, id, value_->id())
 
   
-  YATSC_PROPERTY(SymbolType, type, type_)
+  YATSC_CONST_GETTER(SymbolType, type, type_)
 
   
   YATSC_CONST_GETTER(const Literal*, value, value_)
@@ -94,7 +96,7 @@ class Symbol {
   
   const char* utf8_value() const {return value_->utf8_value();}
 
-  bool Equals(Handle<Symbol> symbol) YATSC_NO_SE {
+  bool Equals(const Symbol* symbol) YATSC_NO_SE {
     return symbol->value_->Equals(value_);
   }
 
@@ -102,6 +104,11 @@ class Symbol {
     return value_->Equals(value);
   }
 
+
+  bool Is(Atom atom) YATSC_NO_SE {
+    return value_->Is(atom);
+  }
+
 #define DECLARE_SYMBOL(t)                       \
   bool Is##t() {return SymbolType::k##t == type_;}
 
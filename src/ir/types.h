@@ -120,7 +120,7 @@ class Type {
 class GatheredTypeInfo {
  public:
   GatheredTypeInfo(Handle<Type> type, Node* prop, Type::Modifier modifier)
-      : type_(type),
+      : type_(std::move(type)),
         node_(prop),
         modifier_(modifier) {}
 
@@ -134,7 +134,7 @@ class GatheredTypeInfo {
         modifier_(tp.modifier_) {}
 
 
-  GatheredTypeInfo(GatheredTypeInfo&& tp)
+  GatheredTypeInfo(GatheredTypeInfo&& tp) YATSC_NOEXCEPT
       : type_(std::move(tp.type_)),
         node_(std::move(tp.node_)),
         modifier_(tp.modifier_) {}
@@ -172,15 +172,15 @@ class GatheredTypeInfo {
 
 class PlaceHolderType: public Type {
  public:
-  PlaceHolderType(Handle<Symbol> symbol)
+  PlaceHolderType(Symbol* symbol)
       : Type(TypeId::kPlaceHolder) {}
 
 
-  YATSC_GETTER(Handle<Symbol>, symbol, symbol_)
+  YATSC_GETTER(Symbol*, symbol, symbol_)
 
   
  private:
-  Handle<Symbol> symbol_;
+  Symbol* symbol_;
 };
 
 
@@ -216,12 +216,12 @@ class GenericType: public Type {
       : Type(id) {}
 
   
-  void AddTypeParameter(Handle<Symbol> symbol, Handle<Type> type, Node* node) {
+  void AddTypeParameter(Symbol* symbol, Handle<Type> type, Node* node) {
     type_param_map_.insert(std::make_pair(symbol->id(), Just(GatheredTypeInfo(type, node, Type::Modifier::kPublic))));
   }
 
 
-  Maybe<GatheredTypeInfo> FindTypeParameter(Handle<Symbol> symbol) {
+  Maybe<GatheredTypeInfo> FindTypeParameter(Symbol* symbol) {
     auto it = type_param_map_.find(symbol->id());
     if (it == type_param_map_.end()) {
       return Nothing<GatheredTypeInfo>();
@@ -254,13 +254,13 @@ class PropertyType: public GenericType {
       : GenericType(id) {}
   
 
-  void DeclareType(Handle<Symbol> symbol, Handle<Type> type, Node* prop, Type::Modifier modifier = Type::Modifier::kPublic) {
-    properties_.insert(std::make_pair(symbol, Just(GatheredTypeInfo(type, prop, modifier))));
+  void DeclareType(Symbol* symbol, Handle<Type> type, Node* prop, Type::Modifier modifier = Type::Modifier::kPublic) {
+    properties_.insert(std::make_pair(symbol->id(), Just(GatheredTypeInfo(type, prop, modifier))));
   }
 
 
-  YATSC_INLINE Maybe<GatheredTypeInfo> FindDeclaredType(Handle<Symbol> symbol) {
-    TypePropertyMap::iterator it = properties_.find(symbol);
+  YATSC_INLINE Maybe<GatheredTypeInfo> FindDeclaredType(Symbol* symbol) {
+    TypePropertyMap::iterator it = properties_.find(symbol->id());
     if (it == properties_.end()) {
       return Nothing<GatheredTypeInfo>();
     }
@@ -347,12 +347,12 @@ class CallSignatureType: public GenericType {
       : GenericType(TypeId::kCallSignature) {}
 
 
-  void AddParamType(Handle<Symbol> symbol, Node* node, Handle<Type> type) {
+  void AddParamType(Symbol* symbol, Node* node, Handle<Type> type) {
     param_map_.insert(std::make_pair(symbol->id(), Just(GatheredTypeInfo(type, node, Type::Modifier::kPublic))));
   }
 
   
-  Maybe<GatheredTypeInfo> FindParameterType(Handle<Symbol> symbol) {
+  Maybe<GatheredTypeInfo> FindParameterType(Symbol* symbol) {
     auto it = param_map_.find(symbol->id());
     if (it == param_map_.end()) {
       return Nothing<GatheredTypeInfo>();
@@ -393,12 +393,12 @@ class InstanceType: public PropertyType {
         generic_type_(generic_type) {}
 
   
-  void add_type_parameter(Handle<Symbol> symbol, Handle<Type> type) {
+  void add_type_parameter(Symbol* symbol, Handle<Type> type) {
     parameterized_type_map_.insert(std::make_pair(symbol->id(), type));
   }
 
 
-  Handle<Type> FindTypeParameter(Handle<Symbol> symbol) {
+  Handle<Type> FindTypeParameter(Symbol* symbol) {
     Map::iterator it = parameterized_type_map_.find(symbol->id());
     if (it == parameterized_type_map_.end()) {
       return Handle<Type>();
@@ -73,17 +73,21 @@ YATSC_INLINE void CentralArena::Dealloc(void* ptr) YATSC_NOEXCEPT {
     // [LargeHeader][HeapBody]
     auto large_header = reinterpret_cast<LargeHeader*>(reinterpret_cast<Byte*>(area) - sizeof(LargeHeader));
 
-    // CentralArena is not thread safe, so we lock large_bin_.
+    // CentralArena is not thread safe, so we lock large_list_.
     lock_.lock();
-    large_bin_.Delete(large_header->size());
+    // Unlink this heap from the large heap list.
+    if (large_header->prev() != nullptr) {
+      large_header->prev()->set_next(large_header->next());
+    } else {
+      large_list_ = large_header->next();
+    }
     if (large_header->next() != nullptr) {
-      large_bin_.Insert(large_header->next()->size(), large_header->next());
-      large_header->set_next(nullptr);
+      large_header->next()->set_prev(large_header->prev());
     }
     lock_.unlock();
 
     // Simply unmap.
-    VirtualHeapAllocator::Unmap(large_header, large_header->size() + sizeof(LargeHeader));
+    VirtualHeapAllocator::Unmap(large_header, large_header->size() + sizeof(LargeHeader) + 1);
   } else {
 
     // Get head of the heap by masking memory address.
@@ -33,7 +33,8 @@ inline void TlsFree(void* arena) {
 }
 
 
-CentralArena::CentralArena() {
+CentralArena::CentralArena()
+    : large_list_(nullptr) {
   tls_(&TlsFree);
   local_arena_.store(nullptr, std::memory_order_relaxed);
   released_arena_count_.store(0, std::memory_order_relaxed);
@@ -116,10 +117,9 @@ void* CentralArena::AllocateLargeObject(size_t size) YATSC_NOEXCEPT {
   // so simply lock.
   ScopedSpinLock lock(lock_);
   
-  LargeHeader* large_header = large_bin_.Find(size);
-  
-  // If large_header is never allocated.
-  void* heap = VirtualHeapAllocator::Map(nullptr, size + sizeof(LargeHeader),
+  // The returned pointer is shifted by the tag bit,
+  // so reserve one more byte for the tail of the heap.
+  void* heap = VirtualHeapAllocator::Map(nullptr, size + sizeof(LargeHeader) + 1,
                                          VirtualHeapAllocator::Prot::WRITE | VirtualHeapAllocator::Prot::READ,
                                          VirtualHeapAllocator::Flags::ANONYMOUS | VirtualHeapAllocator::Flags::PRIVATE);
   if (heap == nullptr) {
@@ -128,11 +128,12 @@ void* CentralArena::AllocateLargeObject(size_t size) YATSC_NOEXCEPT {
   
   auto new_large_header = new(heap) LargeHeader(size);
 
-  if (large_header != nullptr) {
-    new_large_header->set_next(large_header);
+  // Prepend the new heap to the large heap list.
+  if (large_list_ != nullptr) {
+    new_large_header->set_next(large_list_);
+    large_list_->set_prev(new_large_header);
   }
-  large_header = new_large_header;
-  large_bin_.Insert(size, new_large_header);
+  large_list_ = new_large_header;
   
   return reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(reinterpret_cast<Byte*>(new_large_header) + sizeof(LargeHeader)) | 1);
 }
@@ -158,7 +159,9 @@ LocalArena::~LocalArena() {
 // Allocate new ChunkHeader if not yet allocated,
 // ChunkHeader is allocated from the internal_heap_ of LocalArena.
 ChunkHeader* LocalArena::AllocateIfNecessary(size_t size) YATSC_NOEXCEPT {
-  if (size < ChunkHeader::kChunkMaxAllocatableSmallObjectSize) {
+  // The block must fit in the 64KB heap with the HeapHeader,
+  // so the size near the kChunkMaxAllocatableSmallObjectSize is treated as the large object.
+  if (size + sizeof(HeapHeader) + yatsc::kAlignment <= ChunkHeader::kChunkMaxAllocatableSmallObjectSize) {
     ChunkHeader* chunk_header = small_bin_.Find(size);
     if (chunk_header == nullptr) {
       // If allocated size is overed internal heap max size,
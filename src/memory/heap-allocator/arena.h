@@ -41,18 +41,24 @@ static size_t kChunkHeaderAllocatableCount = 70;
 
 
 // Large heap header that manage each large heap block.
-class LargeHeader: public RbTreeNode<size_t, LargeHeader*> {
+// All living large heaps are linked by the doubly linked list.
+class LargeHeader {
  public:
   LargeHeader(size_t size)
       : size_(size),
+        prev_(nullptr),
         next_(nullptr) {}
   
   YATSC_CONST_PROPERTY(size_t, size, size_)
 
 
+  YATSC_PROPERTY(LargeHeader*, prev, prev_)
+  
+
   YATSC_PROPERTY(LargeHeader*, next, next_)
  private:
   size_t size_;
+  LargeHeader* prev_;
   LargeHeader* next_;
 };
 
@@ -118,7 +124,7 @@ class CentralArena {
   
   AtomicLocalArena local_arena_;
   LazyInitializer<ThreadLocalStorage::Slot> tls_;
-  IntrusiveRbTree<size_t, LargeHeader*> large_bin_;
+  LargeHeader* large_list_;
   SpinLock lock_;
   std::atomic_int released_arena_count_;
 };
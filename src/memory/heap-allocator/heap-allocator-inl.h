@@ -38,6 +38,20 @@ bool HeapReferenceCounter<T>::ReleaseReference() YATSC_NO_SE {
   }
   return false;
 }
+
+
+template <typename T>
+void LocalReferenceCounter::DestructAs(void* ptr) {
+  Heap::Destruct(reinterpret_cast<T*>(ptr));
+}
+
+
+template <typename T>
+HeapReferenceCounterBase* LocalReferenceCounter::ShareAs(LocalReferenceCounter* ref_count) {
+  void* ptr = ref_count->ptr_;
+  ref_count->~LocalReferenceCounter();
+  return new (ref_count) HeapReferenceCounter<T>(ptr);
+}
 } // end heap
 
 
@@ -124,7 +138,9 @@ Handle<T>& Handle<T>::operator = (Handle<U>&& hh) {
 
 YATSC_INLINE void* UnsafeZoneAllocator::NewPtr(size_t size) {
   size = YATSC_ALIGN_OFFSET(size, kAlignment);
-  YATSC_CHECK(true, size_ > size);
+  if (size >= size_) {
+    return NewLargePtr(size);
+  }
   if (!zone_->HasEnoughSize(size)) {
     Grow();
   }
@@ -36,4 +36,43 @@ UnsafeZoneAllocator::~UnsafeZoneAllocator() {
     zone = tmp;
   }
 }
+
+
+void UnsafeZoneAllocator::Reset() {
+  Zone* zone = zone_->next();
+  while (zone) {
+    Zone* tmp = zone->next();
+    Heap::Destruct(zone);
+    zone = tmp;
+  }
+  zone_->set_next(nullptr);
+  zone_->Rewind();
+}
+
+
+size_t UnsafeZoneAllocator::reserved_size() const {
+  size_t size = 0;
+  for (Zone* zone = zone_; zone != nullptr; zone = zone->next()) {
+    size += sizeof(Zone) + zone->size();
+  }
+  return size;
+}
+
+
+size_t UnsafeZoneAllocator::used_size() const {
+  size_t size = 0;
+  for (Zone* zone = zone_; zone != nullptr; zone = zone->next()) {
+    size += zone->used();
+  }
+  return size;
+}
+
+
+void* UnsafeZoneAllocator::NewLargePtr(size_t size) {
+  void* ret = Heap::NewPtr(sizeof(Zone) + size);
+  Zone* zone = new (ret) Zone(reinterpret_cast<Byte*>(ret) + sizeof(Zone), size);
+  zone->set_next(zone_->next());
+  zone_->set_next(zone);
+  return zone->GetHeap(size);
+}
 }
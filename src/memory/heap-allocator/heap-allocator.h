@@ -94,9 +94,82 @@ class HeapReference: public HeapReferenceCounter<HeapReference> {
   
   virtual ~HeapReference(){}
 };
+
+
+// Reference counter for yatsc::LocalHandle.
+// The reference count is the plain integer and the counter has no virtual function,
+// so the handles that refer the same counter must not be used from the multiple threads at the same time.
+class LocalReferenceCounter {
+ public:
+  typedef void (*Destructor)(void* ptr);
+  typedef HeapReferenceCounterBase* (*Sharer)(LocalReferenceCounter* ref_count);
+
+  LocalReferenceCounter(void* ptr, Destructor destructor, Sharer sharer)
+      : ptr_(ptr),
+        ref_(1),
+        destructor_(destructor),
+        sharer_(sharer) {}
+
+
+  // Add reference.
+  YATSC_INLINE void AddReference() YATSC_NOEXCEPT {ref_++;}
+
+
+  // Release reference and return true if the object is destructed.
+  YATSC_INLINE bool ReleaseReference() YATSC_NOEXCEPT {
+    if (--ref_ == 0) {
+      destructor_(ptr_);
+      return true;
+    }
+    return false;
+  }
+
+
+  // Replace this counter with the atomic HeapReferenceCounter in the same memory.
+  // Only the last reference can be shared, because the other LocalHandles would still refer this counter.
+  // This is checked in the release build too, since overwriting the living counter corrupts the memory.
+  YATSC_INLINE HeapReferenceCounterBase* Share() YATSC_NOEXCEPT {
+    YATSC_CHECK(true, ref_ == 1);
+    return sharer_(this);
+  }
+
+
+  // Return the size of the memory that has the LocalReferenceCounter or the HeapReferenceCounter<T>.
+  template <typename T>
+  static size_t SlotSize() {
+    return sizeof(LocalReferenceCounter) > sizeof(HeapReferenceCounter<T>)?
+        sizeof(LocalReferenceCounter): sizeof(HeapReferenceCounter<T>);
+  }
+
+
+  template <typename T>
+  static void DestructAs(void* ptr);
+
+
+  template <typename T>
+  static HeapReferenceCounterBase* ShareAs(LocalReferenceCounter* ref_count);
+  
+
+  // Return internal
+  YATSC_INLINE void* Get() YATSC_NOEXCEPT {return ptr_;}
+
+
+  // Return internal
+  YATSC_INLINE const void* Get() YATSC_NO_SE {return ptr_;}
+
+ private:
+  void* ptr_;
+  uint32_t ref_;
+  Destructor destructor_;
+  Sharer sharer_;
+};
 }
 
 
+template <typename T>
+class LocalHandle;
+
+
 // Heap handle that manage object life time by reference count.
 // This class cannot instantiate on heap.
 template <typename T>
@@ -104,6 +177,9 @@ class Handle {
   template <typename Type>
   friend class Handle;
 
+  template <typename Type>
+  friend class LocalHandle;
+
   friend class Heap;
  public:
 
@@ -328,6 +404,154 @@ class WeakHandle: public Handle<T> {
 };
 
 
+// Heap handle for the object that never be used from the multiple threads at the same time,
+// like the objects that are created and released by one worker.
+// The reference count is not atomic and the release needs no virtual dispatch,
+// so the copy and the destruction are cheaper than the Handle.
+// If the object escapes to the other threads, convert the LocalHandle to the Handle by Share().
+template <typename T>
+class LocalHandle {
+  template <typename Type>
+  friend class LocalHandle;
+ public:
+
+  // Create null LocalHandle.
+  LocalHandle()
+      : ref_count_(nullptr) {}
+
+
+  explicit LocalHandle(heap::LocalReferenceCounter* ref_count)
+      : ref_count_(ref_count) {}
+
+
+  ~LocalHandle() {Release();}
+
+
+  // Copy LocalHandle.
+  LocalHandle(const LocalHandle<T>& local_handle)
+      : ref_count_(local_handle.ref_count_) {
+    AddReference();
+  }
+
+
+  // Copy LocalHandle that has derived type of T.
+  template <typename U>
+  LocalHandle(const LocalHandle<U>& local_handle)
+      : ref_count_(local_handle.ref_count_) {
+    static_assert(std::is_convertible<U*, T*>::value, "LocalHandle<T> must be given LocalHandle<U> that U is derived type of T.");
+    AddReference();
+  }
+
+
+  // Move LocalHandle.
+  LocalHandle(LocalHandle<T>&& local_handle)
+      : ref_count_(local_handle.ref_count_) {
+    local_handle.ref_count_ = nullptr;
+  }
+
+
+  // Move LocalHandle that has derived type of T.
+  template <typename U>
+  LocalHandle(LocalHandle<U>&& local_handle)
+      : ref_count_(local_handle.ref_count_) {
+    static_assert(std::is_convertible<U*, T*>::value, "LocalHandle<T> must be given LocalHandle<U> that U is derived type of T.");
+    local_handle.ref_count_ = nullptr;
+  }
+
+
+  // Copy LocalHandle.
+  LocalHandle<T>& operator = (const LocalHandle<T>& local_handle) {
+    LocalHandle<T>(local_handle).Swap(*this);
+    return *this;
+  }
+
+
+  // Move LocalHandle.
+  LocalHandle<T>& operator = (LocalHandle<T>&& local_handle) {
+    LocalHandle<T>(std::move(local_handle)).Swap(*this);
+    return *this;
+  }
+
+
+  YATSC_INLINE void Swap(LocalHandle<T>& local_handle) YATSC_NOEXCEPT {
+    std::swap(ref_count_, local_handle.ref_count_);
+  }
+
+
+  // Equality comparator of LocalHandle<T>.
+  YATSC_INLINE bool operator == (const LocalHandle<T>& local_handle) YATSC_NO_SE {
+    return local_handle.ref_count_ == ref_count_;
+  }
+
+
+  // Cast to bool.
+  YATSC_INLINE operator bool() YATSC_NO_SE {return ref_count_ != nullptr;}
+
+
+  YATSC_INLINE T* Get() YATSC_NOEXCEPT {return reinterpret_cast<T*>(ref_count_->Get());}
+
+
+  YATSC_INLINE const T* Get() YATSC_NO_SE {return reinterpret_cast<const T*>(ref_count_->Get());}
+
+
+  // Access to the internal pointer.
+  YATSC_INLINE T* operator ->() YATSC_NOEXCEPT {
+    ASSERT(true, ref_count_ != nullptr);
+    return Get();
+  }
+
+
+  // Access to the internal pointer.
+  YATSC_INLINE const T* operator ->() YATSC_NO_SE {
+    ASSERT(true, ref_count_ != nullptr);
+    return Get();
+  }
+
+
+  // Get reference type of the T.
+  YATSC_INLINE T& operator *() YATSC_NOEXCEPT {
+    ASSERT(true, ref_count_ != nullptr);
+    return *Get();
+  }
+
+
+  // Get reference type of the T.
+  YATSC_INLINE const T& operator *() YATSC_NO_SE {
+    ASSERT(true, ref_count_ != nullptr);
+    return *Get();
+  }
+
+
+  // Convert this LocalHandle to the Handle that can be used from the multiple threads.
+  // This LocalHandle must be the last reference of the object and becomes null after the conversion.
+  Handle<T> Share() {
+    ASSERT(true, ref_count_ != nullptr);
+    Handle<T> handle;
+    handle.ref_count_ = ref_count_->Share();
+    ref_count_ = nullptr;
+    return handle;
+  }
+
+ private:
+  YATSC_INLINE void AddReference() YATSC_NOEXCEPT {
+    if (ref_count_ != nullptr) {
+      ref_count_->AddReference();
+    }
+  }
+
+
+  YATSC_INLINE void Release() YATSC_NOEXCEPT {
+    if (ref_count_ != nullptr) {
+      ref_count_->ReleaseReference();
+      ref_count_ = nullptr;
+    }
+  }
+
+  
+  heap::LocalReferenceCounter* ref_count_;
+};
+
+
 // Main allocator of the heap.
 class Heap: private Static {
  public:
@@ -358,6 +582,23 @@ class Heap: private Static {
   }
 
 
+  // Allocate from heap that has combined size of
+  // size of T and size of the slot of the reference counter,
+  // and instantiate T and return LocalHandle<T>.
+  // The slot can have the HeapReferenceCounter<T>, so the LocalHandle<T> is shared without the reallocation.
+  template <typename T, typename ... Args>
+  static LocalHandle<T> NewLocalHandle(Args ... args) {
+    static_assert(std::is_constructible<T, Args...>::value, "Heap::NewLocalHandle must be given constructible type.");
+    static_assert(std::is_destructible<T>::value, "Heap::NewLocalHandle must be given destructible type.");
+    void* ptr = NewPtr(sizeof(T) + heap::LocalReferenceCounter::SlotSize<T>());
+    auto ref_count = new (reinterpret_cast<Byte*>(ptr) + sizeof(T)) heap::LocalReferenceCounter(
+        new (ptr) T(args...),
+        &heap::LocalReferenceCounter::DestructAs<T>,
+        &heap::LocalReferenceCounter::ShareAs<T>);
+    return LocalHandle<T>(ref_count);
+  }
+
+
   template <typename T, typename ... Args>
   static Handle<T> NewWeakHandle(Args ... args) {
     static_assert(std::is_constructible<T, Args...>::value, "Heap::NewWeakHandle must be given constructible type.");
@@ -424,6 +665,20 @@ class UnsafeZoneAllocator {
   YATSC_INLINE T* New(Args ... args);
 
 
+  // Release all zones except the newest one and rewind it,
+  // so the memory is reused by the following allocations.
+  // The destructors of the allocated objects are not called.
+  void Reset();
+
+
+  // The bytes of the zones that are obtained from the Heap.
+  size_t reserved_size() const;
+
+
+  // The bytes that are allocated from the zones.
+  size_t used_size() const;
+
+
  private:
   class Zone {
    public:
@@ -442,6 +697,9 @@ class UnsafeZoneAllocator {
     YATSC_CONST_GETTER(size_t, size, size_)
 
 
+    YATSC_CONST_GETTER(size_t, used, used_)
+
+
     YATSC_PROPERTY(Zone*, next, next_)
 
 
@@ -456,6 +714,9 @@ class UnsafeZoneAllocator {
       return ret;
     }
 
+
+    YATSC_INLINE void Rewind() {used_ = 0;}
+
    private:
     Byte* heap_;
     size_t size_;
@@ -465,6 +726,12 @@ class UnsafeZoneAllocator {
 
   
   void Grow();
+
+
+  // Allocate the zone that is used only by the specified size.
+  // The zone is linked after the current zone,
+  // so the rest of the current zone is still used by the following allocations.
+  void* NewLargePtr(size_t size);
   
 
   size_t size_;
@@ -26,8 +26,13 @@ namespace yatsc {
 template <typename UCharInputIterator>
 ParseResult Parser<UCharInputIterator>::ParseDeclarationModule() {
   LOG_PHASE(ParseDeclarationModule);
-  auto ret = New<ir::FileScopeView>(current_scope());
-  ret->SetInformationForNode(cur_token());
+  // The ir is discarded after each statement while the syntax check,
+  // so the file scope is created after all statements are parsed.
+  ir::FileScopeView* ret = nullptr;
+  if (!compiler_option_.syntax_check_only()) {
+    ret = New<ir::FileScopeView>(current_scope());
+    ret->SetInformationForNode(cur_token());
+  }
 
   bool success = true;
   
@@ -41,7 +46,7 @@ ParseResult Parser<UCharInputIterator>::ParseDeclarationModule() {
         Next();
         auto assignment_expr_result = ParseAssignmentExpression();
         SKIP_TOKEN_OR(assignment_expr_result, success, TokenKind::kLineTerminator) {
-          ret->InsertLast(CreateExportView(assignment_expr_result.value(), ir::Node::Null(), &info, true));
+          AddFileScopeStatement(ret, CreateExportView(assignment_expr_result.value(), ir::Node::Null(), &info, true));
         }
         continue;
       } else {
@@ -74,9 +79,13 @@ ParseResult Parser<UCharInputIterator>::ParseDeclarationModule() {
         parse_result = Success(export_view);
       }
 
-      ret->InsertLast(parse_result.value());
+      AddFileScopeStatement(ret, parse_result.value());
     }
   }
+
+  if (ret == nullptr) {
+    ret = New<ir::FileScopeView>(current_scope());
+  }
   return Success(ret);
 }
 
@@ -84,7 +93,7 @@ template <typename UCharInputInterator>
 ParseResult Parser<UCharInputInterator>::ParseAmbientDeclaration(bool module_allowed) {
   LOG_PHASE(ParseAmbientDeclaration);
   if (cur_token()->type() == TokenKind::kIdentifier &&
-      cur_token()->value()->Equals("declare")) {
+      cur_token()->value()->Is(Atom::kDeclare)) {
     Token info = *cur_token();
     Next();
     switch (cur_token()->type()) {
@@ -98,7 +107,7 @@ ParseResult Parser<UCharInputInterator>::ParseAmbientDeclaration(bool module_all
         return ParseAmbientEnumDeclaration(&info);
       default:
         if (cur_token()->type() == TokenKind::kIdentifier &&
-            cur_token()->value()->Equals("module")) {
+            cur_token()->value()->Is(Atom::kModule)) {
           if (!module_allowed) {
             SYNTAX_ERROR_AND_SKIP_NEXT("ambient module declaration not allowed here.", cur_token(), TokenKind::kRightBrace);
           }
@@ -267,10 +276,10 @@ ParseResult Parser<UCharInputInterator>::ParseAmbientClassElement() {
   }
   
   if (cur_token()->type() == TokenKind::kIdentifier) {
-    if (cur_token()->value()->Equals("constructor")) {
+    if (cur_token()->value()->Is(Atom::kConstructor)) {
       return ParseAmbientConstructor(field_modifiers_result.or(Null()));
     } else {
-      RecordedParserState rps = parser_state();
+      Checkpoint rps = parser_state();
       Next();
       if (cur_token()->type() == TokenKind::kLeftParen ||
           cur_token()->type() == TokenKind::kLess) {
@@ -294,13 +303,13 @@ ParseResult Parser<UCharInputIterator>::ParseAmbientConstructor(ir::Node* mods)
   LOG_PHASE(ParseAmbientConstructor);
   
   if ((cur_token()->type() == TokenKind::kIdentifier &&
-       cur_token()->value()->Equals("constructor")) ||
+       cur_token()->value()->Is(Atom::kConstructor)) ||
       cur_token()->type() == TokenKind::kPublic ||
       cur_token()->type() == TokenKind::kPrivate ||
       cur_token()->type() == TokenKind::kProtected) {
     
     if (cur_token()->type() == TokenKind::kIdentifier &&
-        cur_token()->value()->Equals("constructor")) {
+        cur_token()->value()->Is(Atom::kConstructor)) {
       Token info = *cur_token();
       Next();
       auto call_sig_result = ParseCallSignature(true, false, false);
@@ -488,7 +497,7 @@ ParseResult Parser<UCharInputIterator>::ParseAmbientModuleDeclaration(Token* inf
   LOG_PHASE(ParseAmbientModuleDeclaration);
 
   if (cur_token()->type() == TokenKind::kIdentifier &&
-      cur_token()->value()->Equals("module")) {
+      cur_token()->value()->Is(Atom::kModule)) {
     Next();
 
     ParseResult identifier_result;
@@ -618,7 +627,7 @@ ParseResult Parser<UCharInputIterator>::ParseAmbientModuleElement(bool external)
       break;
     default:
       if (cur_token()->type() == TokenKind::kIdentifier &&
-          cur_token()->value()->Equals("module")) {
+          cur_token()->value()->Is(Atom::kModule)) {
         parse_result = ParseAmbientModuleDeclaration(&info);
       } else {
         SYNTAX_ERROR("unexpected token.", cur_token());
@@ -0,0 +1,149 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2013 Taketoshi Aono(brn)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef PARSER_ATOMS_H
+#define PARSER_ATOMS_H
+
+#include "../utils/utils.h"
+
+namespace yatsc {
+
+// The well-known names that every LiteralBuffer is seeded with.
+// The id of the Literal of the atom is the fixed value of the Atom,
+// so the comparison against the well-known name is the integer compare
+// and does not depend on the LiteralBuffer that the Literal belongs to.
+#define ATOM_LIST(ATOM)                         \
+  ATOM(kBreak, "break")                         \
+  ATOM(kCase, "case")                           \
+  ATOM(kCatch, "catch")                         \
+  ATOM(kClass, "class")                         \
+  ATOM(kConst, "const")                         \
+  ATOM(kContinue, "continue")                   \
+  ATOM(kDebugger, "debugger")                   \
+  ATOM(kDefault, "default")                     \
+  ATOM(kDelete, "delete")                       \
+  ATOM(kDo, "do")                               \
+  ATOM(kElse, "else")                           \
+  ATOM(kEnum, "enum")                           \
+  ATOM(kExport, "export")                       \
+  ATOM(kExtends, "extends")                     \
+  ATOM(kFalse, "false")                         \
+  ATOM(kFinally, "finally")                     \
+  ATOM(kFor, "for")                             \
+  ATOM(kFunction, "function")                   \
+  ATOM(kIf, "if")                               \
+  ATOM(kImplements, "implements")               \
+  ATOM(kImport, "import")                       \
+  ATOM(kIn, "in")                               \
+  ATOM(kInstanceof, "instanceof")               \
+  ATOM(kInterface, "interface")                 \
+  ATOM(kLet, "let")                             \
+  ATOM(kNew, "new")                             \
+  ATOM(kNull, "null")                           \
+  ATOM(kNan, "NaN")                             \
+  ATOM(kPackage, "package")                     \
+  ATOM(kPrivate, "private")                     \
+  ATOM(kProtected, "protected")                 \
+  ATOM(kPublic, "public")                       \
+  ATOM(kReturn, "return")                       \
+  ATOM(kStatic, "static")                       \
+  ATOM(kSuper, "super")                         \
+  ATOM(kSwitch, "switch")                       \
+  ATOM(kThis, "this")                           \
+  ATOM(kThrow, "throw")                         \
+  ATOM(kTrue, "true")                           \
+  ATOM(kTry, "try")                             \
+  ATOM(kTypeof, "typeof")                       \
+  ATOM(kUndefined, "undefined")                 \
+  ATOM(kVar, "var")                             \
+  ATOM(kVoid, "void")                           \
+  ATOM(kWhile, "while")                         \
+  ATOM(kWith, "with")                           \
+  ATOM(kAny, "any")                             \
+  ATOM(kArguments, "arguments")                 \
+  ATOM(kAs, "as")                               \
+  ATOM(kBoolean, "boolean")                     \
+  ATOM(kConstructor, "constructor")             \
+  ATOM(kDeclare, "declare")                     \
+  ATOM(kFrom, "from")                           \
+  ATOM(kGet, "get")                             \
+  ATOM(kLength, "length")                       \
+  ATOM(kModule, "module")                       \
+  ATOM(kNumber, "number")                       \
+  ATOM(kOf, "of")                               \
+  ATOM(kPrototype, "prototype")                 \
+  ATOM(kRequire, "require")                     \
+  ATOM(kSet, "set")                             \
+  ATOM(kString, "string")                       \
+  ATOM(kSymbol, "symbol")                       \
+  ATOM(kType, "type")                           \
+  ATOM(kYield, "yield")
+
+
+enum class Atom: uint8_t {
+#define DECLARE_ATOM(name, value) name,
+  ATOM_LIST(DECLARE_ATOM)
+#undef DECLARE_ATOM
+  kNone
+};
+
+
+static const size_t kAtomCount = static_cast<size_t>(Atom::kNone);
+
+
+static_assert(kAtomCount <= Unique::kReservedIdCount, "The count of the atoms must be less than Unique::kReservedIdCount.");
+
+
+namespace atoms {
+// FNV-1a hash of the ascii string,
+// this must be the same as LiteralBuffer::Hash of the utf-16 sequence.
+constexpr uint32_t Hash(const char* value, uint32_t hash = 2166136261u) {
+  return *value == '\0'? hash: Hash(value + 1, (hash ^ static_cast<uint32_t>(static_cast<unsigned char>(*value))) * 16777619u);
+}
+
+
+struct AtomEntry {
+  const char* value;
+  size_t length;
+  uint32_t hash;
+};
+
+
+// The static table of the atoms which is built at the compile time.
+constexpr AtomEntry kAtomTable[] = {
+#define DECLARE_ATOM_ENTRY(name, value) {value, sizeof(value) - 1, Hash(value)},
+  ATOM_LIST(DECLARE_ATOM_ENTRY)
+#undef DECLARE_ATOM_ENTRY
+};
+
+static_assert(sizeof(kAtomTable) / sizeof(AtomEntry) == kAtomCount, "The atom table is broken.");
+static_assert(Hash("") == 2166136261u, "The atom hash is broken.");
+}
+
+
+// Return the fixed id of the atom.
+YATSC_INLINE Unique::Id AtomId(Atom atom) YATSC_NOEXCEPT {
+  return static_cast<Unique::Id>(atom);
+}
+}
+
+#endif
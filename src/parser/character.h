@@ -125,6 +125,11 @@ class Character : private Static {
   }
 
 
+  YATSC_INLINE static bool IsOctalCharacter(const UChar& uchar) {
+    return uchar >= unicode::u32('0') && uchar <= unicode::u32('7');
+  }
+
+
   YATSC_INLINE static bool IsSingleLineCommentStart(const UChar& uchar, const UChar& lookahead) {
     return uchar == unicode::u32('/') && lookahead == unicode::u32('/');
   }
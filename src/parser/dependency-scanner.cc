@@ -0,0 +1,118 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2013 Taketoshi Aono(brn)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#include "./dependency-scanner.h"
+#include "../utils/path.h"
+
+namespace yatsc {
+
+Vector<String> DependencyScanner::Scan() const {
+  Vector<String> module_names;
+  String dir = Path::Dirname(module_info_->module_name());
+  auto reference = token_array_->references().begin();
+  auto references_end = token_array_->references().end();
+
+  for (size_t i = 0; i < token_array_->size(); i++) {
+    for (; reference != references_end && reference->index() <= i; ++reference) {
+      module_names.push_back(Path::Join(dir, reference->path()->utf8_value()));
+    }
+    
+    size_t specifier;
+    if (MatchFromClause(i, &specifier) || MatchExternalModuleReference(i, &specifier)) {
+      // Same as the parser, only the relative paths are the modules.
+      const char* path = token_array_->token(specifier).utf8_value();
+      if (path[0] == '.') {
+        module_names.push_back(Path::Join(dir, path));
+      }
+      i = specifier;
+    }
+  }
+  return module_names;
+}
+
+
+bool DependencyScanner::MatchFromClause(size_t index, size_t* specifier) const {
+  const Token& token = token_array_->token(index);
+  if (!token.Is(TokenKind::kImport) && !token.Is(TokenKind::kExport)) {
+    return false;
+  }
+
+  size_t size = token_array_->size();
+  if (token.Is(TokenKind::kImport) && index + 1 < size &&
+      token_array_->token(index + 1).Is(TokenKind::kStringLiteral)) {
+    *specifier = index + 1;
+    return true;
+  }
+
+  // The import clause or the export clause consists of the names and the braces only.
+  for (size_t i = index + 1; i + 1 < size; i++) {
+    if (IsIdentifier(i, Atom::kFrom) && token_array_->token(i + 1).Is(TokenKind::kStringLiteral)) {
+      *specifier = i + 1;
+      return true;
+    }
+    
+    switch (token_array_->token(i).type()) {
+      case TokenKind::kIdentifier:
+      case TokenKind::kDefault:
+      case TokenKind::kLeftBrace:
+      case TokenKind::kRightBrace:
+      case TokenKind::kComma:
+      case TokenKind::kMul:
+        break;
+      default:
+        return false;
+    }
+  }
+  return false;
+}
+
+
+bool DependencyScanner::MatchExternalModuleReference(size_t index, size_t* specifier) const {
+  if (index + 6 >= token_array_->size()) {
+    return false;
+  }
+  
+  auto is = [&](size_t offset, TokenKind kind) {
+    return token_array_->token(index + offset).Is(kind);
+  };
+  
+  if (is(0, TokenKind::kImport) &&
+      is(1, TokenKind::kIdentifier) &&
+      is(2, TokenKind::kAssign) &&
+      (IsIdentifier(index + 3, Atom::kRequire) || IsIdentifier(index + 3, Atom::kModule)) &&
+      is(4, TokenKind::kLeftParen) &&
+      is(5, TokenKind::kStringLiteral) &&
+      is(6, TokenKind::kRightParen)) {
+    *specifier = index + 5;
+    return true;
+  }
+  return false;
+}
+
+
+bool DependencyScanner::IsIdentifier(size_t index, Atom atom) const {
+  const Token& token = token_array_->token(index);
+  return token.Is(TokenKind::kIdentifier) && token.value()->Is(atom);
+}
+
+} // namespace yatsc
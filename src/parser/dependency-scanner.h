@@ -0,0 +1,79 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2013 Taketoshi Aono(brn)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+
+#ifndef PARSER_DEPENDENCY_SCANNER_H_
+#define PARSER_DEPENDENCY_SCANNER_H_
+
+#include "./parallel-scanner.h"
+#include "./token-array.h"
+#include "../compiler/module-info.h"
+#include "../memory/heap.h"
+#include "../utils/stl.h"
+#include "../utils/utils.h"
+
+
+namespace yatsc {
+
+// Find the modules which the module depends on from the tokens, without parsing.
+// The found modules are
+//   import ... from './module'
+//   import './module'
+//   export ... from './module'
+//   import a = require('./module')
+//   /// <reference path="module.ts" />
+// so the compiler can schedule the dependencies before the module is parsed.
+class DependencyScanner : private Uncopyable, private Unmovable {
+ public:
+  typedef ParallelScanner::SourceTokenArray SourceTokenArray;
+
+  DependencyScanner(Handle<ModuleInfo> module_info, Handle<SourceTokenArray> token_array)
+      : module_info_(module_info),
+        token_array_(token_array) {}
+
+
+  // Return the paths of the modules in the order of the appearance.
+  Vector<String> Scan() const;
+
+ private:
+  // Match the import or the export declaration that begins at the index,
+  // and return the index of the module specifier string.
+  bool MatchFromClause(size_t index, size_t* specifier) const;
+
+
+  // Match the import a = require(...) that begins at the index,
+  // and return the index of the module specifier string.
+  bool MatchExternalModuleReference(size_t index, size_t* specifier) const;
+
+
+  // Return true if the token of the index is the identifier of the atom.
+  bool IsIdentifier(size_t index, Atom atom) const;
+
+
+  Handle<ModuleInfo> module_info_;
+  Handle<SourceTokenArray> token_array_;
+};
+
+} // namespace yatsc
+
+#endif // PARSER_DEPENDENCY_SCANNER_H_
@@ -20,6 +20,7 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 // THE SOFTWARE.
 
+#include <algorithm>
 #include "./error-formatter.h"
 #include "./error-descriptor.h"
 #include "./sourceposition.h"
@@ -30,12 +31,13 @@ namespace yatsc {
 String ErrorFormatter::Format(const ErrorDescriptor& error_descriptor) const {
   static const size_t kMaxWidth = 120;
   const SourcePosition source_position = error_descriptor.source_position();
+  Handle<SourceStream> source_stream = module_info_->source_stream();
+  size_t start_line_number = source_stream->GetLineNumber(source_position.start_offset());
   
-  Vector<String> line_source_list = GetLineSource(source_position);
+  Vector<String> line_source_list = GetLineSource(start_line_number);
   String line_source;
   StringStream line;
-  size_t start_line_number = source_position.start_line_number();
-  line << source_position.start_line_number() << ": ";
+  line << start_line_number << ": ";
   StringStream padding;
   StringStream message;
 
@@ -45,11 +47,17 @@ String ErrorFormatter::Format(const ErrorDescriptor& error_descriptor) const {
     padding << ' ';
   }
   
-  message << '\n' << module_info_->module_name() << ':' << source_position.start_line_number() <<
-    ':' << source_position.start_col() << '-' << source_position.end_col() << '\n';
+  size_t start_col = source_stream->GetColumn(source_position.start_offset());
+  size_t end_col = start_col + source_position.length();
+  size_t next_line_start = source_stream->GetLineStart(start_line_number + 1);
+  if (source_position.end_offset() > next_line_start) {
+    // Only the first line of the multi line token is marked.
+    end_col = start_col + (next_line_start - source_position.start_offset());
+  }
+  
+  message << '\n' << module_info_->module_name() << ':' << start_line_number <<
+    ':' << start_col << '-' << end_col << '\n';
 
-  size_t start_col = source_position.start_col();
-  size_t end_col = source_position.end_col();
   size_t threshold = start_col - 1;
   size_t end = end_col > start_col? end_col - 1: end_col;
   size_t start = 0;
@@ -61,7 +69,7 @@ String ErrorFormatter::Format(const ErrorDescriptor& error_descriptor) const {
       line_source = std::move(line_source_list[0]);
       last_line = 1;
     } else {
-      message << '\n' << (source_position.start_line_number() - 1) << ": " << line_source_list[0];
+      message << '\n' << (start_line_number - 1) << ": " << line_source_list[0];
       line_source = std::move(line_source_list[1]);
     }
     last_line_num = 1;
@@ -71,7 +79,7 @@ String ErrorFormatter::Format(const ErrorDescriptor& error_descriptor) const {
       last_line = 1;
       last_line_num = 1;
     } else {
-      message << '\n' << (source_position.start_line_number() - 1) << ": " << line_source_list[0];
+      message << '\n' << (start_line_number - 1) << ": " << line_source_list[0];
       line_source = std::move(line_source_list[1]);
       last_line = 0;
     }
@@ -84,7 +92,7 @@ String ErrorFormatter::Format(const ErrorDescriptor& error_descriptor) const {
   }
   
   if (line_source.size() > kMaxWidth) {
-    message << '\n' << source_position.start_line_number() << ": "
+    message << '\n' << start_line_number << ": "
         << line_source.substr(0 * kMaxWidth, kMaxWidth) << '\n' << padding.str();
     size_t wrap = 1;
     size_t count = 0;
@@ -108,7 +116,7 @@ String ErrorFormatter::Format(const ErrorDescriptor& error_descriptor) const {
       message << '\n' << line_source.substr(last);
     }
   } else {
-    message << '\n' << source_position.start_line_number() << ": " << line_source << '\n' << padding.str();
+    message << '\n' << start_line_number << ": " << line_source << '\n' << padding.str();
     for (size_t i = start; i < end; i++) {
       if (i >= threshold) {
         message << '^';
@@ -119,7 +127,7 @@ String ErrorFormatter::Format(const ErrorDescriptor& error_descriptor) const {
   }
 
   if (last_line != 0) {
-    message << '\n' << (source_position.start_line_number() + last_line_num) << ": " << line_source_list[last_line];
+    message << '\n' << (start_line_number + last_line_num) << ": " << line_source_list[last_line];
   }
   message << '\n';
   return std::move(message.str());
@@ -135,44 +143,31 @@ void Replace(String& str, const String& from, const String& to) {
 }
 
 
-Vector<String> ErrorFormatter::GetLineSource(const SourcePosition& source_position) const {
+Vector<String> ErrorFormatter::GetLineSource(size_t line_number) const {
   static const String kTab = "\t";
   static const String kSpace = "  ";
-  size_t count = 0;
-  String::size_type start = 0;
   Vector<String> line_source;
-  String raw_source_code(module_info_->raw_source_code());
-  int next = 2;
-  
-  while (1) {
-    next = 2;
-    String::size_type end = raw_source_code.find("\r\n", start);
-    if (String::npos == end) {
-      end = raw_source_code.find('\n', start);
-      next = 1;
-    }
-    
-    count++;
+  Handle<SourceStream> source_stream = module_info_->source_stream();
+  const char* raw_source_code = source_stream->raw_buffer();
+  size_t first = line_number > 1? line_number - 1: 1;
+  size_t last = std::min(line_number + 1, source_stream->line_count());
+
+  // Collect the previous line, the line and the next line.
+  for (size_t i = first; i <= last; i++) {
+    size_t start = source_stream->GetLineStart(i);
+    size_t end = source_stream->GetLineStart(i + 1);
     
-    if (String::npos == end && count == 1) {
-      line_source.push_back(raw_source_code);
-      return std::move(line_source);
+    // Remove the line break.
+    if (end > start && raw_source_code[end - 1] == '\n') {
+      end--;
     }
-
-    if (source_position.start_line_number() >= count - 1 &&
-        source_position.start_line_number() <= count + 1) {
-      String line = std::move(raw_source_code.substr(start, end - start));
-      Replace(line, kTab, kSpace);
-      line_source.push_back(line);
-    } else if (source_position.start_line_number() + 2 == count) {
-      break;
+    if (end > start && raw_source_code[end - 1] == '\r') {
+      end--;
     }
-
-    if (String::npos == end) {
-      break;
-    }
-      
-    start = end + next;
+    
+    String line(raw_source_code + start, end - start);
+    Replace(line, kTab, kSpace);
+    line_source.push_back(std::move(line));
   }
   return std::move(line_source);
 }
@@ -40,7 +40,7 @@ class ErrorFormatter {
       : module_info_(module_info) {}
 
   
-  String Format(Handle<ErrorDescriptor> error_descriptor) const {
+  String Format(const LocalHandle<ErrorDescriptor>& error_descriptor) const {
     return Format(*error_descriptor);
   }
 
@@ -48,7 +48,7 @@ class ErrorFormatter {
   String Format(const ErrorDescriptor&) const;
 
 
-  void Print(FILE* fp, Handle<ErrorDescriptor> error_descriptor) const {Print(fp, *error_descriptor);}
+  void Print(FILE* fp, const LocalHandle<ErrorDescriptor>& error_descriptor) const {Print(fp, *error_descriptor);}
 
 
   void Print(FILE* fp, const ErrorDescriptor& error_descriptor) const {
@@ -68,7 +68,7 @@ class ErrorFormatter {
   }
 
  private:
-  Vector<String> GetLineSource(const SourcePosition& source_position) const;
+  Vector<String> GetLineSource(size_t line_number) const;
   
   Handle<ModuleInfo> module_info_;
 
@@ -33,9 +33,11 @@
 
 namespace yatsc {
 
+// The error descriptors are created and read by the worker that owns the module,
+// so they are held by the LocalHandle.
 class ErrorReporter {
  public:
-  typedef Vector<Handle<ErrorDescriptor>> ErrorBuffer;
+  typedef Vector<LocalHandle<ErrorDescriptor>> ErrorBuffer;
   typedef ErrorBuffer WarningBuffer;
 
   
@@ -79,14 +81,14 @@ class ErrorReporter {
   }
 
 
-  ErrorDescriptor& SyntaxError(Handle<ErrorDescriptor> errd) {
+  ErrorDescriptor& SyntaxError(LocalHandle<ErrorDescriptor> errd) {
     buffer_.push_back(errd);
     return (*errd) << "SyntaxError ";
   }
   
 
   ErrorDescriptor& SyntaxError(const SourcePosition& source_position) {
-    return SyntaxError(Heap::NewHandle<ErrorDescriptor>(source_position));
+    return SyntaxError(Heap::NewLocalHandle<ErrorDescriptor>(source_position));
   }
 
 
@@ -105,14 +107,14 @@ class ErrorReporter {
   }
 
 
-  ErrorDescriptor& Warning(Handle<ErrorDescriptor> errd) {
+  ErrorDescriptor& Warning(LocalHandle<ErrorDescriptor> errd) {
     warning_buffer_.push_back(errd);
     return (*errd) << "Warning ";
   }
   
 
   ErrorDescriptor& Warning(const SourcePosition& source_position) {
-    return Warning(Heap::NewHandle<ErrorDescriptor>(source_position));
+    return Warning(Heap::NewLocalHandle<ErrorDescriptor>(source_position));
   }
 
 
@@ -131,14 +133,14 @@ class ErrorReporter {
   }
 
 
-  ErrorDescriptor& SemanticError(Handle<ErrorDescriptor> errd) {
+  ErrorDescriptor& SemanticError(LocalHandle<ErrorDescriptor> errd) {
     buffer_.push_back(errd);
     return (*errd) << "SemanticError ";
   }
 
 
   ErrorDescriptor& SemanticError(const SourcePosition& source_position) {
-    return SemanticError(Heap::NewHandle<ErrorDescriptor>(source_position));
+    return SemanticError(Heap::NewLocalHandle<ErrorDescriptor>(source_position));
   }
 
 
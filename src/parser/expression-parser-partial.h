@@ -43,7 +43,8 @@ ParseResult Parser<UCharInputIterator>::ParseExpression() {
 
   // Parse comma expressions.
   Next();
-  ir::CommaExprView* comma_expr = New<ir::CommaExprView>({assignment_expr});
+  ir::CommaExprView* comma_expr = New<ir::CommaExprView>();
+  comma_expr->InsertLast(assignment_expr);
   comma_expr->SetInformationForNode(*cur_token());
   
   while (1) {
@@ -261,7 +262,7 @@ ParseResult Parser<UCharInputIterator>::ParseAssignmentProperty() {
   bool identifier = false;
   
   if (cur_token()->Is(TokenKind::kIdentifier)) {
-    if (cur_token()->value()->Equals("yield") && state_.IsInGenerator()) {
+    if (cur_token()->value()->Is(Atom::kYield) && state_.IsInGenerator()) {
       ReportParseError(cur_token(), YATSC_SOURCEINFO_ARGS)
         << "'yield' not allowed here.";
       cur_token()->set_type(TokenKind::kIdentifier);
@@ -346,7 +347,7 @@ ParseResult Parser<UCharInputIterator>::ParseDestructuringAssignmentTarget() {
   DisableErrorRecovery();
   YATSC_SCOPED([&]{EnableErrorRecovery();});
   
-  RecordedParserState rps = parser_state();
+  Checkpoint rps = parser_state();
   
   return TryParse([&]{return ParseLeftHandSideExpression();}) >>= [&](ir::Node* lhs) {  
     // Check whether DestructuringAssignmentTarget is IsValidAssignmentTarget or not.
@@ -367,7 +368,7 @@ ParseResult Parser<UCharInputIterator>::ParseDestructuringAssignmentTarget() {
 
 
 // Return true if token type is assignment operator.
-bool IsAssignmentOp(TokenKind type) {
+inline bool IsAssignmentOp(TokenKind type) {
   return type == TokenKind::kAssign || type == TokenKind::kMulLet ||
     type == TokenKind::kDivLet || type == TokenKind::kModLet ||
     type == TokenKind::kAddLet || type == TokenKind::kSubLet ||
@@ -427,7 +428,7 @@ ParseResult Parser<UCharInputIterator>::ParseCoveredTypeExpression() {
 
 
 template <typename UCharInputIterator>
-ParseResult Parser<UCharInputIterator>::ParseCoveredExpressionSuffix(bool invalid_arrow_param, bool has_types, ir::Node* type_arguments, const ir::Node::List& covered_expr_node_list) {
+ParseResult Parser<UCharInputIterator>::ParseCoveredExpressionSuffix(bool invalid_arrow_param, bool has_types, ir::Node* type_arguments, const Vector<ir::Node*>& covered_expr_node_list) {
   switch (cur_token()->type()) {      
     case TokenKind::kArrowGlyph: {
       Next();
@@ -513,7 +514,7 @@ ParseResult Parser<UCharInputIterator>::ParseCoveredExpression() {
     type_arguments = New<ir::TypeArgumentsView>();
   }
 
-  ir::Node::List covered_expr_node_list;
+  Vector<ir::Node*> covered_expr_node_list;
   bool invalid_arrow_param = false;
   
   if (cur_token()->Is(TokenKind::kLeftParen)) {
@@ -590,7 +591,7 @@ ParseResult Parser<UCharInputIterator>::ParseCoveredExpression() {
 
 
 template <typename UCharInputIterator>
-ParseResult Parser<UCharInputIterator>::ParseAsArrowFunction(ir::Node* type_list, const ir::Node::List& node_list, ir::Node* ret_type) {
+ParseResult Parser<UCharInputIterator>::ParseAsArrowFunction(ir::Node* type_list, const Vector<ir::Node*>& node_list, ir::Node* ret_type) {
   LOG_PHASE(ParseAsArrowFunction);
 
   auto params = New<ir::TypeParametersView>();
@@ -652,7 +653,7 @@ ParseResult Parser<UCharInputIterator>::ParseAsArrowFunction(ir::Node* type_list
 
 
 template <typename UCharInputIterator>
-ParseResult Parser<UCharInputIterator>::ParseAsTypeAssertion(ir::Node* type_list, const ir::Node::List& node_list) {
+ParseResult Parser<UCharInputIterator>::ParseAsTypeAssertion(ir::Node* type_list, const Vector<ir::Node*>& node_list) {
   LOG_PHASE(ParseAsTypeAssertion);
 
   for (auto x: type_list->node_list()) {
@@ -715,7 +716,7 @@ ParseResult Parser<UCharInputIterator>::ParseAsTypeAssertion(ir::Node* type_list
 
 
 template <typename UCharInputIterator>
-ParseResult Parser<UCharInputIterator>::ParseAsExpression(const ir::Node::List& node_list) {
+ParseResult Parser<UCharInputIterator>::ParseAsExpression(const Vector<ir::Node*>& node_list) {
   LOG_PHASE(ParseAsExpression);
   if (node_list.size() > 1) {
     auto node = New<ir::CommaExprView>();
@@ -752,14 +753,23 @@ ParseResult Parser<UCharInputIterator>::ParseAsExpression(const ir::Node::List&
 //   ArrowFunction[?In, ?Yield]
 //   LeftHandSideExpression[?Yield] = AssignmentExpression[?In,?Yield]
 //   LeftHandSideExpression[?Yield] AssignmentOperator AssignmentExpression[?In, ?Yield]
-//  
+//
+// The assignment expression is parsed again after the failed speculative parse,
+// like the object literal which is turned to the assignment pattern,
+// so the result is memoized.
 template <typename UCharInputIterator>
 ParseResult Parser<UCharInputIterator>::ParseAssignmentExpression() {
+  return Memoize(MemoRule::kAssignmentExpression, [&]{return ParseUnmemoizedAssignmentExpression();});
+}
+
+
+template <typename UCharInputIterator>
+ParseResult Parser<UCharInputIterator>::ParseUnmemoizedAssignmentExpression() {
   LOG_PHASE(ParseAssignmentExpression);
   ParseResult node;
 
   // Record current buffer position.
-  RecordedParserState rps = parser_state();
+  Checkpoint rps = parser_state();
   
   if (cur_token()->OneOf({TokenKind::kLeftParen, TokenKind::kLess})) {
     // DisableErrorRecovery();
@@ -779,7 +789,7 @@ ParseResult Parser<UCharInputIterator>::ParseAssignmentExpression() {
   ParseResult expr_result;
   bool parsed_as_assignment_pattern = false;
 
-  if (cur_token()->Is(TokenKind::kIdentifier) && cur_token()->value()->Equals("yield") && state_.IsInGenerator()) {
+  if (cur_token()->Is(TokenKind::kIdentifier) && cur_token()->value()->Is(Atom::kYield) && state_.IsInGenerator()) {
     expr_result = ParseYieldExpression();
     CHECK_AST(expr_result);
   } else {  
@@ -921,7 +931,7 @@ template <typename UCharInputIterator>
 ParseResult Parser<UCharInputIterator>::ParseConditionalExpression() {
   LOG_PHASE(ParseConditionalExpression);
   
-  auto logical_or_expr_result = ParseLogicalORExpression();
+  auto logical_or_expr_result = ParseBinaryExpression(Token::kLowestOperandPriority);
   CHECK_AST(logical_or_expr_result);
   
   if (cur_token()->Is(TokenKind::kQuestionMark)) {
@@ -948,79 +958,26 @@ ParseResult Parser<UCharInputIterator>::ParseConditionalExpression() {
 }
 
 
-#define PARSE_BINARY_EXPRESSION_INTERNAL(check, name, next)             \
-  template <typename UCharInputIterator>                                \
-  ParseResult Parser<UCharInputIterator>::name() {                      \
-    LOG_PHASE(name);                                                    \
-    auto ret = next;                                                    \
-    CHECK_AST(ret);                                                     \
-    while (1) {                                                         \
-      if (check) {                                                      \
-        if ((!ret.value()->IsValidLhs() && Token::IsLetOperator(cur_token()->type())) || \
-            (Token::IsLetOperator(cur_token()->type()) &&               \
-             !ret.value()->HasNameView() &&                             \
-             !ret.value()->HasGetPropView() &&                          \
-             !ret.value()->HasGetElemView())) {                         \
-          ReportParseError(cur_token(), YATSC_SOURCEINFO_ARGS) << "invalid left handle side expression."; \
-          return Failed();                                              \
-        }                                                               \
-        auto tmp = ret;                                                 \
-        TokenKind type = cur_token()->type();                           \
-        Next();                                                         \
-        auto n = next;                                                  \
-        CHECK_AST(n);                                                   \
-        ret = Success(New<ir::BinaryExprView>(type, ret.value(), n.value())); \
-        ret.value()->SetInformationForNode(tmp.value());                \
-      } else {                                                          \
-        break;                                                          \
-      }                                                                 \
-    }                                                                   \
-    return ret;                                                         \
-  }
-
-
-#define PARSE_BINARY_EXPRESSION(name, next, token)                      \
-  PARSE_BINARY_EXPRESSION_INTERNAL((cur_token()->Is(TokenKind::token)), name, (next()))
-
-#define PARSE_BINARY_EXPRESSION_WITH_COND(cond, name, next)         \
-  PARSE_BINARY_EXPRESSION_INTERNAL((cond), name, (next()))
-
-#define PARSE_BINARY_EXPRESSION_WITH_CALL(cond, name, call) \
-  PARSE_BINARY_EXPRESSION_INTERNAL((cond), name, (call))
-
-
 // LogicalORExpression[In, Yield]
 //   LogicalANDExpression[?In, ?Yield]
 //   LogicalORExpression[?In, ?Yield] || LogicalANDExpression[?In, ?Yield]
 //
-PARSE_BINARY_EXPRESSION(ParseLogicalORExpression, ParseLogicalANDExpression, kLogicalOr)
-
 // LogicalANDExpression[In, Yield]
-// BitwiseORExpression[?In, ?Yield]
-// LogicalANDExpression[?In, ?Yield] && BitwiseORExpression[?In, ?Yield]
+//   BitwiseORExpression[?In, ?Yield]
+//   LogicalANDExpression[?In, ?Yield] && BitwiseORExpression[?In, ?Yield]
 //
-PARSE_BINARY_EXPRESSION(ParseLogicalANDExpression, ParseBitwiseORExpression, kLogicalAnd)
-
 // BitwiseORExpression[In, Yield]
 //   BitwiseXORExpression[?In, ?Yield]
 //   BitwiseORExpression[?In, ?Yield] | BitwiseXORExpression[?In, ?Yield]
 //
-PARSE_BINARY_EXPRESSION(ParseBitwiseORExpression, ParseBitwiseXORExpression, kBitOr)
-
 // BitwiseXORExpression[In, Yield]
 //   BitwiseANDExpression[?In, ?Yield]
 //   BitwiseXORExpression[?In, ?Yield] ^ BitwiseANDExpression[?In, ?Yield]
 //
-PARSE_BINARY_EXPRESSION(ParseBitwiseXORExpression, ParseBitwiseANDExpression, kBitXor)
-
-
 // BitwiseANDExpression[In, Yield]
 //   EqualityExpression[?In, ?Yield]
 //   BitwiseANDExpression[?In, ?Yield] & EqualityExpression[?In, ?Yield]
 //
-PARSE_BINARY_EXPRESSION(ParseBitwiseANDExpression, ParseEqualityExpression, kBitAnd)
-
-
 // EqualityExpression[In, Yield]
 //   RelationalExpression[?In, ?Yield]
 //   EqualityExpression[?In, ?Yield] == RelationalExpression[?In, ?Yield]
@@ -1028,12 +985,6 @@ PARSE_BINARY_EXPRESSION(ParseBitwiseANDExpression, ParseEqualityExpression, kBit
 //   EqualityExpression[?In, ?Yield] ===RelationalExpression[?In, ?Yield]
 //   EqualityExpression[?In, ?Yield] !==RelationalExpression[?In, ?Yield]
 //
-PARSE_BINARY_EXPRESSION_WITH_COND((cur_token()->Is(TokenKind::kEq) || cur_token()->Is(TokenKind::kNotEq) || cur_token()->Is(TokenKind::kEqual) || cur_token()->Is(TokenKind::kNotEqual)), ParseEqualityExpression, ParseRelationalExpression)
-
-#define RELATIONAL_COND                             \
-  cur_token()->OneOf({TokenKind::kLess, TokenKind::kGreater, TokenKind::kLessEqual, TokenKind::kGreaterEqual, TokenKind::kInstanceof}) || \
-  (!state_.IsInNoInExpr() && cur_token()->Is(TokenKind::kIn))
-
 // RelationalExpression[In, Yield]
 //   ShiftExpression[?Yield]
 //   RelationalExpression[?In, ?Yield] < ShiftExpression[?Yield]
@@ -1043,50 +994,48 @@ PARSE_BINARY_EXPRESSION_WITH_COND((cur_token()->Is(TokenKind::kEq) || cur_token(
 //   RelationalExpression[?In, ?Yield] instanceof ShiftExpression[?Yield]
 //   [+In] RelationalExpression[In, ?Yield] in ShiftExpression[?Yield]
 //
-PARSE_BINARY_EXPRESSION_WITH_COND((RELATIONAL_COND), ParseRelationalExpression, ParseShiftExpression)
-#undef RELATIONAL_COND
-
-
-#define SHIFT_COND                                \
-  cur_token()->OneOf({TokenKind::kShiftLeft, TokenKind::kShiftRight, TokenKind::kUShiftRight})
-
 // ShiftExpression[Yield]
 //   AdditiveExpression[?Yield]
 //   ShiftExpression[?Yield] << AdditiveExpression[?Yield]
 //   ShiftExpression[?Yield] >> AdditiveExpression[?Yield]
 //   ShiftExpression[?Yield] >>> AdditiveExpression[?Yield]
 //
-PARSE_BINARY_EXPRESSION_WITH_COND((SHIFT_COND), ParseShiftExpression, ParseAdditiveExpression)
-#undef SHIFT_COND
-
-
-#define ADDITIVE_COND                           \
-  cur_token()->OneOf({TokenKind::kPlus, TokenKind::kMinus})
-
 // AdditiveExpression[Yield]
 //   MultiplicativeExpression[?Yield]
 //   AdditiveExpression[?Yield] + MultiplicativeExpression[?Yield]
 //   AdditiveExpression[?Yield] - MultiplicativeExpression[?Yield]
 //
-PARSE_BINARY_EXPRESSION_WITH_COND(ADDITIVE_COND, ParseAdditiveExpression, ParseMultiplicativeExpression)
-#undef ADDITIVE_COND
-
-
-#define MULTIPLICATIVE_COND                     \
-    cur_token()->OneOf({TokenKind::kMul, TokenKind::kMod, TokenKind::kDiv})
-
-// AdditiveExpression[Yield]
-//   MultiplicativeExpression[?Yield]
-//   AdditiveExpression[?Yield] + MultiplicativeExpression[?Yield]
-//   AdditiveExpression[?Yield] - MultiplicativeExpression[?Yield]
+// MultiplicativeExpression[Yield]
+//   UnaryExpression[?Yield]
+//   MultiplicativeExpression[?Yield] * UnaryExpression[?Yield]
+//   MultiplicativeExpression[?Yield] / UnaryExpression[?Yield]
+//   MultiplicativeExpression[?Yield] % UnaryExpression[?Yield]
+//
+// All levels of the above rules are parsed by the precedence climbing.
+// The operators of the same priority are left associative,
+// so the right operand is parsed with only the higher priority operators.
 //
-PARSE_BINARY_EXPRESSION_WITH_CALL(MULTIPLICATIVE_COND, ParseMultiplicativeExpression, ParseUnaryExpression())
-#undef MULTIPLICATIVE_COND
+template <typename UCharInputIterator>
+ParseResult Parser<UCharInputIterator>::ParseBinaryExpression(uint8_t priority) {
+  LOG_PHASE(ParseBinaryExpression);
+  auto ret = ParseUnaryExpression();
+  CHECK_AST(ret);
 
-#undef PARSE_BINARY_EXPRESSION_INTERNAL
-#undef PARSE_BINARY_EXPRESSION
-#undef PARSE_BINARY_EXPRESSION_WITH_COND
-#undef PARSE_BINARY_EXPRESSION_WITH_CALL
+  while (1) {
+    uint8_t operator_priority = BinaryOperatorPriority();
+    if (operator_priority == 0 || operator_priority > priority) {
+      break;
+    }
+    TokenKind type = cur_token()->type();
+    Next();
+    auto rhs = ParseBinaryExpression(operator_priority - 1);
+    CHECK_AST(rhs);
+    auto binary_expr = New<ir::BinaryExprView>(type, ret.value(), rhs.value());
+    binary_expr->SetInformationForNode(ret.value());
+    ret = Success(binary_expr);
+  }
+  return ret;
+}
 
 
 // UnaryExpression[Yield]
@@ -1155,6 +1104,12 @@ ParseResult Parser<UCharInputIterator>::ParsePostfixExpression() {
 // 	;
 template <typename UCharInputIterator>
 ParseResult Parser<UCharInputIterator>::ParseLeftHandSideExpression() {
+  return Memoize(MemoRule::kLeftHandSideExpression, [&]{return ParseUnmemoizedLeftHandSideExpression();});
+}
+
+
+template <typename UCharInputIterator>
+ParseResult Parser<UCharInputIterator>::ParseUnmemoizedLeftHandSideExpression() {
   LOG_PHASE(ParseLeftHandSideExpression);
   auto tokens = token_pack();
   if (cur_token()->Is(TokenKind::kNew)) {
@@ -1275,7 +1230,7 @@ ParseResult Parser<UCharInputIterator>::ParseArguments() {
   ParseResult type_arguments_result;
   bool type_arguments = false;
   
-  RecordedParserState rps = parser_state();
+  Checkpoint rps = parser_state();
   if (cur_token()->Is(TokenKind::kLess)) {
     type_arguments_result = TryParse([&]{return ParseTypeArguments();});
     if (!type_arguments_result) {
@@ -1515,20 +1470,6 @@ ParseResult Parser<UCharInputIterator>::ParsePrimaryExpression() {
   
   ParseResult parse_result;
   
-  // Parsed* parsed = GetMemoizedRecord(token_info->source_position());
-  // if (parsed != nullptr) {
-  //   RestoreParserState(parsed->parser_state());
-  //   return parsed->parse_result();
-  // }
-
-
-  // if (IsInRecordMode()) {
-  //   YATSC_SCOPED([&] {
-  //     Memoize(info.source_position(), parse_result);
-  //   });
-  // }
-  
-  
   switch (token_info->type()) {
     case TokenKind::kIdentifier: {
       return parse_result = ParseIdentifierReference();
@@ -1709,7 +1650,7 @@ ParseResult Parser<UCharInputIterator>::ParseComprehensionFor() {
     
     return ParseForBinding() >>= [&](ir::Node* for_binding) {
       if (cur_token()->Is(TokenKind::kIdentifier) &&
-          cur_token()->value()->Equals("of")) {
+          cur_token()->value()->Is(Atom::kOf)) {
         Next();
         
         return ParseAssignmentExpression() >>= [&](ir::Node* assignment_expr) {
@@ -1902,11 +1843,11 @@ ParseResult Parser<UCharInputIterator>::ParsePropertyDefinition() {
   }
    
   if (cur_token()->Is(TokenKind::kIdentifier) &&
-      cur_token()->value()->Equals("get")) {
+      cur_token()->value()->Is(Atom::kGet)) {
       getter = true;
       Next();
   } else if (cur_token()->Is(TokenKind::kIdentifier) &&
-             cur_token()->value()->Equals("set")) {
+             cur_token()->value()->Is(Atom::kSet)) {
       setter = true;
       Next();
   }
@@ -1923,7 +1864,7 @@ ParseResult Parser<UCharInputIterator>::ParsePropertyDefinition() {
 
   if (key_result) {
     if (key_result.value()->HasSymbol()) {
-      key_result.value()->symbol()->set_type(ir::SymbolType::kPropertyName);
+      ChangeSymbolType(key_result.value(), ir::SymbolType::kPropertyName);
     }
   } else {
     if (getter || setter) {
@@ -2079,7 +2020,7 @@ ParseResult Parser<UCharInputIterator>::ParseIdentifierReference() {
   LOG_PHASE(ParseIdentifierReference);
 
   if (cur_token()->Is(TokenKind::kIdentifier)) {
-    if (cur_token()->value()->Equals("yield") && state_.IsInGenerator()) {
+    if (cur_token()->value()->Is(Atom::kYield) && state_.IsInGenerator()) {
       ReportParseError(cur_token(), YATSC_SOURCEINFO_ARGS)
         << "'yield' not allowed here";
     }
@@ -2095,7 +2036,7 @@ ParseResult Parser<UCharInputIterator>::ParseIdentifierReference() {
 template <typename UCharInputIterator>
 ParseResult Parser<UCharInputIterator>::ParseLabelIdentifier() {
   LOG_PHASE(ParseLabelIdentifier);
-  if (cur_token()->Is(TokenKind::kIdentifier) && cur_token()->value()->Equals("yield") &&
+  if (cur_token()->Is(TokenKind::kIdentifier) && cur_token()->value()->Is(Atom::kYield) &&
       state_.IsInGenerator()) {
     ReportParseError(cur_token(), YATSC_SOURCEINFO_ARGS)
       << "yield not allowed here";
@@ -2142,7 +2083,7 @@ template <typename UCharInputIterator>
 ParseResult Parser<UCharInputIterator>::ParseNumericLiteral() {
   LOG_PHASE(ParseNumericLiteral);
   if (cur_token()->Is(TokenKind::kNumericLiteral)) {
-    auto number = New<ir::NumberView>(cur_token()->value());
+    auto number = New<ir::NumberView>(cur_token()->value(), cur_token()->numeric_value());
     number->SetInformationForNode(cur_token());
     Next();
     return Success(number);
@@ -2245,11 +2186,11 @@ typename Parser<UCharInputIterator>::AccessorType Parser<UCharInputIterator>::Pa
   auto tokens = token_pack();
   // Parse the getter or setter if inditifer is the get or set.
   if (cur_token()->Is(TokenKind::kIdentifier) &&
-      cur_token()->value()->Equals("get")) {
+      cur_token()->value()->Is(Atom::kGet)) {
     getter = true;
     Next();
   } else if (cur_token()->Is(TokenKind::kIdentifier) &&
-             cur_token()->value()->Equals("set")) {
+             cur_token()->value()->Is(Atom::kSet)) {
     setter = true;
     Next();
   }
@@ -25,7 +25,11 @@
 #ifndef PARSER_LITERLBUFFER_H
 #define PARSER_LITERLBUFFER_H
 
+#include <atomic>
+#include "./atoms.h"
+#include "../utils/spinlock.h"
 #include "../utils/stl.h"
+#include "../utils/tls.h"
 #include "../utils/utils.h"
 #include "./utfstring.h"
 
@@ -38,6 +42,12 @@ class Literal {
         value_(utf_string) {}
 
 
+  // Create the Literal of the atom that has the fixed id.
+  Literal(Unique::Id id, const UtfString& utf_string)
+      : id_ (id),
+        value_(utf_string) {}
+
+
   Literal(Literal&& literal)
       : id_(literal.id_),
         value_(std::move(literal.value_)) {}
@@ -71,6 +81,12 @@ class Literal {
   }
 
 
+  // Check whether this literal is the specified well-known name.
+  YATSC_INLINE bool Is(Atom atom) YATSC_NO_SE {
+    return id_ == AtomId(atom);
+  }
+
+
   template <typename T>
   bool Equals(T value) YATSC_NO_SE {
     return value_ == value;
@@ -100,25 +116,373 @@ class Literal {
 };
 
 
+// The per-thread direct-mapped cache of the interned Literal.
+// The most of the lookups are for the same few thousand identifiers,
+// so the hit is answered from the thread's own memory
+// and the shared table of the LiteralBuffer is not touched.
+// The entry is tagged with the id of the owner LiteralBuffer,
+// so the entries of the destroyed buffer are never returned.
+class LiteralCache: private Unmovable, private Uncopyable {
+ public:
+  static const size_t kCacheBits = 10;
+  static const size_t kCacheSize = 1 << kCacheBits;
+  
+  LiteralCache()
+      : hit_count_(0),
+        miss_count_(0) {}
+
+
+  // Return the LiteralCache of the current thread.
+  static LiteralCache* Current() {
+    static ThreadLocalStorage::Slot slot(&LiteralCache::Delete);
+    LiteralCache* cache = reinterpret_cast<LiteralCache*>(slot.Get());
+    if (cache == nullptr) {
+      cache = new LiteralCache();
+      slot.Set(cache);
+    }
+    return cache;
+  }
+
+
+  // Find the literal that is owned by the owner from the cache.
+  // Return nullptr if not cached.
+  YATSC_INLINE Literal* Find(Unique::Id owner, uint32_t hash, const Utf16String& value) YATSC_NOEXCEPT {
+    Entry& entry = entries_[hash & (kCacheSize - 1)];
+    if (entry.literal != nullptr &&
+        entry.owner == owner &&
+        entry.hash == hash &&
+        entry.length == value.size() &&
+        entry.literal->utf16_string() == value) {
+      hit_count_++;
+      return entry.literal;
+    }
+    miss_count_++;
+    return nullptr;
+  }
+
+
+  // Cache the literal, the previous entry of the same slot is evicted.
+  YATSC_INLINE void Update(Unique::Id owner, uint32_t hash, Literal* literal) YATSC_NOEXCEPT {
+    Entry& entry = entries_[hash & (kCacheSize - 1)];
+    entry.owner = owner;
+    entry.hash = hash;
+    entry.length = literal->utf16_string().size();
+    entry.literal = literal;
+  }
+
+
+  // Reset the hit and miss counters of this thread.
+  void ResetStats() YATSC_NOEXCEPT {
+    hit_count_ = 0;
+    miss_count_ = 0;
+  }
+
+  
+  YATSC_CONST_GETTER(uint64_t, hit_count, hit_count_)
+
+  
+  YATSC_CONST_GETTER(uint64_t, miss_count, miss_count_)
+
+
+  // Return the ratio of the hit, or 0 if not looked up yet.
+  double hit_rate() YATSC_NO_SE {
+    uint64_t total = hit_count_ + miss_count_;
+    return total == 0? 0.0: static_cast<double>(hit_count_) / static_cast<double>(total);
+  }
+  
+ private:
+  struct Entry {
+    Entry()
+        : owner(0),
+          hash(0),
+          length(0),
+          literal(nullptr) {}
+    
+    Unique::Id owner;
+    uint32_t hash;
+    size_t length;
+    Literal* literal;
+  };
+
+
+  // Called when the thread is terminated.
+  static void Delete(void* cache) {
+    delete reinterpret_cast<LiteralCache*>(cache);
+  }
+  
+
+  Entry entries_[kCacheSize];
+  uint64_t hit_count_;
+  uint64_t miss_count_;
+};
+
+
+// The intern table of the Literal that is shared by all worker threads.
+// The table is split into the shards which have their own lock and buckets,
+// and the lookup of the already interned value takes no lock.
+// The entries are never removed, so the returned Literal* is stable
+// until the LiteralBuffer is destroyed.
+// The LiteralCache of the calling thread is looked up before the shared table.
+// The buffer is seeded with the atoms, which are returned by atom() without hashing.
 class LiteralBuffer: private Unmovable, private Uncopyable {
-  typedef HashMap<Utf16String, Literal> UtfStringBuffer;
  public:
-  LiteralBuffer() = default;
+  LiteralBuffer()
+      : id_(Unique::id()) {
+    for (size_t i = 0; i < kAtomCount; i++) {
+      const atoms::AtomEntry& entry = atoms::kAtomTable[i];
+      atoms_[i] = shards_[entry.hash >> kShardShift].Seed(entry.hash, UtfString(entry.value), static_cast<Unique::Id>(i));
+    }
+  }
+
+
+  ~LiteralBuffer() {
+    for (size_t i = 0; i < kShardCount; i++) {
+      shards_[i].Clear();
+    }
+  }
 
   
   Literal* InsertValue(const UtfString& utf_string) {
-    ScopedSpinLock lock(lock_);
-    UtfStringBuffer::iterator found = buffer_.find(utf_string.utf16_string());
-    if (found != buffer_.end()) {
-      return &(found->second);
+    const Utf16String& value = utf_string.utf16_string();
+    uint32_t hash = Hash(value);
+    LiteralCache* cache = LiteralCache::Current();
+    Literal* literal = cache->Find(id_, hash, value);
+    if (literal != nullptr) {
+      return literal;
+    }
+    
+    Shard& shard = shards_[hash >> kShardShift];
+    literal = shard.Find(hash, value);
+    if (literal == nullptr) {
+      literal = shard.Insert(hash, utf_string);
+    }
+    cache->Update(id_, hash, literal);
+    return literal;
+  }
+
+
+  // Return the seeded Literal of the atom.
+  YATSC_INLINE Literal* atom(Atom atom) YATSC_NOEXCEPT {
+    return atoms_[static_cast<size_t>(atom)];
+  }
+  
+
+  // Return the count of the interned literals except the atoms.
+  size_t size() YATSC_NO_SE {
+    size_t size = 0;
+    for (size_t i = 0; i < kShardCount; i++) {
+      size += shards_[i].size();
     }
-    auto ret = buffer_.insert(std::make_pair(utf_string.utf16_string(), Literal(utf_string)));
-    return &(ret.first->second);
+    return size - kAtomCount;
+  }
+
+
+  // FNV-1a hash of the utf-16 sequence.
+  static uint32_t Hash(const Utf16String& value) {
+    uint32_t hash = 2166136261u;
+    for (auto uc: value) {
+      hash = (hash ^ static_cast<uint32_t>(uc)) * 16777619u;
+    }
+    return hash;
   }
   
  private:
-  SpinLock lock_;
-  UtfStringBuffer buffer_;
+  static const size_t kShardBits = 6;
+  static const size_t kShardCount = 1 << kShardBits;
+  static const size_t kShardShift = 32 - kShardBits;
+  static const size_t kInitialBucketCount = 16;
+  static const size_t kCacheLineSize = 64;
+
+
+  // The chain node of the bucket.
+  // The hash is kept to skip the string comparison and to rehash.
+  class Entry {
+   public:
+    Entry(uint32_t hash, const UtfString& utf_string)
+        : hash_(hash),
+          literal_(utf_string) {
+      next_.store(nullptr, std::memory_order_relaxed);
+    }
+
+
+    Entry(uint32_t hash, const UtfString& utf_string, Unique::Id id)
+        : hash_(hash),
+          literal_(id, utf_string) {
+      next_.store(nullptr, std::memory_order_relaxed);
+    }
+
+    YATSC_CONST_GETTER(uint32_t, hash, hash_)
+
+    YATSC_INLINE Literal* literal() YATSC_NOEXCEPT {return &literal_;}
+
+    YATSC_INLINE Entry* next() YATSC_NO_SE {return next_.load(std::memory_order_acquire);}
+
+    YATSC_INLINE void set_next(Entry* entry) YATSC_NOEXCEPT {next_.store(entry, std::memory_order_release);}
+    
+   private:
+    std::atomic<Entry*> next_;
+    uint32_t hash_;
+    Literal literal_;
+  };
+
+
+  // The bucket array of the shard.
+  // The old array is kept alive until the buffer is destroyed,
+  // because the lock free readers may still traverse it.
+  class Buckets {
+   public:
+    Buckets(size_t bucket_count, Buckets* retired)
+        : bucket_count_(bucket_count),
+          retired_(retired),
+          heads_(reinterpret_cast<std::atomic<Entry*>*>(Heap::NewPtr(sizeof(std::atomic<Entry*>) * bucket_count))) {
+      for (size_t i = 0; i < bucket_count; i++) {
+        new(&heads_[i]) std::atomic<Entry*>(nullptr);
+      }
+    }
+
+
+    ~Buckets() {
+      Heap::Delete(heads_);
+    }
+
+
+    YATSC_INLINE std::atomic<Entry*>& head(uint32_t hash) YATSC_NOEXCEPT {
+      return heads_[hash & (bucket_count_ - 1)];
+    }
+
+    
+    YATSC_CONST_GETTER(size_t, bucket_count, bucket_count_)
+
+
+    YATSC_CONST_GETTER(Buckets*, retired, retired_)
+    
+   private:
+    size_t bucket_count_;
+    Buckets* retired_;
+    std::atomic<Entry*>* heads_;
+  };
+
+
+  class Shard {
+   public:
+    Shard()
+        : size_(0) {
+      buckets_.store(nullptr, std::memory_order_relaxed);
+    }
+
+
+    // Find the literal without the lock.
+    // Return nullptr if not found, the caller must retry by Insert
+    // because the entry which is being rehashed may be missed.
+    Literal* Find(uint32_t hash, const Utf16String& value) YATSC_NO_SE {
+      Buckets* buckets = buckets_.load(std::memory_order_acquire);
+      if (buckets == nullptr) {
+        return nullptr;
+      }
+      
+      Entry* entry = buckets->head(hash).load(std::memory_order_acquire);
+      while (entry != nullptr) {
+        if (entry->hash() == hash && entry->literal()->utf16_string() == value) {
+          return entry->literal();
+        }
+        entry = entry->next();
+      }
+      return nullptr;
+    }
+
+
+    Literal* Insert(uint32_t hash, const UtfString& utf_string) {
+      ScopedSpinLock lock(lock_);
+      Literal* found = Find(hash, utf_string.utf16_string());
+      if (found != nullptr) {
+        return found;
+      }
+
+      return Append(Heap::New<Entry>(hash, utf_string));
+    }
+
+
+    // Insert the atom that has the fixed id.
+    Literal* Seed(uint32_t hash, const UtfString& utf_string, Unique::Id id) {
+      ScopedSpinLock lock(lock_);
+      return Append(Heap::New<Entry>(hash, utf_string, id));
+    }
+
+
+    YATSC_INLINE size_t size() YATSC_NO_SE {return size_;}
+
+
+    void Clear() {
+      Buckets* buckets = buckets_.load(std::memory_order_relaxed);
+      if (buckets == nullptr) {
+        return;
+      }
+      for (size_t i = 0; i < buckets->bucket_count(); i++) {
+        Entry* entry = buckets->head(static_cast<uint32_t>(i)).load(std::memory_order_relaxed);
+        while (entry != nullptr) {
+          Entry* next = entry->next();
+          Heap::Destruct(entry);
+          entry = next;
+        }
+      }
+      while (buckets != nullptr) {
+        Buckets* retired = buckets->retired();
+        Heap::Destruct(buckets);
+        buckets = retired;
+      }
+      buckets_.store(nullptr, std::memory_order_relaxed);
+      size_ = 0;
+    }
+    
+   private:
+    // Link the new entry to the head of the bucket.
+    // The lock must be acquired.
+    Literal* Append(Entry* entry) {
+      Buckets* buckets = buckets_.load(std::memory_order_relaxed);
+      if (buckets == nullptr || size_ >= buckets->bucket_count()) {
+        buckets = Grow(buckets);
+      }
+      
+      std::atomic<Entry*>& head = buckets->head(entry->hash());
+      entry->set_next(head.load(std::memory_order_relaxed));
+      head.store(entry, std::memory_order_release);
+      size_++;
+      return entry->literal();
+    }
+
+    
+    // Move all entries to the twice larger buckets.
+    Buckets* Grow(Buckets* buckets) {
+      size_t bucket_count = buckets == nullptr? kInitialBucketCount: buckets->bucket_count() * 2;
+      Buckets* new_buckets = Heap::New<Buckets>(bucket_count, buckets);
+      if (buckets != nullptr) {
+        for (size_t i = 0; i < buckets->bucket_count(); i++) {
+          Entry* entry = buckets->head(static_cast<uint32_t>(i)).load(std::memory_order_relaxed);
+          while (entry != nullptr) {
+            Entry* next = entry->next();
+            std::atomic<Entry*>& head = new_buckets->head(entry->hash());
+            entry->set_next(head.load(std::memory_order_relaxed));
+            head.store(entry, std::memory_order_relaxed);
+            entry = next;
+          }
+        }
+      }
+      buckets_.store(new_buckets, std::memory_order_release);
+      return new_buckets;
+    }
+
+    
+    SpinLock lock_;
+    std::atomic<Buckets*> buckets_;
+    size_t size_;
+    // Keep each shard on the different cache line.
+    Byte padding_[kCacheLineSize] YATSC_UNUSED;
+  };
+
+  
+  Unique::Id id_;
+  Literal* atoms_[kAtomCount];
+  Shard shards_[kShardCount];
 };
 }
 
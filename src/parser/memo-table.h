@@ -0,0 +1,149 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2013 Taketoshi Aono(brn)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef PARSER_MEMO_TABLE_H
+#define PARSER_MEMO_TABLE_H
+
+#include "../utils/utils.h"
+
+namespace yatsc {
+
+// The bounded hash table of the packrat parser memo.
+// The key is built from the rule, the parser context and the offset of the token,
+// and the table is the flat array of the entries that is probed linearly.
+// The table never grows, if the probe window is full,
+// the entry of the home slot is overwritten.
+// The value of the overwritten entry is left in the slot,
+// so the caller can reuse the memory of it.
+template <typename Value, size_t kBits = 10>
+class MemoTable: private Uncopyable {
+ public:
+  static const size_t kCapacity = 1 << kBits;
+  static const size_t kProbeLength = 4;
+  
+  MemoTable()
+      : size_(0),
+        hit_count_(0),
+        miss_count_(0) {}
+
+
+  // Build the key of the memo.
+  static uint64_t MakeKey(uint8_t rule, uint8_t context, uint32_t offset) YATSC_NOEXCEPT {
+    return (static_cast<uint64_t>(rule) << 40) | (static_cast<uint64_t>(context) << 32) | offset;
+  }
+
+
+  // Return the value of the key, or nullptr if not memoized.
+  Value* Find(uint64_t key) YATSC_NOEXCEPT {
+    size_t index = Index(key);
+    for (size_t i = 0; i < kProbeLength; i++) {
+      Entry& entry = entries_[(index + i) & (kCapacity - 1)];
+      if (entry.used && entry.key == key) {
+        hit_count_++;
+        return &entry.value;
+      }
+    }
+    miss_count_++;
+    return nullptr;
+  }
+
+
+  // Return the slot of the key.
+  // If the key is not memoized yet, the empty or the evicted slot is returned.
+  Value& Insert(uint64_t key) YATSC_NOEXCEPT {
+    size_t index = Index(key);
+    Entry* empty = nullptr;
+    for (size_t i = 0; i < kProbeLength; i++) {
+      Entry& entry = entries_[(index + i) & (kCapacity - 1)];
+      if (entry.used && entry.key == key) {
+        return entry.value;
+      }
+      if (!entry.used && empty == nullptr) {
+        empty = &entry;
+      }
+    }
+
+    if (empty == nullptr) {
+      empty = &entries_[index];
+    } else {
+      size_++;
+    }
+    empty->key = key;
+    empty->used = true;
+    return empty->value;
+  }
+
+
+  // Call fn with the all memoized values.
+  template <typename Fn>
+  void ForEach(Fn fn) {
+    for (size_t i = 0; i < kCapacity; i++) {
+      if (entries_[i].used) {
+        fn(entries_[i].value);
+      }
+    }
+  }
+
+  
+  YATSC_CONST_GETTER(size_t, size, size_)
+  
+
+  YATSC_CONST_GETTER(uint64_t, hit_count, hit_count_)
+
+
+  YATSC_CONST_GETTER(uint64_t, miss_count, miss_count_)
+  
+ private:
+  struct Entry {
+    Entry()
+        : key(0),
+          used(false),
+          value() {}
+    
+    uint64_t key;
+    bool used;
+    Value value;
+  };
+
+
+  // Fibonacci hashing of the key.
+  static size_t Index(uint64_t key) YATSC_NOEXCEPT {
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> (64 - kBits));
+  }
+  
+
+  Entry entries_[kCapacity];
+  size_t size_;
+  uint64_t hit_count_;
+  uint64_t miss_count_;
+};
+
+
+template <typename Value, size_t kBits>
+const size_t MemoTable<Value, kBits>::kCapacity;
+
+
+template <typename Value, size_t kBits>
+const size_t MemoTable<Value, kBits>::kProbeLength;
+}
+
+#endif
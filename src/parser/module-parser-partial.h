@@ -30,7 +30,10 @@ template <typename UCharInputIterator>
 ParseResult Parser<UCharInputIterator>::ParseModule() {
   LOG_PHASE(ParseModule);
   
-  auto file_scope = New<ir::FileScopeView>(current_scope());
+  // The ir is discarded after each statement while the syntax check,
+  // so the file scope is created after all statements are parsed.
+  ir::FileScopeView* file_scope = compiler_option_.syntax_check_only()?
+      nullptr: New<ir::FileScopeView>(current_scope());
   bool success = true;
   
   // Parse all statements until eof is found.
@@ -41,20 +44,20 @@ ParseResult Parser<UCharInputIterator>::ParseModule() {
 
       auto import_decl_result = ParseImportDeclaration();
       if (import_decl_result) {
-        file_scope->InsertLast(import_decl_result.value());
+        AddFileScopeStatement(file_scope, import_decl_result.value());
       } else {
         SkipToNextStatement();
       }
       
     } else if (cur_token()->Is(TokenKind::kIdentifier) &&
-               cur_token()->value()->Equals("module")) {
+               cur_token()->value()->Is(Atom::kModule)) {
 
       // Parse module declaration.
       // module import a from ....
       // module a {} etc.
       auto module_decl_result = ParseModuleImport();
       if (module_decl_result) {
-        file_scope->InsertLast(module_decl_result.value());
+        AddFileScopeStatement(file_scope, module_decl_result.value());
       } else {
         SkipToNextStatement();
       }
@@ -67,7 +70,7 @@ ParseResult Parser<UCharInputIterator>::ParseModule() {
       // export = ...
       auto export_decl_result = ParseExportDeclaration();
       if (export_decl_result) {
-        file_scope->InsertLast(export_decl_result.value());
+        AddFileScopeStatement(file_scope, export_decl_result.value());
       } else {
         SkipToNextStatement();
       }
@@ -83,10 +86,10 @@ ParseResult Parser<UCharInputIterator>::ParseModule() {
 
       // Parse ambient declaration.
       if (cur_token()->Is(TokenKind::kIdentifier) &&
-          cur_token()->value()->Equals("declare")) {
+          cur_token()->value()->Is(Atom::kDeclare)) {
         auto ambient_decl_result = ParseAmbientDeclaration(true);
         if (ambient_decl_result) {
-          file_scope->InsertLast(ambient_decl_result.value());
+          AddFileScopeStatement(file_scope, ambient_decl_result.value());
         } else {
           SkipToNextStatement();
         }
@@ -95,7 +98,7 @@ ParseResult Parser<UCharInputIterator>::ParseModule() {
         // Parse normal statement.
         auto stmt_list_result = ParseStatementListItem();
         if (stmt_list_result) {
-          file_scope->InsertLast(stmt_list_result.value());
+          AddFileScopeStatement(file_scope, stmt_list_result.value());
         } else {
           SkipToNextStatement();
         }
@@ -106,6 +109,10 @@ ParseResult Parser<UCharInputIterator>::ParseModule() {
       ConsumeLineTerminator();
     }
   }
+
+  if (file_scope == nullptr) {
+    file_scope = New<ir::FileScopeView>(current_scope());
+  }
   return Success(file_scope);
 }
 
@@ -175,8 +182,8 @@ ParseResult Parser<UCharInputIterator>::ParseExternalModuleReference() {
   
   if (cur_token()->Is(TokenKind::kIdentifier)) {
 
-    if (cur_token()->value()->Equals("require") ||
-        (module = cur_token()->value()->Equals("module"))) {
+    if (cur_token()->value()->Is(Atom::kRequire) ||
+        (module = cur_token()->value()->Is(Atom::kModule))) {
       if (module) {
         ReportParseWarning(cur_token(), YATSC_SOURCEINFO_ARGS)
           << "'module' import is deprecated.";
@@ -280,7 +287,7 @@ ParseResult Parser<UCharInputIterator>::ParseNamedImport() {
       
       if (identifier_result.value()->HasNameView() &&
           cur_token()->Is(TokenKind::kIdentifier) &&
-          cur_token()->value()->Equals("as")) {
+          cur_token()->value()->Is(Atom::kAs)) {
         
         Next();
         auto binding_identifier_result = ParseBindingIdentifier();
@@ -317,7 +324,7 @@ template <typename UCharInputIterator>
 ParseResult Parser<UCharInputIterator>::ParseFromClause() {
   LOG_PHASE(ParseFromClause);
   if (cur_token()->Is(TokenKind::kIdentifier) &&
-      cur_token()->value()->Equals("from")) {
+      cur_token()->value()->Is(Atom::kFrom)) {
     Token info = *cur_token();
     Next();
     return ParseStringLiteral();
@@ -333,7 +340,7 @@ template <typename UCharInputIterator>
 ParseResult Parser<UCharInputIterator>::ParseModuleImport() {
   LOG_PHASE(ParseModuleImport);
   if (cur_token()->Is(TokenKind::kIdentifier) &&
-      cur_token()->value()->Equals("module")) {
+      cur_token()->value()->Is(Atom::kModule)) {
     Token info = *cur_token();
     TokenPack tokens = token_pack();
     Next();
@@ -481,7 +488,7 @@ ParseResult Parser<UCharInputIterator>::ParseTSModuleBody() {
             
           default:
             if (cur_token()->Is(TokenKind::kIdentifier) &&
-                cur_token()->value()->Equals("module")) {
+                cur_token()->value()->Is(Atom::kModule)) {
               auto module_import_result = ParseModuleImport();
 
               if (module_import_result) {
@@ -490,7 +497,7 @@ ParseResult Parser<UCharInputIterator>::ParseTSModuleBody() {
                 SkipToNextStatement();
               }
             } else if (cur_token()->Is(TokenKind::kIdentifier) &&
-                       cur_token()->value()->Equals("declare")) {
+                       cur_token()->value()->Is(Atom::kDeclare)) {
               auto ambient_decl_result = ParseAmbientDeclaration(false);
 
               if (ambient_decl_result) {
@@ -505,7 +512,7 @@ ParseResult Parser<UCharInputIterator>::ParseTSModuleBody() {
             }
         }
       } else if (cur_token()->Is(TokenKind::kIdentifier) &&
-                 cur_token()->value()->Equals("module")) {
+                 cur_token()->value()->Is(Atom::kModule)) {
         auto module_import_result = ParseModuleImport();
 
         if (module_import_result) {
@@ -564,7 +571,7 @@ ParseResult Parser<UCharInputIterator>::ParseExportDeclaration() {
         auto export_clause_result = ParseExportClause();
         CHECK_AST(export_clause_result);
         if (cur_token()->Is(TokenKind::kIdentifier) &&
-            cur_token()->value()->Equals("from")) {
+            cur_token()->value()->Is(Atom::kFrom)) {
           auto from_clause_result = ParseFromClause();
           CHECK_AST(from_clause_result);
           return Success(CreateExportView(export_clause_result.value(), from_clause_result.value(), &info, false));
@@ -595,7 +602,7 @@ ParseResult Parser<UCharInputIterator>::ParseExportDeclaration() {
       }
       default:
         if (cur_token()->Is(TokenKind::kIdentifier) &&
-            cur_token()->value()->Equals("declare")) {
+            cur_token()->value()->Is(Atom::kDeclare)) {
           auto ambient_decl_result = ParseAmbientDeclaration(true);
           CHECK_AST(ambient_decl_result);
           return Success(CreateExportView(ambient_decl_result.value(), ir::Node::Null(), &info, true));
@@ -639,7 +646,7 @@ ParseResult Parser<UCharInputIterator>::ParseExportClause() {
       auto identifier_result = ParseIdentifier();
       SKIP_TOKEN_OR(identifier_result, success, TokenKind::kRightBrace) {
         if (cur_token()->type() == TokenKind::kIdentifier &&
-            cur_token()->value()->Equals("as")) {
+            cur_token()->value()->Is(Atom::kAs)) {
           Next();
           auto binding_identifier_result = ParseIdentifier();
           SKIP_TOKEN_OR(binding_identifier_result, success, TokenKind::kRightBrace) {
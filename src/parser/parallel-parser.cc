@@ -0,0 +1,464 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2013 Taketoshi Aono(brn)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#include <algorithm>
+#include <thread>
+#include "./parallel-parser.h"
+#include "./scanner.h"
+#include "../ir/node-visitor.h"
+
+namespace yatsc {
+
+const size_t ParallelParser::kDefaultMinimumSegmentSize = 1024 * 16;
+
+
+ParallelParser::ParallelParser(const CompilerOption& compiler_option,
+                               const Notificator<void(const String&)>& notificator,
+                               Handle<ir::IRFactory> irfactory,
+                               Handle<ModuleInfo> module_info,
+                               Handle<ir::GlobalScope> global_scope,
+                               LiteralBuffer* literal_buffer,
+                               Handle<SourceTokenArray> token_array,
+                               size_t thread_count,
+                               size_t minimum_segment_size)
+    : compiler_option_(compiler_option),
+      notificator_(notificator),
+      irfactory_(irfactory),
+      module_info_(module_info),
+      global_scope_(global_scope),
+      literal_buffer_(literal_buffer),
+      token_array_(token_array),
+      thread_count_(std::max<size_t>(thread_count, 1)),
+      minimum_segment_size_(std::max<size_t>(minimum_segment_size, 1)),
+      sequential_(false) {}
+
+
+ParseResult ParallelParser::Parse() {
+  Split();
+  if (segments_.size() == 1) {
+    sequential_ = true;
+    return ParseSequentially();
+  }
+
+  // All segments are parsed in the child scopes of the module scope,
+  // so the declarations of the segments are not visible from the other segments until merged.
+  auto module_scope = Heap::NewHandle<ir::Scope>(Handle<ir::Scope>(), global_scope_);
+  
+  Vector<Handle<std::thread>> threads;
+  for (size_t i = 1; i < segments_.size(); i++) {
+    Handle<Segment> segment = segments_[i];
+    threads.push_back(Heap::NewHandle<std::thread>([segment, module_scope]() mutable {
+      segment->Parse(module_scope);
+    }));
+  }
+  segments_[0]->Parse(module_scope);
+
+  for (auto& thread: threads) {
+    thread->join();
+  }
+
+  for (auto& segment: segments_) {
+    if (!segment->Succeeded()) {
+      sequential_ = true;
+      return ParseSequentially();
+    }
+  }
+
+  return Merge(module_scope);
+}
+
+
+namespace {
+// Replace the scope of the segment with the module scope in the tree of the segment,
+// so the scopes of the merged tree are same as the scopes that the sequential parser makes.
+class SegmentScopeReplacer: public ir::NodeVisitor<SegmentScopeReplacer> {
+ public:
+  SegmentScopeReplacer(Handle<ir::Scope> segment_scope, Handle<ir::Scope> module_scope)
+      : segment_scope_(segment_scope),
+        module_scope_(module_scope) {}
+
+
+  // The scopes in the block are the children of the scope of the block.
+  ir::VisitResult EnterBlockView(ir::BlockView* node) {
+    if (node->scope()->parent_scope() == segment_scope_) {
+      node->scope()->set_parent_scope(module_scope_);
+    }
+    return ir::VisitResult::kSkipChildren;
+  }
+
+
+  ir::VisitResult EnterLazyFunctionBodyView(ir::LazyFunctionBodyView* node) {
+    if (node->scope() == segment_scope_) {
+      node->set_scope(module_scope_);
+    }
+    return ir::VisitResult::kSkipChildren;
+  }
+
+ private:
+  Handle<ir::Scope> segment_scope_;
+  Handle<ir::Scope> module_scope_;
+};
+
+
+// The meaning of the '/' that follows the token.
+enum class SlashMeaning: uint8_t {
+  kDivision,
+  kRegularExpression,
+  // The parser decides it by the statement, like the ')' of the if statement or the '}' of the block.
+  kEither
+};
+
+
+SlashMeaning GetSlashMeaning(TokenKind prev_type, bool prev_yield) {
+  switch (prev_type) {
+    case TokenKind::kIdentifier:
+      return prev_yield? SlashMeaning::kEither: SlashMeaning::kDivision;
+    case TokenKind::kRightParen:
+    case TokenKind::kRightBrace:
+      return SlashMeaning::kEither;
+    case TokenKind::kNumericLiteral:
+    case TokenKind::kOctalLiteral:
+    case TokenKind::kBinaryLiteral:
+    case TokenKind::kStringLiteral:
+    case TokenKind::kRegularExpr:
+    case TokenKind::kTemplateLiteral:
+    case TokenKind::kTrue:
+    case TokenKind::kFalse:
+    case TokenKind::kNull:
+    case TokenKind::kNan:
+    case TokenKind::kUndefined:
+    case TokenKind::kThis:
+    case TokenKind::kSuper:
+    case TokenKind::kRightBracket:
+    case TokenKind::kIncrement:
+    case TokenKind::kDecrement:
+      return SlashMeaning::kDivision;
+    default:
+      return SlashMeaning::kRegularExpression;
+  }
+}
+
+
+// The tokens that decide the statement boundaries.
+bool IsStructuralToken(TokenKind type) {
+  switch (type) {
+    case TokenKind::kLeftBrace:
+    case TokenKind::kRightBrace:
+    case TokenKind::kLeftParen:
+    case TokenKind::kRightParen:
+    case TokenKind::kLeftBracket:
+    case TokenKind::kRightBracket:
+    case TokenKind::kBackquote:
+    case TokenKind::kLineTerminator:
+      return true;
+    default:
+      return false;
+  }
+}
+}
+
+
+// The tokens are read by the scanner that is attached to the token array, same as the parser,
+// and the '/' and the '`' are scanned again as the regular expression and the template literal,
+// so the braces in them are not counted.
+// The module is split only after the ';' of the file scope statement
+// where the scanner returns the token of the token array.
+void ParallelParser::Split() {
+  size_t size = token_array_->size();
+  size_t segment_size = std::max(size / thread_count_, minimum_segment_size_);
+  size_t begin = 0;
+  size_t statement_begin = 0;
+  bool statement_known = true;
+  int depth = 0;
+  TokenKind prev_type = TokenKind::kLineTerminator;
+  bool prev_yield = false;
+  // True if the previous token is the ';' or the '}' of the file scope.
+  bool after_semicolon = false;
+  bool after_block = false;
+  
+  auto source_stream = module_info_->source_stream();
+  Scanner<SourceStream::iterator> scanner(
+      source_stream->begin(),
+      source_stream->end(),
+      literal_buffer_,
+      compiler_option_);
+  scanner.AttachTokenArray(token_array_);
+  
+  for (Token* token = scanner.Scan(); !token->Is(TokenKind::kEof); token = scanner.Scan()) {
+    if (after_semicolon || after_block) {
+      size_t index;
+      bool found = FindToken(*token, &index);
+      if (after_semicolon) {
+        bool cut = found && statement_known &&
+            index - begin >= segment_size &&
+            !IsContinuable(statement_begin) &&
+            IsStatementBeginning(index);
+        if (cut) {
+          segments_.push_back(Heap::NewHandle<Segment>(this, begin, index));
+          begin = index;
+        }
+        statement_known = found;
+        if (found) {
+          statement_begin = index;
+        }
+      } else if (found && IsStatementBeginning(index)) {
+        // The block of the declaration like the function or the class ends the statement without ';'.
+        statement_begin = index;
+        statement_known = true;
+      }
+    }
+    
+    TokenKind type = token->type();
+    switch (type) {
+      case TokenKind::kLeftBrace:
+      case TokenKind::kLeftParen:
+      case TokenKind::kLeftBracket:
+        depth++;
+        break;
+      case TokenKind::kRightBrace:
+      case TokenKind::kRightParen:
+      case TokenKind::kRightBracket:
+        depth--;
+        break;
+      case TokenKind::kBackquote: {
+        if (scanner.CheckTemplateLiteral(token) == nullptr) {
+          // The rest of the module can not be split without knowing the end of the template literal.
+          segments_.push_back(Heap::NewHandle<Segment>(this, begin, size));
+          return;
+        }
+        type = TokenKind::kTemplateLiteral;
+        break;
+      }
+      case TokenKind::kDiv: {
+        SlashMeaning meaning = GetSlashMeaning(prev_type, prev_yield);
+        if (meaning == SlashMeaning::kDivision) {
+          break;
+        }
+        size_t start_offset = token->source_position().start_offset();
+        auto rcp = scanner.char_position();
+        Token* regexp = scanner.CheckRegularExpression(token);
+        if (regexp == nullptr) {
+          // The '/' is the division, or the parser reports the error and the module is parsed sequentially.
+          scanner.RestoreScannerPosition(rcp);
+          break;
+        }
+        if (meaning == SlashMeaning::kEither &&
+            HasStructuralToken(start_offset + 1, regexp->source_position().end_offset())) {
+          // The statements are different whether the '/' is the division or not.
+          segments_.push_back(Heap::NewHandle<Segment>(this, begin, size));
+          return;
+        }
+        type = TokenKind::kRegularExpr;
+        break;
+      }
+      default:
+        break;
+    }
+
+    after_semicolon = type == TokenKind::kLineTerminator && depth == 0;
+    after_block = type == TokenKind::kRightBrace && depth == 0;
+    prev_type = type;
+    prev_yield = type == TokenKind::kIdentifier && token->value()->Is(Atom::kYield);
+  }
+
+  segments_.push_back(Heap::NewHandle<Segment>(this, begin, size));
+}
+
+
+bool ParallelParser::FindToken(const Token& token, size_t* index) const {
+  size_t found = LowerBound(token.source_position().start_offset());
+  if (found == token_array_->size()) {
+    return false;
+  }
+  const Token& candidate = token_array_->token(found);
+  if (candidate.type() != token.type() || !(candidate.source_position() == token.source_position())) {
+    return false;
+  }
+  *index = found;
+  return true;
+}
+
+
+bool ParallelParser::HasStructuralToken(size_t start_offset, size_t end_offset) const {
+  for (size_t i = LowerBound(start_offset); i < token_array_->size(); i++) {
+    const Token& token = token_array_->token(i);
+    if (token.source_position().start_offset() >= end_offset) {
+      break;
+    }
+    if (IsStructuralToken(token.type())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+
+size_t ParallelParser::LowerBound(size_t offset) const {
+  size_t low = 0;
+  size_t high = token_array_->size();
+  while (low < high) {
+    size_t middle = low + (high - low) / 2;
+    if (token_array_->token(middle).source_position().start_offset() < offset) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+
+bool ParallelParser::IsContinuable(size_t index) const {
+  auto is_declare = [&](size_t i) {
+    const Token& token = token_array_->token(i);
+    return token.Is(TokenKind::kIdentifier) && token.value()->Is(Atom::kDeclare);
+  };
+  
+  const Token& token = token_array_->token(index);
+  if (token.Is(TokenKind::kFunction) || is_declare(index)) {
+    return true;
+  }
+  
+  if (token.Is(TokenKind::kExport) && index + 1 < token_array_->size()) {
+    const Token& next = token_array_->token(index + 1);
+    return next.Is(TokenKind::kFunction) || next.Is(TokenKind::kDefault) || is_declare(index + 1);
+  }
+  return false;
+}
+
+
+bool ParallelParser::IsStatementBeginning(size_t index) const {
+  switch (token_array_->token(index).type()) {
+    case TokenKind::kVar:
+    case TokenKind::kLet:
+    case TokenKind::kConst:
+    case TokenKind::kClass:
+    case TokenKind::kFunction:
+    case TokenKind::kInterface:
+    case TokenKind::kEnum:
+    case TokenKind::kImport:
+    case TokenKind::kExport:
+    case TokenKind::kIf:
+    case TokenKind::kFor:
+    case TokenKind::kSwitch:
+    case TokenKind::kTry:
+    case TokenKind::kThrow:
+    case TokenKind::kIdentifier:
+    case TokenKind::kThis:
+    case TokenKind::kNew:
+    case TokenKind::kDelete:
+    case TokenKind::kTypeof:
+    case TokenKind::kVoid:
+      return true;
+    default:
+      return false;
+  }
+}
+
+
+ParseResult ParallelParser::Merge(Handle<ir::Scope> module_scope) {
+  auto file_scope = irfactory_->New<ir::FileScopeView>(module_scope);
+  
+  for (auto& segment: segments_) {
+    ir::Node* root = segment->root();
+    SegmentScopeReplacer replacer(segment->scope(), module_scope);
+    for (auto node: root->node_list()) {
+      replacer.Walk(node);
+      file_scope->InsertLast(node);
+    }
+    module_scope->Merge(segment->scope());
+    irfactory_->Adopt(segment->irfactory());
+    for (auto& module_name: segment->module_names()) {
+      notificator_.NotifyForKey("Parser::ModuleFound", module_name);
+    }
+  }
+  return Just<ir::Node*>(file_scope);
+}
+
+
+ParseResult ParallelParser::ParseSequentially() {
+  auto source_stream = module_info_->source_stream();
+  Scanner<SourceStream::iterator> scanner(
+      source_stream->begin(),
+      source_stream->end(),
+      literal_buffer_,
+      compiler_option_);
+  scanner.AttachTokenArray(token_array_);
+  
+  Parser<SourceStream::iterator> parser(compiler_option_, &scanner, notificator_, irfactory_, module_info_, global_scope_);
+  return parser.Parse();
+}
+
+
+ParallelParser::Segment::Segment(ParallelParser* parallel_parser, size_t begin, size_t end)
+    : parallel_parser_(parallel_parser),
+      begin_(begin),
+      end_(end),
+      irfactory_(Heap::NewHandle<ir::IRFactory>()),
+      module_info_(Heap::NewHandle<ModuleInfo>(*parallel_parser->module_info_, Heap::NewHandle<ErrorReporter>())) {
+  notificator_.AddListener("Parser::ModuleFound", [this](const String& module_name) {
+    module_names_.push_back(module_name);
+  });
+}
+
+
+void ParallelParser::Segment::Parse(Handle<ir::Scope> module_scope) {
+  const SourceTokenArray& tokens = *parallel_parser_->token_array_;
+  auto source_stream = module_info_->source_stream();
+  auto token_array = Heap::NewHandle<SourceTokenArray>();
+  
+  // The token before the segment is copied too,
+  // because the scanner returns to the source from the end of it.
+  size_t first = begin_ == 0? 0: begin_ - 1;
+  token_array->AppendRange(tokens, first, end_);
+
+  auto end = source_stream->end();
+  if (end_ < tokens.size()) {
+    // The segment ends with the eof at the end of the last token,
+    // and the scanner never reads the source after it.
+    const Token& last = tokens.token(end_ - 1);
+    size_t end_offset = last.source_position().end_offset();
+    end = source_stream->at(end_offset);
+    Token eof;
+    eof.set_source_position(SourcePosition(end_offset, end_offset));
+    token_array->Append(eof, SourceTokenArray::Cursor(end, UChar::Null(), tokens.cursor(end_ - 1).offset()));
+  }
+
+  Scanner<SourceStream::iterator> scanner(
+      source_stream->begin(),
+      end,
+      parallel_parser_->literal_buffer_,
+      parallel_parser_->compiler_option_);
+  scanner.AttachTokenArray(token_array, begin_ - first);
+
+  scope_ = Heap::NewHandle<ir::Scope>(module_scope, parallel_parser_->global_scope_);
+  Parser<SourceStream::iterator> parser(parallel_parser_->compiler_option_, &scanner, notificator_,
+                                        irfactory_, module_info_, parallel_parser_->global_scope_);
+  try {
+    result_ = parser.Parse(scope_);
+  } catch (const FatalParseError& fpe) {
+    result_ = Nothing<ir::Node*>();
+  }
+}
+
+} // namespace yatsc
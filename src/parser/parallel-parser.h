@@ -0,0 +1,177 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2013 Taketoshi Aono(brn)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+
+#ifndef PARSER_PARALLEL_PARSER_H_
+#define PARSER_PARALLEL_PARSER_H_
+
+#include "./parallel-scanner.h"
+#include "./parser.h"
+#include "./sourcestream.h"
+#include "./token-array.h"
+#include "../compiler/module-info.h"
+#include "../compiler-option.h"
+#include "../ir/irfactory.h"
+#include "../ir/scope.h"
+#include "../memory/heap.h"
+#include "../utils/notificator.h"
+#include "../utils/stl.h"
+#include "../utils/utils.h"
+
+
+namespace yatsc {
+
+// Parse the file scope statements of the module in parallel.
+// The tokens of the module are split into the segments after the ';' of the file scope statements,
+// and each segment is parsed by its own parser, irfactory, error reporter and scope.
+// The trees, the declarations and the found modules of the segments are merged in order,
+// so the result is same as the sequential parsing.
+// The split points are found by the scanner that rescans the regular expressions and the template literals
+// same as the parser, and the rest of the module is not split if the statements depend on the meaning of a '/'.
+// If any segment has errors, the whole module is parsed again sequentially
+// and the errors are reported by the sequential parser.
+class ParallelParser : private Uncopyable, private Unmovable {
+ public:
+  typedef ParallelScanner::SourceTokenArray SourceTokenArray;
+
+  ParallelParser(const CompilerOption& compiler_option,
+                 const Notificator<void(const String&)>& notificator,
+                 Handle<ir::IRFactory> irfactory,
+                 Handle<ModuleInfo> module_info,
+                 Handle<ir::GlobalScope> global_scope,
+                 LiteralBuffer* literal_buffer,
+                 Handle<SourceTokenArray> token_array,
+                 size_t thread_count,
+                 size_t minimum_segment_size = kDefaultMinimumSegmentSize);
+
+
+  // Parse the module and return the FileScopeView.
+  ParseResult Parse();
+
+
+  // The count of the segments which are parsed in parallel.
+  YATSC_CONST_GETTER(size_t, segment_count, segments_.size())
+
+
+  // True if the segments are discarded and the module is parsed sequentially.
+  YATSC_CONST_GETTER(bool, sequential, sequential_)
+
+
+  static const size_t kDefaultMinimumSegmentSize;
+  
+ private:
+  class Segment : private Uncopyable, private Unmovable {
+   public:
+    Segment(ParallelParser* parallel_parser, size_t begin, size_t end);
+
+
+    // Parse the tokens of the segment in the scope.
+    void Parse(Handle<ir::Scope> scope);
+
+
+    // Return true if the segment is parsed without any error.
+    bool Succeeded() const {
+      return result_ && !module_info_->HasError();
+    }
+
+
+    YATSC_CONST_GETTER(ir::Node*, root, result_.value())
+
+
+    YATSC_CONST_GETTER(Handle<ir::IRFactory>, irfactory, irfactory_)
+
+
+    YATSC_CONST_GETTER(Handle<ir::Scope>, scope, scope_)
+
+
+    // The modules which are found in the segment, in the order of the appearance.
+    YATSC_CONST_GETTER(const Vector<String>&, module_names, module_names_)
+    
+   private:
+    ParallelParser* parallel_parser_;
+
+    // The range of the tokens of the segment in the token array of the module.
+    size_t begin_;
+    size_t end_;
+    
+    Handle<ir::IRFactory> irfactory_;
+    Handle<ModuleInfo> module_info_;
+    Handle<ir::Scope> scope_;
+    ParseResult result_;
+    Notificator<void(const String&)> notificator_;
+    Vector<String> module_names_;
+  };
+
+
+  // Split the tokens into the segments.
+  void Split();
+
+
+  // Return true if the file scope statement that begins at the index may be merged with the next statement,
+  // like the overloads of the function.
+  bool IsContinuable(size_t index) const;
+
+
+  // Return true if the token of the index begins the file scope statement
+  // which is never a part of the previous statement.
+  bool IsStatementBeginning(size_t index) const;
+
+
+  // Find the index of the token of the token array that is same as the token.
+  // Return false if the token is not in the token array, like the token that is scanned in the regular expression.
+  bool FindToken(const Token& token, size_t* index) const;
+
+
+  // Return true if any token of the token array that begins in the range
+  // is the bracket, the backquote or the ';'.
+  bool HasStructuralToken(size_t start_offset, size_t end_offset) const;
+
+
+  // Return the index of the first token of the token array that begins at or after the offset.
+  size_t LowerBound(size_t offset) const;
+
+
+  // Stitch the results of the segments.
+  ParseResult Merge(Handle<ir::Scope> module_scope);
+
+
+  // Parse the entire module by the single parser.
+  ParseResult ParseSequentially();
+  
+  
+  const CompilerOption& compiler_option_;
+  const Notificator<void(const String&)>& notificator_;
+  Handle<ir::IRFactory> irfactory_;
+  Handle<ModuleInfo> module_info_;
+  Handle<ir::GlobalScope> global_scope_;
+  LiteralBuffer* literal_buffer_;
+  Handle<SourceTokenArray> token_array_;
+  size_t thread_count_;
+  size_t minimum_segment_size_;
+  bool sequential_;
+  Vector<Handle<Segment>> segments_;
+};
+
+} // namespace yatsc
+
+#endif // PARSER_PARALLEL_PARSER_H_
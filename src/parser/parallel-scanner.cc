@@ -0,0 +1,248 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2013 Taketoshi Aono(brn)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#include <algorithm>
+#include <thread>
+#include "./parallel-scanner.h"
+
+namespace yatsc {
+
+const size_t ParallelScanner::kDefaultMinimumChunkSize = 1024 * 512;
+
+
+ParallelScanner::ParallelScanner(Handle<SourceStream> source_stream,
+                                 LiteralBuffer* literal_buffer,
+                                 const CompilerOption& compiler_option,
+                                 size_t thread_count,
+                                 size_t minimum_chunk_size)
+    : source_stream_(source_stream),
+      literal_buffer_(literal_buffer),
+      compiler_option_(compiler_option),
+      thread_count_(thread_count),
+      minimum_chunk_size_(std::max<size_t>(minimum_chunk_size, 1)),
+      rescanned_token_count_(0) {}
+
+
+Handle<ParallelScanner::SourceTokenArray> ParallelScanner::Scan() {
+  Split();
+
+  Vector<Handle<std::thread>> threads;
+  for (size_t i = 1; i < chunks_.size(); i++) {
+    Handle<Chunk> chunk = chunks_[i];
+    threads.push_back(Heap::NewHandle<std::thread>([chunk]() mutable {
+      chunk->ScanSpeculatively();
+    }));
+  }
+  chunks_[0]->ScanSpeculatively();
+  
+  for (auto& thread: threads) {
+    thread->join();
+  }
+
+  ResolveSeams();
+
+  auto token_array = Heap::NewHandle<SourceTokenArray>();
+  for (auto& chunk: chunks_) {
+    chunk->CopyTo(token_array.Get());
+  }
+  return token_array;
+}
+
+
+void ParallelScanner::Split() {
+  size_t size = source_stream_->size();
+  size_t chunk_count = std::max<size_t>(std::min(thread_count_, size / minimum_chunk_size_), 1);
+  size_t chunk_size = size / chunk_count;
+  size_t begin = 0;
+  
+  for (size_t i = 1; i <= chunk_count && begin < size; i++) {
+    size_t end = i == chunk_count? size: FindChunkBegin(chunk_size * i);
+    if (end <= begin) {
+      continue;
+    }
+    chunks_.push_back(Heap::NewHandle<Chunk>(this, begin, end));
+    begin = end;
+  }
+
+  if (chunks_.empty()) {
+    chunks_.push_back(Heap::NewHandle<Chunk>(this, 0, size));
+  }
+}
+
+
+size_t ParallelScanner::FindChunkBegin(size_t offset) const {
+  const char* raw_buffer = source_stream_->raw_buffer();
+  size_t size = source_stream_->size();
+  const void* line_end = memchr(raw_buffer + offset, '\n', size - offset);
+  if (line_end == nullptr) {
+    return size;
+  }
+
+  // The first non white space character of the line is most likely the beginning of a token.
+  size_t begin = static_cast<const char*>(line_end) - raw_buffer + 1;
+  while (begin < size &&
+         (raw_buffer[begin] == ' ' || raw_buffer[begin] == '\t' ||
+          raw_buffer[begin] == '\r' || raw_buffer[begin] == '\n' ||
+          raw_buffer[begin] == '\v' || raw_buffer[begin] == '\f')) {
+    begin++;
+  }
+  return begin;
+}
+
+
+void ParallelScanner::ResolveSeams() {
+  Handle<Chunk> live = chunks_[0];
+  live->set_from(0);
+  
+  for (size_t i = 1; i < chunks_.size(); i++) {
+    Handle<Chunk> chunk = chunks_[i];
+    size_t index;
+    
+    while (!live->IsFinished()) {
+      if (chunk->FindSeam(*live, &index)) {
+        live->set_to(live->size());
+        chunk->set_from(index + 1);
+        live = chunk;
+        break;
+      }
+
+      if (chunk->size() == 0 || live->last_offset() > chunk->last_offset()) {
+        // The previous scanner passed over the entire chunk.
+        break;
+      }
+      
+      live->ScanNext();
+      rescanned_token_count_++;
+    }
+  }
+
+  while (!live->IsFinished()) {
+    live->ScanNext();
+    rescanned_token_count_++;
+  }
+  live->set_to(live->size());
+}
+
+
+ParallelScanner::Chunk::Chunk(ParallelScanner* parallel_scanner, size_t begin, size_t end)
+    : parallel_scanner_(parallel_scanner),
+      begin_(begin),
+      end_(end),
+      from_(0),
+      to_(0),
+      scanner_(parallel_scanner->source_stream_->at(begin),
+               parallel_scanner->source_stream_->end(),
+               parallel_scanner->literal_buffer_,
+               parallel_scanner->compiler_option_) {
+  scanner_.SetErrorCallback([this](const char* message, const SourcePosition& source_position) {
+    tokens_.AppendError(tokens_.size(), message, source_position);
+  });
+  
+  scanner_.SetReferencePathCallback([this](const Literal* path) {
+    tokens_.AppendReference(tokens_.size(), path);
+  });
+}
+
+
+void ParallelScanner::Chunk::ScanSpeculatively() {
+  bool crossed = false;
+  while (!crossed && !IsFinished()) {
+    crossed = !offsets_.empty() && offsets_.back() > end_;
+    ScanNext();
+  }
+}
+
+
+void ParallelScanner::Chunk::ScanNext() {
+  Token* token = scanner_.Scan();
+  auto rcp = scanner_.char_position();
+  tokens_.Append(*token, SourceTokenArray::Cursor(
+      rcp.ucii(), rcp.current(), begin_ + rcp.ssp().current_offset()));
+
+  // The scanner position is the next of the current character,
+  // and the end of the source is distinguished by the null character.
+  size_t offset = rcp.ucii().base() - parallel_scanner_->source_stream_->raw_buffer();
+  offsets_.push_back(rcp.current() == unicode::u32('\0')? offset + 1: offset);
+}
+
+
+bool ParallelScanner::Chunk::FindSeam(const Chunk& chunk, size_t* index) const {
+  auto found = std::lower_bound(offsets_.begin(), offsets_.end(), chunk.last_offset());
+  if (found == offsets_.end() || *found != chunk.last_offset()) {
+    return false;
+  }
+
+  size_t i = found - offsets_.begin();
+  const Token& token = tokens_.token(i);
+  const Token& last = chunk.tokens_.token(chunk.size() - 1);
+  const SourcePosition& sp = token.source_position();
+  const SourcePosition& last_sp = last.source_position();
+  
+  if (token.type() == last.type() &&
+      token.value() == last.value() &&
+      begin_ + sp.start_offset() == chunk.begin_ + last_sp.start_offset() &&
+      sp.length() == last_sp.length()) {
+    *index = i;
+    return true;
+  }
+  return false;
+}
+
+
+void ParallelScanner::Chunk::CopyTo(SourceTokenArray* token_array) const {
+  if (from_ >= to_) {
+    return;
+  }
+  
+  size_t base = token_array->size();
+  auto rebase = [&](const SourcePosition& sp) {
+    return SourcePosition(begin_ + sp.start_offset(), begin_ + sp.end_offset());
+  };
+
+  token_array->Reserve(base + to_ - from_);
+  for (size_t i = from_; i < to_; i++) {
+    Token token = tokens_.token(i);
+    token.set_source_position(rebase(token.source_position()));
+    const CommentRange& comment_range = token.comment_range();
+    if (!comment_range.IsEmpty()) {
+      token.set_comment_range(CommentRange(begin_ + comment_range.begin(), begin_ + comment_range.end()));
+    }
+    auto& cursor = tokens_.cursor(i);
+    token_array->Append(token, SourceTokenArray::Cursor(
+        cursor.it(), cursor.current(), cursor.offset()));
+  }
+
+  for (auto& error: tokens_.errors()) {
+    if (error.index() >= from_ && error.index() < to_) {
+      token_array->AppendError(base + error.index() - from_, error.message(), rebase(error.source_position()));
+    }
+  }
+
+  for (auto& reference: tokens_.references()) {
+    if (reference.index() >= from_ && reference.index() < to_) {
+      token_array->AppendReference(base + reference.index() - from_, reference.path());
+    }
+  }
+}
+
+} // namespace yatsc
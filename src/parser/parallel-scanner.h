@@ -0,0 +1,148 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2013 Taketoshi Aono(brn)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#ifndef PARSER_PARALLEL_SCANNER_H_
+#define PARSER_PARALLEL_SCANNER_H_
+
+#include "./scanner.h"
+#include "./sourcestream.h"
+#include "./token-array.h"
+#include "../compiler-option.h"
+#include "../memory/heap.h"
+#include "../utils/stl.h"
+#include "../utils/utils.h"
+
+
+namespace yatsc {
+
+// Scan a large source by the multiple threads.
+// The source is splitted into the chunks at the beginning of the lines,
+// and each chunk is scanned speculatively from there.
+// A chunk may begin inside of the multi line comment or the string literal,
+// so every seam of the chunks is validated by the scanner of the previous chunk.
+// The previous scanner continues to scan until it reaches the end of the
+// same token in the next chunk, and the tokens of the next chunk are used
+// from there.
+class ParallelScanner : private Uncopyable, private Unmovable {
+ public:
+  typedef TokenArray<SourceStream::iterator> SourceTokenArray;
+
+  ParallelScanner(Handle<SourceStream> source_stream,
+                  LiteralBuffer* literal_buffer,
+                  const CompilerOption& compiler_option,
+                  size_t thread_count,
+                  size_t minimum_chunk_size = kDefaultMinimumChunkSize);
+
+
+  // Scan the entire source and return the tokens.
+  Handle<SourceTokenArray> Scan();
+
+
+  // The count of the chunks which are scanned in parallel.
+  YATSC_CONST_GETTER(size_t, chunk_count, chunks_.size())
+
+
+  // The count of the tokens which are scanned again to validate the seams.
+  YATSC_CONST_GETTER(size_t, rescanned_token_count, rescanned_token_count_)
+
+  
+  static const size_t kDefaultMinimumChunkSize;
+  
+ private:
+  class Chunk : private Uncopyable, private Unmovable {
+   public:
+    Chunk(ParallelScanner* parallel_scanner, size_t begin, size_t end);
+
+
+    // Scan tokens until the token that begins after the end of this chunk.
+    void ScanSpeculatively();
+
+
+    // Scan the next token.
+    void ScanNext();
+
+
+    // Return true if the last token is kEof.
+    bool IsFinished() const {
+      return tokens_.size() > 0 && tokens_.token(tokens_.size() - 1).Is(TokenKind::kEof);
+    }
+
+
+    // Find the token which ends at the same position with the last token of the chunk.
+    bool FindSeam(const Chunk& chunk, size_t* index) const;
+
+
+    // Append tokens of the range to the token array.
+    void CopyTo(SourceTokenArray* token_array) const;
+
+
+    YATSC_CONST_PROPERTY(size_t, from, from_)
+
+
+    YATSC_CONST_PROPERTY(size_t, to, to_)
+
+
+    YATSC_CONST_GETTER(size_t, size, tokens_.size())
+
+
+    YATSC_CONST_GETTER(size_t, last_offset, offsets_.back())    
+   private:
+    ParallelScanner* parallel_scanner_;
+    size_t begin_;
+    size_t end_;
+    size_t from_;
+    size_t to_;
+    Scanner<SourceStream::iterator> scanner_;
+
+    // The tokens which offsets are relative from the beginning of the chunk.
+    SourceTokenArray tokens_;
+
+    // The byte offsets of the scanner position after each token.
+    Vector<size_t> offsets_;
+  };
+
+
+  // Split the source into the chunks.
+  void Split();
+
+
+  // Decide the range of the tokens which are used in each chunks.
+  void ResolveSeams();
+
+
+  // Return the beginning of the line that follows the offset.
+  size_t FindChunkBegin(size_t offset) const;
+  
+  
+  Handle<SourceStream> source_stream_;
+  LiteralBuffer* literal_buffer_;
+  const CompilerOption& compiler_option_;
+  size_t thread_count_;
+  size_t minimum_chunk_size_;
+  size_t rescanned_token_count_;
+  Vector<Handle<Chunk>> chunks_;
+};
+
+} // namespace yatsc
+
+#endif // PARSER_PARALLEL_SCANNER_H_
@@ -66,8 +66,15 @@ class ParserBase: private Uncopyable, private Unmovable {
   }
 
 
-  YATSC_INLINE Handle<ir::Symbol> NewSymbol(ir::SymbolType type, const Literal* value) {
-    return Heap::NewHandle<ir::Symbol>(type, value);
+  YATSC_INLINE ir::Symbol* NewSymbol(ir::SymbolType type, const Literal* value) {
+    return irfactory_->NewSymbol(type, value);
+  }
+
+
+  // The interned symbol is shared by the other nodes,
+  // so the node is changed to refer the symbol of the new type instead of modifying the symbol.
+  YATSC_INLINE void ChangeSymbolType(ir::Node* node, ir::SymbolType type) {
+    node->set_symbol(NewSymbol(type, node->symbol()->value()));
   }
 
 
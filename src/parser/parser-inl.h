@@ -29,6 +29,9 @@ template <typename UCharInputIterator>
 Token* Parser<UCharInputIterator>::Next() {
   if (current_token_info_ != nullptr && !current_token_info_->Is(TokenKind::kEof)) {
     prev_token_info_ = *current_token_info_;
+    if (IsInRecordMode()) {
+      token_log_.push_back(prev_token_info_);
+    }
   }
   current_token_info_ = scanner_->Scan();
   
@@ -57,6 +60,16 @@ Token* Parser<UCharInputIterator>::prev_token() YATSC_NOEXCEPT {
 }
 
 
+template <typename UCharInputIterator>
+uint8_t Parser<UCharInputIterator>::BinaryOperatorPriority() YATSC_NOEXCEPT {
+  // The 'in' is not the operator in the for-in initializer.
+  if (cur_token()->Is(TokenKind::kIn) && state_.IsInNoInExpr()) {
+    return 0;
+  }
+  return Token::GetOperandPriority(cur_token()->type());
+}
+
+
 template <typename UCharInputIterator>
 bool Parser<UCharInputIterator>::IsLineTermination() YATSC_NOEXCEPT {
   return cur_token()->type() == TokenKind::kLineTerminator ||
@@ -130,8 +143,8 @@ void Parser<UCharInputIterator>::SkipToNextStatement() {
         })) {
       break;
     } else if (cur_token()->Is(TokenKind::kIdentifier) &&
-               (cur_token()->value()->Equals("declare") ||
-                cur_token()->value()->Equals("module"))) {
+               (cur_token()->value()->Is(Atom::kDeclare) ||
+                cur_token()->value()->Is(Atom::kModule))) {
       break;
     }
     Next();
@@ -161,9 +174,23 @@ void Parser<UCharInputIterator>::Initialize() YATSC_NOEXCEPT {
 
 
 template <typename UCharInputIterator>
-typename Parser<UCharInputIterator>::RecordedParserState Parser<UCharInputIterator>::parser_state() YATSC_NOEXCEPT {
+typename Parser<UCharInputIterator>::Checkpoint Parser<UCharInputIterator>::parser_state() YATSC_NOEXCEPT {
   EnterRecordMode();
-  
+  return Checkpoint(
+      this,
+      scanner_->char_position(),
+      token_log_.size(),
+      cur_token()->type(),
+      scope_.Get(),
+      scope_->declaration_count(),
+      enclosure_balancer_,
+      state_.depth(),
+      module_info_->error_reporter()->size());
+}
+
+
+template <typename UCharInputIterator>
+typename Parser<UCharInputIterator>::RecordedParserState Parser<UCharInputIterator>::CaptureParserState() YATSC_NOEXCEPT {
   Token prev;
   Token current;
   Handle<ir::Scope> scope;
@@ -191,23 +218,120 @@ typename Parser<UCharInputIterator>::RecordedParserState Parser<UCharInputIterat
 
 
 template <typename UCharInputIterator>
-void Parser<UCharInputIterator>::RestoreParserState(const RecordedParserState& rps) YATSC_NOEXCEPT {
-  ExitRecordMode();
+void Parser<UCharInputIterator>::RestoreParserState(const Checkpoint& checkpoint) YATSC_NOEXCEPT {
+  scanner_->RestoreScannerPosition(checkpoint.rcp());
+
+  // The token that was current at the checkpoint is logged when it is left,
+  // and the token just before it is the previous token.
+  size_t token_index = checkpoint.token_index();
+  if (token_log_.size() > token_index) {
+    *current_token_info_ = token_log_[token_index];
+    prev_token_info_ = token_log_[token_index - 1];
+    token_log_.erase(token_log_.begin() + token_index, token_log_.end());
+  }
+  // The type of the current token may be rewritten after the checkpoint.
+  current_token_info_->set_type(checkpoint.current_type());
+
+  // The scopes that are entered after the checkpoint are the descendants of the checkpoint scope.
+  while (scope_.Get() != checkpoint.scope()) {
+    ASSERT(true, scope_->parent_scope());
+    Handle<ir::Scope> parent = scope_->parent_scope();
+    scope_ = parent;
+  }
+  scope_->UndoDeclarations(checkpoint.declaration_count());
+  
+  enclosure_balancer_ = checkpoint.enclosure_balancer();
+  state_.Rewind(checkpoint.state_depth());
   
+  Handle<ErrorReporter> se = module_info_->error_reporter();
+  if (se->size() != checkpoint.error_count()) {
+    int diff = abs(static_cast<int>(checkpoint.error_count()) - static_cast<int>(se->size()));
+    for (int i = 0; i < diff; i++) {
+      se->Pop();
+    }
+  }
+}
+
+
+template <typename UCharInputIterator>
+void Parser<UCharInputIterator>::ApplyParserState(const RecordedParserState& rps) YATSC_NOEXCEPT {
   scanner_->RestoreScannerPosition(rps.rcp());
-  *current_token_info_ = rps.current();
-  prev_token_info_ = rps.prev();
+  SetTokens(rps.current(), rps.prev());
   scope_ = rps.scope();
   enclosure_balancer_ = rps.enclosure_balancer();
-  Handle<ErrorReporter> se = module_info_->error_reporter();
   state_ = std::move(rps.state());
+}
+
+
+// The context of the memo key.
+// The result of the rule depends on these states,
+// so the rule that is parsed in the different context is not shared.
+template <typename UCharInputIterator>
+uint64_t Parser<UCharInputIterator>::MemoKey(MemoRule rule) YATSC_NOEXCEPT {
+  uint8_t context =
+      (state_.IsInFunction()? 0x1: 0) |
+      (state_.IsInGenerator()? 0x2: 0) |
+      (state_.IsInIteration()? 0x4: 0) |
+      (state_.IsInCaseBlock()? 0x8: 0) |
+      (state_.IsInNoInExpr()? 0x10: 0) |
+      (scanner_->IsGenericMode()? 0x20: 0);
+  return ParsedMemo::MakeKey(static_cast<uint8_t>(rule), context, cur_token()->source_position().start_offset());
+}
+
+
+// Parse the rule with the packrat memo.
+// Only the successful result that reports no error is memoized,
+// because the reported errors are discarded when the parser state is restored.
+// The short rule is not memoized, parsing it again is cheaper than recording the state.
+// The memoized result is reused only in the same scope,
+// the rule which is parsed in the other scope is parsed again.
+template <typename UCharInputIterator>
+template <typename Fn>
+ParseResult Parser<UCharInputIterator>::Memoize(MemoRule rule, Fn fn) {
+  uint64_t key = MemoKey(rule);
+  Parsed** found = memo_.Find(key);
+  if (found != nullptr && (*found)->scope() == scope_) {
+    ApplyParserState((*found)->parser_state());
+    return (*found)->parse_result();
+  }
+
+  Handle<ir::Scope> scope = scope_;
+  size_t error_count = module_info_->error_reporter()->size();
+  uint32_t start_offset = cur_token()->source_position().start_offset();
+  ParseResult result = fn();
   
-  if (se->size() != rps.error_count()) {
-    int diff = abs(static_cast<int>(rps.error_count()) - static_cast<int>(se->size()));
-    for (int i = 0; i < diff; i++) {
-      se->Pop();
+  if (result &&
+      module_info_->error_reporter()->size() == error_count &&
+      cur_token()->source_position().start_offset() - start_offset >= kMemoizableLength) {
+    Parsed*& slot = memo_.Insert(key);
+    if (slot == nullptr) {
+      slot = this->unsafe_zone_allocator_->template New<Parsed>(result, CaptureParserState(), scope);
+    } else {
+      // Reuse the memory of the evicted record.
+      slot->~Parsed();
+      new(slot) Parsed(result, CaptureParserState(), scope);
     }
   }
+  return result;
+}
+
+
+template <typename UCharInputIterator>
+void Parser<UCharInputIterator>::AddFileScopeStatement(ir::Node* file_scope, ir::Node* statement) {
+  if (compiler_option_.syntax_check_only()) {
+    DiscardIR();
+  } else {
+    file_scope->InsertLast(statement);
+  }
+}
+
+
+template <typename UCharInputIterator>
+void Parser<UCharInputIterator>::DiscardIR() {
+  // The memoized records are keyed by the token offset,
+  // and the parser never goes back to the discarded statements,
+  // so the records that refer the discarded nodes are never found.
+  irfactory_->Reset();
 }
 
 
@@ -27,7 +27,9 @@ namespace yatsc {
 
 class ParserState {
  public:
-  ParserState() = default;
+  ParserState()
+      : state_bit_(0) {}
+
 
   enum class State: uint8_t {
     kFunction = 0,
@@ -112,6 +114,17 @@ class ParserState {
 
   YATSC_INLINE bool IsReturnable() YATSC_NO_SE {return IsInFunction() || IsInGenerator();}
 
+  // The depth of the state stack, used as the mark of the Rewind.
+  YATSC_INLINE size_t depth() YATSC_NO_SE {return state_.size();}
+
+  // Pop the states that are pushed after the depth was taken.
+  // The flags are cleared same as the copy of the ParserState.
+  YATSC_INLINE void Rewind(size_t depth) {
+    ASSERT(true, state_.size() >= depth);
+    state_.resize(depth);
+    state_bit_ = 0;
+  }
+
   friend void swap(yatsc::ParserState& a, yatsc::ParserState& b) YATSC_NOEXCEPT {
     a.Swap(b);
   }
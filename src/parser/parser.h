@@ -31,6 +31,7 @@
 #include "../compiler/module-info.h"
 #include "../utils/path.h"
 #include "../utils/maybe.h"
+#include "./memo-table.h"
 #include "./parser-state.h"
 
 
@@ -145,7 +146,7 @@ namespace yatsc {
   } else {                                                              \
     phase_buffer_ << indent_ << "Enter " << #name << ": CurrentToken = null,generic?[" << scanner_->nested_generic_count() << ']'; \
   }                                                                     \
-  phase_buffer_ << cur_token()->source_position().start_line_number() << '\n'; \
+  phase_buffer_ << module_info_->source_stream()->GetLineNumber(cur_token()->source_position().start_offset()) << '\n'; \
   indent_ += "  ";                                                      \
   auto err_size = module_info_->error_reporter()->size();               \
   YATSC_SCOPED([&]{                                                     \
@@ -155,7 +156,7 @@ namespace yatsc {
     } else {                                                            \
       phase_buffer_ << indent_ << "Exit " << #name << ": CurrentToken = null,generic?[" << scanner_->nested_generic_count() << "]"<< (err_size != module_info_->error_reporter()->size()? "[Error!]": ""); \
     }                                                                   \
-    phase_buffer_ << cur_token()->source_position().start_line_number() << '\n'; \
+    phase_buffer_ << module_info_->source_stream()->GetLineNumber(cur_token()->source_position().start_offset()) << '\n'; \
   })
 #else
 // Disabled.
@@ -190,6 +191,12 @@ class Parser: public ParserBase {
         module_info_(module_info),
         global_scope_(global_scope) {Initialize();}
 
+
+  ~Parser() {
+    // The records are allocated from the zone, so only the destructor is called.
+    memo_.ForEach([](Parsed* parsed) {parsed->~Parsed();});
+  }
+
   ParseResult Parse() {
     if (module_info_->IsDefinitionFile()) {
       return ParseDeclarationModule();
@@ -198,6 +205,21 @@ class Parser: public ParserBase {
     }
   }
 
+
+  // Parse the module in the scope instead of the new module scope.
+  // The ParallelParser parses each segment of the module in its own scope.
+  ParseResult Parse(Handle<ir::Scope> scope) {
+    set_current_scope(scope);
+    return Parse();
+  }
+
+
+  // Parse the function body that is skipped by the preparser,
+  // and replace the LazyFunctionBodyView child of the function with the parsed body.
+  // The body may be skipped by the other parser of the same module.
+  // Return Failed if the function has no skipped body.
+  ParseResult ParseLazyFunctionBody(ir::Node* function);
+
  private:  
   
   /**
@@ -339,24 +361,135 @@ class Parser: public ParserBase {
   };
 
 
-  class Parsed: public RbTreeNode<SourcePosition, Parsed*> {
+  // The cheap snapshot of the parser that is taken before the speculative parsing.
+  // Unlike the RecordedParserState, the checkpoint holds only the positions,
+  // the tokens are restored from the token log, the scope is found from the current scope chain
+  // and the state stack and the declarations of the scope are rewound to the recorded depth.
+  // The parser is in the record mode while the checkpoint is alive.
+  class Checkpoint {
+   public:
+    Checkpoint(Parser* parser,
+               const typename Scanner<UCharInputSourceIterator>::RecordedCharPosition& rcp,
+               size_t token_index,
+               TokenKind current_type,
+               ir::Scope* scope,
+               size_t declaration_count,
+               const EnclosureBalancer& enclosure_balancer,
+               size_t state_depth,
+               size_t error_count)
+        : parser_(parser),
+          rcp_(rcp),
+          token_index_(token_index),
+          current_type_(current_type),
+          scope_(scope),
+          declaration_count_(declaration_count),
+          enclosure_balancer_(enclosure_balancer),
+          state_depth_(state_depth),
+          error_count_(error_count) {}
+
+
+    Checkpoint(Checkpoint&& checkpoint)
+        : parser_(checkpoint.parser_),
+          rcp_(checkpoint.rcp_),
+          token_index_(checkpoint.token_index_),
+          current_type_(checkpoint.current_type_),
+          scope_(checkpoint.scope_),
+          declaration_count_(checkpoint.declaration_count_),
+          enclosure_balancer_(checkpoint.enclosure_balancer_),
+          state_depth_(checkpoint.state_depth_),
+          error_count_(checkpoint.error_count_) {
+      checkpoint.parser_ = nullptr;
+    }
+
+
+    Checkpoint(const Checkpoint&) = delete;
+
+
+    Checkpoint& operator = (const Checkpoint&) = delete;
+
+
+    ~Checkpoint() {
+      if (parser_ != nullptr) {
+        parser_->ExitRecordMode();
+      }
+    }
+    
+
+    YATSC_CONST_GETTER(typename Scanner<UCharInputSourceIterator>::RecordedCharPosition, rcp, rcp_)
+
+
+    YATSC_CONST_GETTER(size_t, token_index, token_index_)
+
+
+    YATSC_CONST_GETTER(TokenKind, current_type, current_type_)
+
+
+    YATSC_CONST_GETTER(ir::Scope*, scope, scope_)
+
+
+    YATSC_CONST_GETTER(size_t, declaration_count, declaration_count_)
+
+    
+    YATSC_CONST_GETTER(const EnclosureBalancer&, enclosure_balancer, enclosure_balancer_)
+
+
+    YATSC_CONST_GETTER(size_t, state_depth, state_depth_)
+
+    
+    YATSC_CONST_GETTER(size_t, error_count, error_count_)
+
+   private:
+    Parser* parser_;
+    typename Scanner<UCharInputSourceIterator>::RecordedCharPosition rcp_;
+    size_t token_index_;
+    TokenKind current_type_;
+    ir::Scope* scope_;
+    size_t declaration_count_;
+    EnclosureBalancer enclosure_balancer_;
+    size_t state_depth_;
+    size_t error_count_;
+  };
+
+
+  // The rules that are memoized by the packrat memo.
+  enum class MemoRule: uint8_t {
+    kAssignmentExpression = 1,
+    kLeftHandSideExpression
+  };
+  
+
+  // The memoized result of the rule.
+  // The parser_state is the state after the rule is parsed,
+  // and the scope is the scope that the rule was started in.
+  class Parsed {
    public:
-    explicit Parsed(ParseResult parse_result, RecordedParserState rps)
-        : RbTreeNode<SourcePosition, Parsed*>(),
-        parse_result_(parse_result),
-        parser_state_(rps) {}
+    explicit Parsed(ParseResult parse_result, RecordedParserState rps, Handle<ir::Scope> scope)
+        : parse_result_(parse_result),
+          parser_state_(rps),
+          scope_(scope) {}
 
     YATSC_GETTER(ParseResult, parse_result, parse_result_)
 
 
     YATSC_GETTER(RecordedParserState, parser_state, parser_state_)
+
+
+    YATSC_CONST_GETTER(Handle<ir::Scope>, scope, scope_)
     
    private:
     ParseResult parse_result_;
     RecordedParserState parser_state_;
+    Handle<ir::Scope> scope_;
   };
 
 
+  typedef MemoTable<Parsed*> ParsedMemo;
+
+
+  // The minimum length of the source that the memoized rule consumes.
+  static const uint32_t kMemoizableLength = 32;
+
+
   template <bool Print>
   class DebugStream {
    public:
@@ -409,29 +542,55 @@ class Parser: public ParserBase {
   void Initialize() YATSC_NOEXCEPT;
   
 
-  RecordedParserState parser_state() YATSC_NOEXCEPT;
+  // Take the checkpoint of the parser and enter the record mode.
+  Checkpoint parser_state() YATSC_NOEXCEPT;
 
   
-  void RestoreParserState(const RecordedParserState& rps) YATSC_NOEXCEPT;
-  
+  // Rewind the parser to the checkpoint and discard the errors reported after it.
+  void RestoreParserState(const Checkpoint& checkpoint) YATSC_NOEXCEPT;
 
-  ParseResult& Memoize(const SourcePosition& sp, ParseResult& result) YATSC_NOEXCEPT {
-    auto record = this->unsafe_zone_allocator_->template New<Parsed>(result, parser_state());
-    memo_.Insert(sp, record);
-    return result;
-  }
 
+  // Capture the whole parser state.
+  // Unlike the checkpoint, the state can be applied after the record mode is exited,
+  // so it is used for the memoized records.
+  RecordedParserState CaptureParserState() YATSC_NOEXCEPT;
 
-  Parsed* GetMemoizedRecord(const SourcePosition& sp) YATSC_NOEXCEPT {
-    return memo_.Find(sp);
-  }
+
+  // Restore the parser state,
+  // the reported errors are not discarded.
+  void ApplyParserState(const RecordedParserState& rps) YATSC_NOEXCEPT;
+
+
+  // Parse the rule by fn, or return the memoized result
+  // if the rule is already parsed at the current token in the same context.
+  template <typename Fn>
+  ParseResult Memoize(MemoRule rule, Fn fn);
+
+
+  // Return the key of the memo for the rule at the current token.
+  uint64_t MemoKey(MemoRule rule) YATSC_NOEXCEPT;
 
 
   YATSC_INLINE void Declare(ir::Node* node) {
-    scope_->Declare(node);
+    // The declarations refer the nodes, so nothing is declared
+    // while the ir is discarded by the syntax check.
+    if (!compiler_option_.syntax_check_only()) {
+      scope_->Declare(node);
+    }
   }
 
 
+  // Append the file scope statement to the file scope,
+  // or discard the ir if the parser only validates the syntax.
+  void AddFileScopeStatement(ir::Node* file_scope, ir::Node* statement);
+
+
+  // Discard all ir created by the irfactory.
+  // This must be called only at the top level of the file scope,
+  // because no node is alive there except the statements which are already discarded.
+  void DiscardIR();
+
+
   YATSC_PROPERTY(Handle<ir::Scope>, current_scope, scope_)
 
 
@@ -495,10 +654,34 @@ class Parser: public ParserBase {
   YATSC_INLINE bool IsInRecordMode() YATSC_NO_SE {return record_mode_ != 0;}
 
 
-  YATSC_INLINE void EnterRecordMode() {record_mode_++;}
+  // While the parser is in the record mode, every token that leaves the current token
+  // is appended to the token log, so the last token of the log is always the previous token.
+  YATSC_INLINE void EnterRecordMode() {
+    if (record_mode_++ == 0) {
+      token_log_.push_back(prev_token_info_);
+    }
+  }
+
 
+  YATSC_INLINE void ExitRecordMode() {
+    if (--record_mode_ == 0) {
+      token_log_.clear();
+    }
+  }
 
-  YATSC_INLINE void ExitRecordMode() {record_mode_--;}
+
+  // Replace the current and the previous token without scanning,
+  // the replaced current token is logged to keep the token log consistent.
+  void SetTokens(const Token& current, const Token& prev) {
+    if (IsInRecordMode()) {
+      token_log_.push_back(*current_token_info_);
+    }
+    *current_token_info_ = current;
+    prev_token_info_ = prev;
+    if (IsInRecordMode()) {
+      token_log_.push_back(prev_token_info_);
+    }
+  }
 
 
   template <typename T>
@@ -533,7 +716,8 @@ class Parser: public ParserBase {
   Handle<ModuleInfo> module_info_;
   Handle<ir::Scope> scope_;
   LazyInitializer<UnsafeZoneAllocator> unsafe_zone_allocator_;
-  IntrusiveRbTree<SourcePosition, Parsed*> memo_;
+  ParsedMemo memo_;
+  Vector<Token> token_log_;
   Handle<ir::GlobalScope> global_scope_;
   EnclosureBalancer enclosure_balancer_;
   ParserState state_;
@@ -668,6 +852,19 @@ class Parser: public ParserBase {
 
   ParseResult ParseFunctionBody(bool generator);
 
+
+  // Parse the statements of the function body into the BlockView.
+  ParseResult ParseEagerFunctionBody(bool generator);
+
+
+  // Skip the function body by counting the balanced braces,
+  // and return the LazyFunctionBodyView.
+  ParseResult PreparseFunctionBody(bool generator);
+
+
+  // Whether the '/' that follows the token of the type starts the regular expression or not.
+  static bool IsRegularExpressionAllowed(TokenKind type);
+
   ParseResult ParseTypeExpression();
 
   ParseResult ParseType();
@@ -699,18 +896,18 @@ class Parser: public ParserBase {
 
   ParseResult ParseCoveredTypeExpression();
 
-  ParseResult ParseCoveredExpressionSuffix(bool invalid_arrow_param, bool has_types, ir::Node* type_arguments, const ir::Node::List& covered_expr_node_list);
+  ParseResult ParseCoveredExpressionSuffix(bool invalid_arrow_param, bool has_types, ir::Node* type_arguments, const Vector<ir::Node*>& covered_expr_node_list);
 
   bool IsParsibleAsArrowFunctionFormalParameterList();
 
   // Parse expression.
-  ParseResult ParseAsArrowFunction(ir::Node* type_list, const ir::Node::List&, ir::Node* ret_type);
+  ParseResult ParseAsArrowFunction(ir::Node* type_list, const Vector<ir::Node*>&, ir::Node* ret_type);
 
   // Parse expression.
-  ParseResult ParseAsTypeAssertion(ir::Node* type_list, const ir::Node::List&);
+  ParseResult ParseAsTypeAssertion(ir::Node* type_list, const Vector<ir::Node*>&);
 
   // Parse expression.
-  ParseResult ParseAsExpression(const ir::Node::List&);
+  ParseResult ParseAsExpression(const Vector<ir::Node*>&);
   
   // Parse expression.
   ParseResult ParseExpression();
@@ -743,6 +940,9 @@ class Parser: public ParserBase {
   // Parse assignment expression.
   ParseResult ParseAssignmentExpression();
 
+  // Parse assignment expression without the packrat memo.
+  ParseResult ParseUnmemoizedAssignmentExpression();
+
   ParseResult ParseArrowFunction(ir::Node* identifier);
 
   ParseResult ParseArrowFunctionParameters(ir::Node* identifier);
@@ -752,20 +952,14 @@ class Parser: public ParserBase {
   // Parse conditional expression.
   ParseResult ParseConditionalExpression();
 
-#define DEF_PARSE_BINARY_EXPR(name)                         \
-  ParseResult Parse##name##Expression();
-
-  DEF_PARSE_BINARY_EXPR(LogicalOR);
-  DEF_PARSE_BINARY_EXPR(LogicalAND);
-  DEF_PARSE_BINARY_EXPR(BitwiseOR);
-  DEF_PARSE_BINARY_EXPR(BitwiseXOR);
-  DEF_PARSE_BINARY_EXPR(BitwiseAND);
-  DEF_PARSE_BINARY_EXPR(Equality);
-  DEF_PARSE_BINARY_EXPR(Relational);
-  DEF_PARSE_BINARY_EXPR(Shift);
-  DEF_PARSE_BINARY_EXPR(Additive);
-  DEF_PARSE_BINARY_EXPR(Multiplicative);
-#undef DEF_PARSE_BINARY_EXPR
+  // Parse binary expression that has only the operators
+  // which priority is higher than or equal to the priority.
+  ParseResult ParseBinaryExpression(uint8_t priority);
+
+
+  // Return the priority of the current token as the binary operator,
+  // or 0 if the current token is not the binary operator.
+  YATSC_INLINE uint8_t BinaryOperatorPriority() YATSC_NOEXCEPT;
 
   // Parse unary expression.
   ParseResult ParseUnaryExpression();
@@ -775,6 +969,8 @@ class Parser: public ParserBase {
 
   ParseResult ParseLeftHandSideExpression();
 
+  ParseResult ParseUnmemoizedLeftHandSideExpression();
+
   // Parse new expression.
   ParseResult ParseNewExpression();
   
@@ -956,8 +1152,7 @@ class Parser: public ParserBase {
   }
 
   void RestoreTokens(const TokenPack& token_pack) {
-    *current_token_info_ = token_pack.current_token();
-    prev_token_info_ = token_pack.prev_token();
+    SetTokens(token_pack.current_token(), token_pack.prev_token());
     scanner_->RestoreScannerPosition(token_pack.rcp());
   }
   
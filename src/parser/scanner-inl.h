@@ -40,6 +40,8 @@ Scanner<UCharInputIterator>::Scanner(
     LiteralBuffer* literal_buffer,
     const CompilerOption& compiler_option)
     : unscaned_(true),
+      in_token_array_(false),
+      token_index_(0),
       generic_type_(0),
       it_(it),
       end_(end),
@@ -68,6 +70,13 @@ void Scanner<UCharInputIterator>::Advance()  {
 
 template<typename UCharInputIterator>
 Token* Scanner<UCharInputIterator>::Scan() {
+  if (in_token_array_) {
+    if (ScanFromTokenArray()) {
+      return &token_info_;
+    }
+    LeaveTokenArray();
+  }
+  
   BeforeScan();
   
   if (!char_.IsAscii()) {
@@ -87,10 +96,78 @@ Token* Scanner<UCharInputIterator>::Scan() {
   }
 
   AfterScan();
+
+  if (token_array_) {
+    EnterTokenArrayIfMatched();
+  }
   return &token_info_;
 }
 
 
+template <typename UCharInputIterator>
+bool Scanner<UCharInputIterator>::ScanFromTokenArray() {
+  if (token_index_ >= token_array_->size()) {
+    return false;
+  }
+  
+  const Token& token = token_array_->token(token_index_);
+  if (IsGenericMode() && IsSplittedInGenericType(token.type())) {
+    return false;
+  }
+
+  // Errors are reported every time the token is scanned, same as scanning the source.
+  token_array_->Report(token_index_, error_callback_, reference_path_callback_);
+  token_info_ = token;
+  token_index_++;
+  return true;
+}
+
+
+template <typename UCharInputIterator>
+void Scanner<UCharInputIterator>::LeaveTokenArray() {
+  in_token_array_ = false;
+  if (token_index_ == 0) {
+    // The source is not scanned yet, so the scanner is already at the beginning.
+    return;
+  }
+
+  auto& cursor = token_array_->cursor(token_index_ - 1);
+  unscaned_ = false;
+  it_ = cursor.it();
+  char_ = cursor.current();
+  lookahead1_ = it_ == end_? UChar::Null(): *it_;
+  scanner_source_position_ = ScannerSourcePosition(cursor.offset());
+
+  // The comment which is skipped after the previous token belongs to the next token.
+  last_multi_line_comment_.Clear();
+  last_comment_range_ = CommentRange();
+  if (token_index_ < token_array_->size()) {
+    const Token& token = token_array_->token(token_index_);
+    last_comment_range_ = token.comment_range();
+    if (token.comment() != nullptr) {
+      last_multi_line_comment_ = *token.comment();
+    }
+  }
+}
+
+
+template <typename UCharInputIterator>
+void Scanner<UCharInputIterator>::EnterTokenArrayIfMatched() {
+  typename TokenArray<UCharInputIterator>::Cursor cursor(
+      it_, char_, scanner_source_position_.current_offset());
+  size_t index;
+  if (token_array_->Find(cursor, &index)) {
+    const Token& token = token_array_->token(index);
+    if (token.type() == token_info_.type() &&
+        token.value() == token_info_.value() &&
+        token.source_position() == token_info_.source_position()) {
+      token_index_ = index + 1;
+      in_token_array_ = true;
+    }
+  }
+}
+
+
 template <typename UCharInputIterator>
 Token* Scanner<UCharInputIterator>::Peek() {
   auto pos = char_position();
@@ -214,10 +291,15 @@ void Scanner<UCharInputIterator>::ScanDigit() {
       if (!LanguageModeUtil::IsOctalLiteralAllowed(compiler_option_)) {
         TOKEN_ERROR("Octal literals are not allowed in language mode " << LanguageModeUtil::ToString(compiler_option_));
       }
-      return ScanOctalLiteral();
+      return ScanLegacyOctalLiteral();
     } else if (lookahead1_ == unicode::u32('o') || lookahead1_ == unicode::u32('O')) {
+      if (!LanguageModeUtil::IsES6(compiler_option_)) {
+        TOKEN_ERROR("Octal literals with 0o prefix are not allowed in language mode " << LanguageModeUtil::ToString(compiler_option_));
+      }
+      return ScanOctalLiteral();
+    } else if (lookahead1_ == unicode::u32('b') || lookahead1_ == unicode::u32('B')) {
       if (!LanguageModeUtil::IsBinaryLiteralAllowed(compiler_option_)) {
-        TOKEN_ERROR("Binary literals are allowed in language mode " << LanguageModeUtil::ToString(compiler_option_));
+        TOKEN_ERROR("Binary literals are not allowed in language mode " << LanguageModeUtil::ToString(compiler_option_));
       }
       return ScanBinaryLiteral();
     }
@@ -250,18 +332,45 @@ void Scanner<UCharInputIterator>::ScanHex() {
     v += char_;
     Advance();
   }
-  BuildToken(TokenKind::kNumericLiteral, v);
+  const Utf8String& hex = v.utf8_string();
+  BuildNumericToken(TokenKind::kNumericLiteral, v,
+                    NumberConverter::ParseHex(hex.data(), hex.data() + hex.size()));
 }
 
 
 template<typename UCharInputIterator>
-void Scanner<UCharInputIterator>::ScanOctalLiteral() {
+void Scanner<UCharInputIterator>::ScanLegacyOctalLiteral() {
   UtfString str;
   while (Character::IsNumericLiteral(char_)) {
     str += char_;
     Advance();
   }
-  BuildToken(TokenKind::kOctalLiteral, str);
+  const Utf8String& octal = str.utf8_string();
+  BuildNumericToken(TokenKind::kOctalLiteral, str,
+                    NumberConverter::ParseLegacyOctal(octal.data(), octal.data() + octal.size()));
+}
+
+
+template<typename UCharInputIterator>
+void Scanner<UCharInputIterator>::ScanOctalLiteral() {
+  UtfString str;
+  str += char_;
+  Advance();
+  str += char_;
+  Advance();
+  if (!Character::IsOctalCharacter(char_)) {
+    TOKEN_ERROR("Invalid octal literal token.");
+    Skip(str);
+    BuildToken(TokenKind::kIllegal);
+    return;
+  }
+  while (Character::IsOctalCharacter(char_)) {
+    str += char_;
+    Advance();
+  }
+  const Utf8String& octal = str.utf8_string();
+  BuildNumericToken(TokenKind::kOctalLiteral, str,
+                    NumberConverter::ParseOctal(octal.data(), octal.data() + octal.size()));
 }
 
 
@@ -282,7 +391,9 @@ void Scanner<UCharInputIterator>::ScanBinaryLiteral() {
     str += char_;
     Advance();
   }
-  BuildToken(TokenKind::kBinaryLiteral, str);
+  const Utf8String& binary = str.utf8_string();
+  BuildNumericToken(TokenKind::kBinaryLiteral, str,
+                    NumberConverter::ParseBinary(binary.data(), binary.data() + binary.size()));
 }
 
 
@@ -328,8 +439,10 @@ void Scanner<UCharInputIterator>::ScanInteger() {
   if (exponent || exponent_operator) {
     return ILLEGAL_TOKEN();
   }
-  
-  BuildToken(TokenKind::kNumericLiteral, v);
+
+  const Utf8String& decimal = v.utf8_string();
+  BuildNumericToken(TokenKind::kNumericLiteral, v,
+                    NumberConverter::ParseDecimal(decimal.data(), decimal.data() + decimal.size()));
 }
 
 
@@ -346,7 +459,12 @@ void Scanner<UCharInputIterator>::ScanIdentifier() {
       Advance();
     }
   }
-  TokenKind type = Token::GetIdentifierType(v.utf8_value(), compiler_option_);
+  Atom atom = Atom::kNone;
+  TokenKind type = Token::GetIdentifierType(v.utf8_value(), compiler_option_, &atom);
+  if (atom != Atom::kNone) {
+    // The keyword is already seeded to the LiteralBuffer.
+    return BuildToken(type, literal_buffer_->atom(atom));
+  }
   BuildToken(type, v);
 }
 
@@ -453,6 +571,9 @@ void Scanner<UCharInputIterator>::ScanBitwiseOrComparationOperator(
 // Check regular expression.
 template<typename UCharInputIterator>
 Token* Scanner<UCharInputIterator>::CheckRegularExpression(Token* token) {  
+  if (in_token_array_) {
+    LeaveTokenArray();
+  }
   
   // Prepare for scanning.
   BeforeScan();
@@ -500,11 +621,118 @@ Token* Scanner<UCharInputIterator>::CheckRegularExpression(Token* token) {
 
     // Teardown.
     AfterScan();
+    if (token_array_) {
+      EnterTokenArrayIfMatched();
+    }
     return &token_info_;
   }
   return nullptr;
 }
 
+// Check template literal.
+template<typename UCharInputIterator>
+Token* Scanner<UCharInputIterator>::CheckTemplateLiteral(Token* token) {
+  if (!token->Is(TokenKind::kBackquote)) {
+    return nullptr;
+  }
+  
+  if (in_token_array_) {
+    LeaveTokenArray();
+  }
+
+  // Prepare for scanning.
+  BeforeScan();
+  UtfString expr;
+
+  // In this method, char_ point next token of the backquote,
+  // so we now assign a '`'.
+  expr += UChar::FromAscii('`');
+  if (!ScanTemplateCharacters(&expr)) {
+    TOKEN_ERROR("unterminated template literal");
+    return nullptr;
+  }
+  Advance();
+  BuildToken(TokenKind::kTemplateLiteral, expr);
+
+  // Teardown.
+  AfterScan();
+  if (token_array_) {
+    EnterTokenArrayIfMatched();
+  }
+  return &token_info_;
+}
+
+
+// When this method returns true, char_ points the closing backquote.
+template<typename UCharInputIterator>
+bool Scanner<UCharInputIterator>::ScanTemplateCharacters(UtfString* expr) {
+  bool escaped = false;
+  while (char_ != unicode::u32('\0') && !char_.IsInvalid()) {
+    *expr += char_;
+    if (escaped) {
+      escaped = false;
+    } else if (char_ == unicode::u32('\\')) {
+      escaped = true;
+    } else if (char_ == unicode::u32('`')) {
+      return true;
+    } else if (char_ == unicode::u32('$') && lookahead1_ == unicode::u32('{')) {
+      Advance();
+      *expr += char_;
+      if (!ScanTemplateSubstitution(expr)) {
+        return false;
+      }
+    }
+    Advance();
+  }
+  return false;
+}
+
+
+// The braces in the string literals and the nested template literals are not counted.
+// When this method returns true, char_ points the closing brace.
+template<typename UCharInputIterator>
+bool Scanner<UCharInputIterator>::ScanTemplateSubstitution(UtfString* expr) {
+  int depth = 1;
+  while (1) {
+    Advance();
+    if (char_ == unicode::u32('\0') || char_.IsInvalid()) {
+      return false;
+    }
+    *expr += char_;
+    
+    if (char_ == unicode::u32('{')) {
+      depth++;
+    } else if (char_ == unicode::u32('}')) {
+      if (--depth == 0) {
+        return true;
+      }
+    } else if (char_ == unicode::u32('`')) {
+      Advance();
+      if (!ScanTemplateCharacters(expr)) {
+        return false;
+      }
+    } else if (char_ == unicode::u32('\'') || char_ == unicode::u32('"')) {
+      UChar quote = char_;
+      bool escaped = false;
+      while (1) {
+        Advance();
+        if (char_ == unicode::u32('\0') || char_.IsInvalid()) {
+          return false;
+        }
+        *expr += char_;
+        if (escaped) {
+          escaped = false;
+        } else if (char_ == unicode::u32('\\')) {
+          escaped = true;
+        } else if (char_ == quote) {
+          break;
+        }
+      }
+    }
+  }
+}
+
+
 template<typename UCharInputIterator>
 void Scanner<UCharInputIterator>::RestoreScannerPosition(
     const RecordedCharPosition& rcp) {
@@ -512,6 +740,8 @@ void Scanner<UCharInputIterator>::RestoreScannerPosition(
   char_ = rcp.current();
   lookahead1_ = rcp.lookahead();
   scanner_source_position_ = rcp.ssp();
+  token_index_ = rcp.token_index();
+  in_token_array_ = rcp.in_token_array();
 }
 
 
@@ -702,37 +932,45 @@ template <typename UCharInputIterator>
 bool Scanner<UCharInputIterator>::SkipMultiLineComment() {
   bool skip = false;
   if (Character::IsMultiLineCommentStart(char_, lookahead1_)) {
+    // Only the FULL policy copies the text of the comment,
+    // the others never touch the heap.
+    CommentPolicy policy = compiler_option_.comment_policy();
+    bool retain_text = policy == CommentPolicy::FULL;
+    size_t begin = scanner_source_position_.current_offset() - 1;
     UtfString str;
-    str += char_;
+    if (retain_text) {str += char_;}
     Advance(); // /
-    str += char_;
+    if (retain_text) {str += char_;}
     Advance(); // *
     while (!Character::IsMultiLineCommentEnd(char_, lookahead1_)) {
       Character::LineBreakType lt = Character::GetLineBreakType(char_, lookahead1_);
       if (lt != Character::LineBreakType::NONE) {
-        LineFeed();
         line_terminator_state_.set_line_break_before_next();
       }
 
       if (lt == Character::LineBreakType::CRLF) {
-        str += char_;
+        if (retain_text) {str += char_;}
         Advance();
-        str += char_;
+        if (retain_text) {str += char_;}
         Advance();
       } else if (char_ == unicode::u16('\0')) {
         TOKEN_ERROR("unterminated multi line comment.");
         return true;
       } else {
-        str += char_;
+        if (retain_text) {str += char_;}
         Advance();
       }
     }
-    str += char_;
+    if (retain_text) {str += char_;}
     Advance();
-    str += char_;
+    if (retain_text) {str += char_;}
+    size_t end = scanner_source_position_.current_offset();
     Advance();
     skip = true;
-    last_multi_line_comment_ = std::move(str);
+    if (policy != CommentPolicy::DROP) {
+      last_comment_range_ = CommentRange(begin, end);
+      last_multi_line_comment_ = std::move(str);
+    }
   }
   return skip;
 }
@@ -762,10 +1000,6 @@ bool Scanner<UCharInputIterator>::ConsumeLineBreak() {
     Advance();
     is_break = true;
   }
-  
-  if (is_break) {
-    LineFeed();
-  }
   return is_break;
 }
 
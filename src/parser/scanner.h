@@ -30,7 +30,9 @@
 #include "utfstring.h"
 #include "lineterminator-state.h"
 #include "literalbuffer.h"
+#include "token-array.h"
 #include "../utils/stl.h"
+#include "../utils/number-converter.h"
 #include "../compiler-option.h"
 #include "../compiler/module-info.h"
 
@@ -69,15 +71,18 @@ class Scanner: public ErrorReporter, private Uncopyable, private Unmovable {
   Token* Peek();
 
 
-  YATSC_CONST_GETTER(size_t, line_number, scanner_source_position_.current_line_number())
-
-
   // Check whether current token is regular expression or not.
   // If current token is regular expression return TS_REGULAR_EXPR,
   // if not regular expr return nullptr.
   Token* CheckRegularExpression(Token* token_info);
 
 
+  // Check whether current token is the beginning of the template literal or not.
+  // If current token is the backquote, scan the whole template literal
+  // and return the kTemplateLiteral token, if not return nullptr.
+  Token* CheckTemplateLiteral(Token* token_info);
+
+
   void EnableNestedGenericTypeScanMode() {
     generic_type_++;
   }
@@ -100,41 +105,68 @@ class Scanner: public ErrorReporter, private Uncopyable, private Unmovable {
   
   template <typename T>
   void SetReferencePathCallback(T callback) {reference_path_callback_ = callback;}
+
+
+  // Return tokens of the token array instead of scanning the source.
+  // The scanner falls back to the source where the token array can not be used,
+  // like a regular expression or '>' of the nested generic type,
+  // and returns to the token array when the scanner position meets with it again.
+  // This method must be called before the first scan.
+  // If the begin is not 0, the scanner begins from the token of the begin,
+  // and falls back to the source from the end of the token before it.
+  void AttachTokenArray(Handle<TokenArray<UCharInputIterator>> token_array, size_t begin = 0) {
+    token_array_ = token_array;
+    token_index_ = begin;
+    in_token_array_ = true;
+  }
+
+
+  // Move the scanner to the character at the byte offset of the source,
+  // the next scan begins from there.
+  // The scanner returns to the token array when the scanner position meets with it again.
+  void Seek(const UCharInputIterator& it, size_t offset) {
+    unscaned_ = true;
+    in_token_array_ = false;
+    it_ = it;
+    scanner_source_position_ = ScannerSourcePosition(offset);
+    last_multi_line_comment_.Clear();
+    last_comment_range_ = CommentRange();
+  }
   
  private:
 
+  // The byte offsets of the scanner.
+  // Line numbers and columns are not counted while scanning,
+  // SourceStream computes them from the offset on demand.
   class ScannerSourcePosition {
    public:
     ScannerSourcePosition()
-        : start_position_(0),
-          current_position_(0),
-          current_line_number_(1),
-          start_line_number_(1) {}
+        : start_offset_(0),
+          current_offset_(0) {}
+
+
+    explicit ScannerSourcePosition(size_t offset)
+        : start_offset_(offset),
+          current_offset_(offset) {}
 
 
-    YATSC_CONST_GETTER(size_t, start_position, start_position_)
-    YATSC_CONST_GETTER(size_t, current_position, current_position_)
-    YATSC_CONST_GETTER(size_t, current_line_number, current_line_number_)
-    YATSC_CONST_GETTER(size_t, start_line_number, start_line_number_)
+    // The byte offset of the beginning of the current token.
+    YATSC_CONST_GETTER(size_t, start_offset, start_offset_)
 
-    YATSC_INLINE void AdvancePosition(size_t pos) YATSC_NOEXCEPT {current_position_ += pos;}
+    // The byte offset from the beginning of the source to the end of the current character.
+    YATSC_CONST_GETTER(size_t, current_offset, current_offset_)
 
-    YATSC_INLINE void AdvanceLine() YATSC_NOEXCEPT {
-      current_line_number_++;
-      current_position_ = 1;
+    YATSC_INLINE void AdvancePosition(size_t pos) YATSC_NOEXCEPT {
+      current_offset_ += pos;
     }
 
-    YATSC_INLINE void UpdateStartPosition() YATSC_NOEXCEPT {
-      start_position_ = current_position_;
-      start_line_number_ = current_line_number_;
+    YATSC_INLINE void UpdateStartPosition(size_t offset) YATSC_NOEXCEPT {
+      start_offset_ = offset;
     }
 
    private:
-    
-    size_t start_position_;
-    size_t current_position_;
-    size_t current_line_number_;
-    size_t start_line_number_;
+    size_t start_offset_;
+    size_t current_offset_;
   };
 
  public:
@@ -142,11 +174,14 @@ class Scanner: public ErrorReporter, private Uncopyable, private Unmovable {
   class RecordedCharPosition {
    public:
     RecordedCharPosition(const ScannerSourcePosition& ssp, const UCharInputIterator& it,
-                         const UChar& uchar, const UChar& lookahead)
+                         const UChar& uchar, const UChar& lookahead,
+                         size_t token_index, bool in_token_array)
         : ssp_(ssp),
           ucii_(it),
           uchar_(uchar),
-          lookahead_(lookahead){}
+          lookahead_(lookahead),
+          token_index_(token_index),
+          in_token_array_(in_token_array) {}
 
 
     RecordedCharPosition(const RecordedCharPosition& rcp) = default;
@@ -156,25 +191,31 @@ class Scanner: public ErrorReporter, private Uncopyable, private Unmovable {
     YATSC_CONST_GETTER(UCharInputIterator, ucii, ucii_)
     YATSC_CONST_GETTER(UChar, current, uchar_)
     YATSC_CONST_GETTER(UChar, lookahead, lookahead_)
+    YATSC_CONST_GETTER(size_t, token_index, token_index_)
+    YATSC_CONST_GETTER(bool, in_token_array, in_token_array_)
 
    private:
     ScannerSourcePosition ssp_;
     UCharInputIterator ucii_;
     UChar uchar_;
     UChar lookahead_;
+    size_t token_index_;
+    bool in_token_array_;
   };
 
   
   RecordedCharPosition char_position() YATSC_NO_SE {
-    return RecordedCharPosition(scanner_source_position_, it_, char_, lookahead1_);
+    return RecordedCharPosition(scanner_source_position_, it_, char_, lookahead1_, token_index_, in_token_array_);
   }
 
   void RestoreScannerPosition(const RecordedCharPosition& rcp);
 
  private:
 
-  void LineFeed() {
-    scanner_source_position_.AdvanceLine();
+  // Return the byte offset of the current character.
+  YATSC_INLINE size_t CurrentOffset() YATSC_NO_SE {
+    size_t offset = scanner_source_position_.current_offset();
+    return char_ == unicode::u32('\0')? offset: offset - char_.utf8_length();
   }
 
   
@@ -187,7 +228,7 @@ class Scanner: public ErrorReporter, private Uncopyable, private Unmovable {
     }
     error_ = false;
     line_terminator_state_.Clear();
-    scanner_source_position_.UpdateStartPosition();
+    scanner_source_position_.UpdateStartPosition(CurrentOffset());
   }
 
 
@@ -196,6 +237,7 @@ class Scanner: public ErrorReporter, private Uncopyable, private Unmovable {
 
   void AfterScan() {
     last_multi_line_comment_.Clear();
+    last_comment_range_ = CommentRange();
     SkipWhiteSpace();
     token_info_.set_line_terminator_state(line_terminator_state_);
   }
@@ -232,9 +274,15 @@ class Scanner: public ErrorReporter, private Uncopyable, private Unmovable {
   void ScanArithmeticOperator(TokenKind type1, TokenKind type2, TokenKind normal, bool has_let = true);
 
 
+  // Scan the legacy octal literal like 0777.
+  void ScanLegacyOctalLiteral();
+
+
+  // Scan the octal literal like 0o777.
   void ScanOctalLiteral();
 
 
+  // Scan the binary literal like 0b101.
   void ScanBinaryLiteral();
   
   
@@ -244,6 +292,14 @@ class Scanner: public ErrorReporter, private Uncopyable, private Unmovable {
   void ScanRegularExpression();
 
 
+  // Scan the characters of the template literal until the closing backquote.
+  bool ScanTemplateCharacters(UtfString* expr);
+
+
+  // Scan the substitution of the template literal until the closing brace.
+  bool ScanTemplateSubstitution(UtfString* expr);
+
+
   bool ConsumeLineBreak();
 
 
@@ -301,11 +357,16 @@ class Scanner: public ErrorReporter, private Uncopyable, private Unmovable {
   
 
   void UpdateToken() {
-    if (last_multi_line_comment_.utf8_length() > 0) {
-      token_info_.set_multi_line_comment(Heap::NewHandle<UtfString>(last_multi_line_comment_));
+    token_info_.ClearComment();
+    if (!last_comment_range_.IsEmpty()) {
+      token_info_.set_comment_range(last_comment_range_);
+      if (last_multi_line_comment_.utf8_length() > 0) {
+        token_info_.set_multi_line_comment(Heap::NewHandle<UtfString>(last_multi_line_comment_));
+      }
     }
 
     last_multi_line_comment_.Clear();
+    last_comment_range_ = CommentRange();
     token_info_.ClearValue();
     token_info_.set_source_position(CreateSourcePosition());
   }
@@ -325,10 +386,7 @@ class Scanner: public ErrorReporter, private Uncopyable, private Unmovable {
 
 
   YATSC_INLINE SourcePosition CreateSourcePosition() {
-    return SourcePosition(scanner_source_position_.start_position(),
-                          scanner_source_position_.current_position(),
-                          scanner_source_position_.start_line_number(),
-                          scanner_source_position_.current_line_number());
+    return SourcePosition(scanner_source_position_.start_offset(), CurrentOffset());
   }
   
 
@@ -340,15 +398,56 @@ class Scanner: public ErrorReporter, private Uncopyable, private Unmovable {
   }
 
 
+  void BuildToken(TokenKind type, Literal* literal) {
+    UpdateToken();
+    token_info_.set_value(literal);
+    token_info_.set_type(type);
+  }
+
+
   void BuildToken(TokenKind type) {
     UpdateToken();
     token_info_.set_type(type);
   }
+
+
+  // The numeric literal is converted from the utf8 buffer of the collected literal
+  // instead of the source stream, because the literal must be inserted into
+  // the literal buffer as the token value anyway and
+  // the UCharInputIterator does not expose the raw bytes of the source.
+  void BuildNumericToken(TokenKind type, const UtfString& utf_string, double numeric_value) {
+    BuildToken(type, utf_string);
+    token_info_.set_numeric_value(numeric_value);
+  }
   
 
   void Advance();
 
 
+  // Return the next token of the token array to token_info_.
+  // Return false if the token array can not be used for the next token.
+  bool ScanFromTokenArray();
+
+
+  // Restore the scanner state from the token array to scan the source.
+  void LeaveTokenArray();
+
+
+  // Return to the token array if the current scanner position meets with
+  // the end of the same token in the token array.
+  void EnterTokenArrayIfMatched();
+
+
+  // The tokens which start with '>' must be scanned as kGreater in the generic type.
+  YATSC_INLINE static bool IsSplittedInGenericType(TokenKind kind) {
+    return kind == TokenKind::kGreaterEqual ||
+        kind == TokenKind::kShiftRight ||
+        kind == TokenKind::kShiftRightLet ||
+        kind == TokenKind::kUShiftRight ||
+        kind == TokenKind::kUShiftRightLet;
+  }
+
+
   void Skip() {
     while (!Character::IsWhiteSpace(char_, lookahead1_) &&
            Character::GetLineBreakType(char_, lookahead1_) == Character::LineBreakType::NONE &&
@@ -368,6 +467,8 @@ class Scanner: public ErrorReporter, private Uncopyable, private Unmovable {
 
   bool unscaned_;
   bool error_;
+  bool in_token_array_;
+  size_t token_index_;
   int generic_type_;
   ScannerSourcePosition scanner_source_position_;
   LineTerminatorState line_terminator_state_;
@@ -379,7 +480,9 @@ class Scanner: public ErrorReporter, private Uncopyable, private Unmovable {
   UChar char_;
   UChar lookahead1_;
   UtfString last_multi_line_comment_;
+  CommentRange last_comment_range_;
   LiteralBuffer* literal_buffer_;
+  Handle<TokenArray<UCharInputIterator>> token_array_;
   const CompilerOption& compiler_option_;
   std::function<void(const Literal*)> reference_path_callback_;
   std::function<void(const char* message, const SourcePosition& source_position)> error_callback_;
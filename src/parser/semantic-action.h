@@ -75,8 +75,8 @@ class SemanticAction<ParseResult> {
   }
 
 
-  YATSC_INLINE Handle<ir::Symbol> NewSymbol(ir::SymbolType type, const Literal* value) {
-    return Heap::NewHandle<ir::Symbol>(type, value);
+  YATSC_INLINE ir::Symbol* NewSymbol(ir::SymbolType type, const Literal* value) {
+    return irfactory_.NewSymbol(type, value);
   }
 
 
@@ -29,90 +29,74 @@
 #include "../utils/utils.h"
 
 namespace yatsc {
-class SourcePosition: private Unmovable {
+// The position of the token or the node in the source.
+// Only the byte offset and the length are retained to keep the copy cheap,
+// so line numbers and columns are computed by SourceStream on demand.
+class SourcePosition {
  public:
   typedef long Id;
   
   SourcePosition()
-      : start_col_(0),
-        end_col_(0),
-        start_line_number_(0),
-        end_line_number_(0){}
+      : start_offset_(0),
+        length_(0) {}
   
   
-  SourcePosition(size_t start_col, size_t end_col, size_t start_line_number, size_t end_line_number)
-      : start_col_(start_col),
-        end_col_(end_col),
-        start_line_number_(start_line_number),
-        end_line_number_(end_line_number){}
+  SourcePosition(size_t start_offset, size_t end_offset)
+      : start_offset_(static_cast<uint32_t>(start_offset)),
+        length_(static_cast<uint32_t>(end_offset - start_offset)) {}
 
 
   SourcePosition(const SourcePosition& source_position)
-      : start_col_(source_position.start_col_),
-        end_col_(source_position.end_col_),
-        start_line_number_(source_position.start_line_number_),
-        end_line_number_(source_position.end_line_number_){}
+      : start_offset_(source_position.start_offset_),
+        length_(source_position.length_) {}
 
 
   inline void operator = (const SourcePosition& source_position) {
-    start_col_ = source_position.start_col_;
-    end_col_ = source_position.end_col_;
-    start_line_number_ = source_position.start_line_number_;
-    end_line_number_ = source_position.end_line_number_;
+    start_offset_ = source_position.start_offset_;
+    length_ = source_position.length_;
   }
 
 
   inline bool operator > (const SourcePosition& source_position) YATSC_NO_SE {
-    if (start_line_number_ == source_position.start_line_number_) {
-      return start_col_ > source_position.start_col_;
-    }
-    return start_line_number_ > source_position.start_line_number_;
+    return start_offset_ > source_position.start_offset_;
   }
 
 
   inline bool operator < (const SourcePosition& source_position) YATSC_NO_SE  {
-    if (start_line_number_ == source_position.start_line_number_) {
-      return start_col_ < source_position.start_col_;
-    }
-    return start_line_number_ < source_position.start_line_number_;
+    return start_offset_ < source_position.start_offset_;
   }
 
 
   inline bool operator >= (const SourcePosition& source_position) YATSC_NO_SE  {
-    if (start_line_number_ == source_position.start_line_number_) {
-      return start_col_ >= source_position.start_col_;
-    }
-    return start_line_number_ >= source_position.start_line_number_;
+    return start_offset_ >= source_position.start_offset_;
   }
 
 
   inline bool operator <= (const SourcePosition& source_position) YATSC_NO_SE  {
-    if (start_line_number_ == source_position.start_line_number_) {
-      return start_col_ <= source_position.start_col_;
-    }
-    return start_line_number_ <= source_position.start_line_number_;
+    return start_offset_ <= source_position.start_offset_;
   }
 
 
   inline bool operator == (const SourcePosition& source_position) YATSC_NO_SE  {
-    return start_line_number_ == source_position.start_line_number_ &&
-      start_col_ == source_position.start_col_ &&
-      end_line_number_ == source_position.end_line_number_ &&
-      end_col_ == source_position.end_col_;
+    return start_offset_ == source_position.start_offset_ &&
+      length_ == source_position.length_;
   }
 
 
-  YATSC_CONST_PROPERTY(size_t, start_col, start_col_)
-  YATSC_CONST_PROPERTY(size_t, end_col, end_col_)
-  YATSC_CONST_PROPERTY(size_t, start_line_number, start_line_number_)
-  YATSC_CONST_PROPERTY(size_t, end_line_number, end_line_number_)
+  // The byte offset of the beginning from the beginning of the source.
+  YATSC_CONST_GETTER(size_t, start_offset, start_offset_)
+
+
+  // The byte offset of the next of the end.
+  YATSC_CONST_GETTER(size_t, end_offset, start_offset_ + length_)
+
+
+  YATSC_CONST_GETTER(size_t, length, length_)
 
 
  private:
-  size_t start_col_;
-  size_t end_col_;
-  size_t start_line_number_;
-  size_t end_line_number_;
+  uint32_t start_offset_;
+  uint32_t length_;
 };
 }
 
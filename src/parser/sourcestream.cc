@@ -24,7 +24,11 @@
 
 
 #include <stdio.h>
+#include <algorithm>
 #include "sourcestream.h"
+#if defined(HAVE_SSE2)
+#include <emmintrin.h>
+#endif
 
 namespace yatsc {
 
@@ -79,5 +83,102 @@ Handle<SourceStream> SourceStream::FromSourceCode(const char* name, const char*
 }
 
 
+UtfString SourceStream::Slice(size_t begin, size_t end) YATSC_NO_SE {
+  UtfString str;
+  end = std::min(end, size_);
+  if (begin >= end) {
+    return std::move(str);
+  }
+
+  UnicodeIteratorAdapter<char*> it(raw_buffer_ + begin);
+  UnicodeIteratorAdapter<char*> last(raw_buffer_ + end);
+  for (; it != last; ++it) {
+    str += *it;
+  }
+  return std::move(str);
+}
+
+
+size_t SourceStream::GetLineNumber(size_t offset) YATSC_NO_SE {
+  InitializeLineIndex();
+  return line_breaks_.Rank(offset) + 1;
+}
+
+
+size_t SourceStream::GetColumn(size_t offset) YATSC_NO_SE {
+  return offset - GetLineStart(GetLineNumber(offset)) + 1;
+}
+
+
+size_t SourceStream::GetLineStart(size_t line_number) YATSC_NO_SE {
+  InitializeLineIndex();
+  if (line_number <= 1) {
+    return 0;
+  }
+  size_t line_break = line_breaks_.Select(line_number - 1);
+  return line_break == size_? size_: line_break + 1;
+}
+
+
+size_t SourceStream::line_count() YATSC_NO_SE {
+  InitializeLineIndex();
+  return line_breaks_.count() + 1;
+}
+
+
+// Mark LF and CR of the 64 bytes from the ptr to the bitmap.
+inline void ScanLineBreaks(const char* ptr, uint64_t* lf, uint64_t* cr) {
+#if defined(HAVE_SSE2)
+  const __m128i lf_pattern = _mm_set1_epi8('\n');
+  const __m128i cr_pattern = _mm_set1_epi8('\r');
+  *lf = 0;
+  *cr = 0;
+  for (int i = 0; i < 4; i++) {
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + i * 16));
+    *lf |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, lf_pattern)))) << (i * 16);
+    *cr |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, cr_pattern)))) << (i * 16);
+  }
+#else
+  *lf = 0;
+  *cr = 0;
+  for (int i = 0; i < 64; i++) {
+    *lf |= static_cast<uint64_t>(ptr[i] == '\n') << i;
+    *cr |= static_cast<uint64_t>(ptr[i] == '\r') << i;
+  }
+#endif
+}
+
+
+void SourceStream::InitializeLineIndex() YATSC_NO_SE {
+  std::call_once(line_index_flag_, [this]() {
+    static const size_t kWordBits = SuccinctBitset::kWordBits;
+    line_breaks_.Resize(size_);
+    size_t full_words = size_ / kWordBits;
+    
+    for (size_t i = 0; i < full_words; i++) {
+      const char* ptr = raw_buffer_ + i * kWordBits;
+      uint64_t lf;
+      uint64_t cr;
+      ScanLineBreaks(ptr, &lf, &cr);
+      // CR, LF and CRLF are the line break,
+      // the CR of the CRLF is not marked to count CRLF once.
+      uint64_t lf_after = lf >> 1;
+      if (ptr + kWordBits < raw_buffer_ + size_ && ptr[kWordBits] == '\n') {
+        lf_after |= static_cast<uint64_t>(1) << (kWordBits - 1);
+      }
+      line_breaks_.SetWord(i, lf | (cr & ~lf_after));
+    }
+    
+    for (size_t i = full_words * kWordBits; i < size_; i++) {
+      if (raw_buffer_[i] == '\n' ||
+          (raw_buffer_[i] == '\r' && (i + 1 == size_ || raw_buffer_[i + 1] != '\n'))) {
+        line_breaks_.Set(i, true);
+      }
+    }
+    line_breaks_.Build();
+  });
+}
+
+
 const char *SourceStream::kCantOpenInput = "Can not open input file: ";
 }
@@ -26,13 +26,16 @@
 #define PARSER_SOURCESTREAM_H_
 
 #include <iterator>
+#include <mutex>
 #include <string>
 #include "./uchar.h"
+#include "./utfstring.h"
 #include "./unicode-iterator-adapter.h"
 #include "../utils/error-reporter.h"
 #include "../utils/os.h"
 #include "../utils/stat.h"
 #include "../utils/stl.h"
+#include "../utils/succinct-bitset.h"
 #include "../utils/utils.h"
 #include "../utils/unicode.h"
 #include "../memory/heap.h"
@@ -58,12 +61,37 @@ class SourceStream : public MaybeFail, private Uncopyable {
   YATSC_INLINE UnicodeIteratorAdapter<char*> end() {return UnicodeIteratorAdapter<char*>(raw_buffer_ + size_);}
 
 
+  // Return the iterator which points the byte offset.
+  YATSC_INLINE UnicodeIteratorAdapter<char*> at(size_t offset) {return UnicodeIteratorAdapter<char*>(raw_buffer_ + offset);}
+
+
   YATSC_INLINE const char* raw_buffer() YATSC_NO_SE {return raw_buffer_;}
 
 
   YATSC_INLINE size_t size() YATSC_NO_SE {return size_;}
 
 
+  // Return the text of the byte range, like the CommentRange of the token.
+  UtfString Slice(size_t begin, size_t end) YATSC_NO_SE;
+
+
+  // Return the 1-origin line number of the byte offset.
+  size_t GetLineNumber(size_t offset) YATSC_NO_SE;
+
+
+  // Return the 1-origin column of the byte offset.
+  // The column is counted by bytes.
+  size_t GetColumn(size_t offset) YATSC_NO_SE;
+
+
+  // Return the byte offset of the beginning of the 1-origin line number.
+  size_t GetLineStart(size_t line_number) YATSC_NO_SE;
+
+
+  // Return the count of the lines.
+  size_t line_count() YATSC_NO_SE;
+
+
   static Handle<SourceStream> FromSourceCode(const String& name, const String& code) {
     return FromSourceCode(name.c_str(), code.c_str());
   }
@@ -77,11 +105,18 @@ class SourceStream : public MaybeFail, private Uncopyable {
 
   void Initialize();
 
+  // Build the line break bitmap in one pass over the buffer.
+  // The bitmap is built at the first query of the line number.
+  void InitializeLineIndex() YATSC_NO_SE;
+
   static const char* kCantOpenInput;
   
   size_t size_;
   String filepath_;
   char* raw_buffer_;
+  mutable std::once_flag line_index_flag_;
+  // The bit i is flaged if the line break ends at the byte i.
+  mutable SuccinctBitset line_breaks_;
 };
 }
 #endif
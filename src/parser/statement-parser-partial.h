@@ -192,7 +192,7 @@ ParseResult Parser<UCharInputIterator>::ParseDeclaration(bool error) {
     case TokenKind::kFunction: {
       auto function_overloads_result = ParseFunctionOverloads(true, false);
       CHECK_AST(function_overloads_result);
-      current_scope()->Declare(function_overloads_result.value());
+      Declare(function_overloads_result.value());
       return function_overloads_result;
     }
     case TokenKind::kClass:
@@ -382,7 +382,7 @@ ParseResult Parser<UCharInputIterator>::ParseLexicalBinding(bool const_decl) {
 
   ir::Node* ret = New<ir::VariableView>(lhs_result.value(), value_result.or(Null()), type_expr_result.or(Null()));
   ret->SetInformationForNode(lhs_result.value());
-  current_scope()->Declare(ret);
+  Declare(ret);
   return Success(ret);
 }
 
@@ -401,7 +401,7 @@ ParseResult Parser<UCharInputIterator>::ParseBindingIdentifier() {
   if (cur_token()->Is(TokenKind::kIdentifier)) {
     // If current parsing location is the inside generator block,
     // 'yield' is keyword and not allowed as a variable name, but parsing is continue.
-    if (cur_token()->value()->Equals("yield") && !state_.IsInGenerator()) {
+    if (cur_token()->value()->Is(Atom::kYield) && !state_.IsInGenerator()) {
       ReportParseError(cur_token(), YATSC_SOURCEINFO_ARGS)
         << "yield not allowed here.";
     }
@@ -719,7 +719,7 @@ ParseResult Parser<UCharInputIterator>::ParseVariableDeclaration() {
                                                value_result.or(Null()),
                                                type_expr_result.or(Null()));
   ret->SetInformationForNode(lhs_result.value());
-  current_scope()->Declare(ret);
+  Declare(ret);
   
   return Success(ret);
 }
@@ -929,7 +929,7 @@ ParseResult Parser<UCharInputIterator>::ParseForIteration(ir::Node* reciever, To
       
     }
   } else if (cur_token()->Is(TokenKind::kIdentifier) &&
-             cur_token()->value()->Equals("of")) {
+             cur_token()->value()->Is(Atom::kOf)) {
     // for (var i of obj) ...
     Next();
     second_result = ParseAssignmentExpression();
@@ -1241,9 +1241,9 @@ ParseResult Parser<UCharInputIterator>::ParseLabelledStatement() {
   LOG_PHASE(ParseLabelledStatement);
   auto label_identifier_result = ParseLabelIdentifier();
   CHECK_AST(label_identifier_result);
-  label_identifier_result.value()->symbol()->set_type(ir::SymbolType::kLabelName);
+  ChangeSymbolType(label_identifier_result.value(), ir::SymbolType::kLabelName);
 
-  current_scope()->Declare(label_identifier_result.value());
+  Declare(label_identifier_result.value());
 
   if (!cur_token()->Is(TokenKind::kColon)) {
     ReportParseError(cur_token(), YATSC_SOURCEINFO_ARGS) << "':' expected.";
@@ -1402,7 +1402,7 @@ ParseResult Parser<UCharInputIterator>::ParseInterfaceDeclaration() {
   if (!identifier_result) {
     SKIP_IF_ERROR_RECOVERY_ENABLED(false, TokenKind::kExtends, TokenKind::kLeftBrace, TokenKind::kRightBrace);
   } else {
-    identifier_result.value()->symbol()->set_type(ir::SymbolType::kInterfaceName);
+    ChangeSymbolType(identifier_result.value(), ir::SymbolType::kInterfaceName);
   }
   
   ParseResult type_parameters_result;
@@ -1446,7 +1446,7 @@ ParseResult Parser<UCharInputIterator>::ParseInterfaceDeclaration() {
                                         extends,
                                         body);
       ret->SetInformationForNode(info);
-      current_scope()->Declare(ret);
+      Declare(ret);
       return Success(ret);
     };
   }
@@ -1472,7 +1472,7 @@ ParseResult Parser<UCharInputIterator>::ParseEnumDeclaration() {
     return ParseEnumBody() >>= [&](ir::Node* enum_body) {
       auto ret = New<ir::EnumDeclView>(identifier_result.or(Null()), enum_body);
       ret->SetInformationForNode(&info);
-      current_scope()->Declare(ret);
+      Declare(ret);
       return Success(ret);
     };
   }
@@ -1562,7 +1562,7 @@ ParseResult Parser<UCharInputIterator>::ParseClassDeclaration() {
   if (!identifier_result) {
     SKIP_IF_ERROR_RECOVERY_ENABLED(false, TokenKind::kLess, TokenKind::kImplements, TokenKind::kExtends, TokenKind::kLeftBrace);
   } else {
-    identifier_result.value()->symbol()->set_type(ir::SymbolType::kClassName); 
+    ChangeSymbolType(identifier_result.value(), ir::SymbolType::kClassName); 
   }
     
   if (cur_token()->Is(TokenKind::kLess)) {
@@ -1595,7 +1595,7 @@ ParseResult Parser<UCharInputIterator>::ParseClassDeclaration() {
                                            class_bases_result.or(Null()),
                                            class_body_result.or(Null()));
   class_decl->SetInformationForNode(&info);
-  current_scope()->Declare(class_decl);
+  Declare(class_decl);
   return Success(class_decl);
 }
 
@@ -1707,7 +1707,7 @@ ParseResult Parser<UCharInputIterator>::ParseClassElement() {
     cur_token()->set_type(TokenKind::kIdentifier);
   }
   
-  if (cur_token()->Is(TokenKind::kIdentifier) && cur_token()->value()->Equals("constructor")) {
+  if (cur_token()->Is(TokenKind::kIdentifier) && cur_token()->value()->Is(Atom::kConstructor)) {
     return ParseConstructorOverloads(field_modifiers_result.value());
   } else if (cur_token()->Is(TokenKind::kMul)) {
     Next();
@@ -1831,7 +1831,7 @@ void Parser<UCharInputIterator>::ValidateOverload(ir::MemberFunctionDefinitionVi
           ir::Node* ret_type = ret->ToSimpleTypeExprView()->type_name();
           if (ret_type->HasNameView()) {
             auto name = ret_type->symbol();
-            if (name->Equals("void") || name->Equals("null")) {
+            if (name->Is(Atom::kVoid) || name->Is(Atom::kNull)) {
               ReportParseError(ret_type, YATSC_SOURCEINFO_ARGS)
                 << "getter function must return value.";
             }
@@ -1850,7 +1850,7 @@ void Parser<UCharInputIterator>::ValidateOverload(ir::MemberFunctionDefinitionVi
           ir::Node* ret_type = ret->ToSimpleTypeExprView()->type_name();
           if (ret_type->HasNameView()) {
             auto name = ret_type->symbol();
-            if (!name->Equals("void") && !name->Equals("null")) {
+            if (!name->Is(Atom::kVoid) && !name->Is(Atom::kNull)) {
               ReportParseError(ret_type, YATSC_SOURCEINFO_ARGS)
                 << "setter function must not return value.";
             }
@@ -1870,7 +1870,7 @@ ParseResult Parser<UCharInputIterator>::ParseConstructorOverloads(ir::Node* mods
   
   while (1) {
     if ((cur_token()->Is(TokenKind::kIdentifier) &&
-         cur_token()->value()->Equals("constructor")) ||
+         cur_token()->value()->Is(Atom::kConstructor)) ||
         IsAccessLevelModifier(cur_token())) {
       
       auto constructor_overload_result = ParseConstructorOverloadOrImplementation(first, mods, overloads);
@@ -1911,7 +1911,7 @@ ParseResult Parser<UCharInputIterator>::ParseConstructorOverloadOrImplementation
   }
   
   if (cur_token()->Is(TokenKind::kIdentifier) &&
-      cur_token()->value()->Equals("constructor")) {
+      cur_token()->value()->Is(Atom::kConstructor)) {
     
     Token info = *cur_token();
     auto identifier_result = ParseIdentifier();
@@ -2465,6 +2465,18 @@ ParseResult Parser<UCharInputIterator>::ParseParameter(bool rest, bool accesslev
 template <typename UCharInputIterator>
 ParseResult Parser<UCharInputIterator>::ParseFunctionBody(bool generator) {
   LOG_PHASE(ParseFunctionBody);
+  // The syntax check must report the errors in the function bodies,
+  // so the bodies are never skipped in that mode.
+  if (compiler_option_.lazy_function_body() && !compiler_option_.syntax_check_only()) {
+    return PreparseFunctionBody(generator);
+  }
+  return ParseEagerFunctionBody(generator);
+}
+
+
+template <typename UCharInputIterator>
+ParseResult Parser<UCharInputIterator>::ParseEagerFunctionBody(bool generator) {
+  LOG_PHASE(ParseEagerFunctionBody);
 
   Handle<ir::Scope> scope = NewScope();
   set_current_scope(scope);
@@ -2515,6 +2527,144 @@ ParseResult Parser<UCharInputIterator>::ParseFunctionBody(bool generator) {
 }
 
 
+// Skip the function body without building the IR.
+// The tokens are still scanned, so the braces in the string literals and the comments are not counted,
+// and the '/' is rescanned as the regular expression in the place where the expression is expected.
+// The syntax errors in the body are reported when the body is parsed by the ParseLazyFunctionBody.
+template <typename UCharInputIterator>
+ParseResult Parser<UCharInputIterator>::PreparseFunctionBody(bool generator) {
+  LOG_PHASE(PreparseFunctionBody);
+
+  auto body = New<ir::LazyFunctionBodyView>(scope_, generator);
+  size_t start_offset = cur_token()->source_position().start_offset();
+
+  int depth = 1;
+  TokenKind prev_type = TokenKind::kLeftBrace;
+  Next();
+  
+  while (1) {
+    Token* token = cur_token();
+    switch (token->type()) {
+      case TokenKind::kLeftBrace:
+        depth++;
+        break;
+      case TokenKind::kRightBrace:
+        depth--;
+        break;
+      case TokenKind::kDiv: {
+        if (IsRegularExpressionAllowed(prev_type)) {
+          Token* regexp = scanner_->CheckRegularExpression(token);
+          if (regexp != nullptr) {
+            token = regexp;
+          }
+        }
+        break;
+      }
+      case TokenKind::kBackquote: {
+        Token* template_literal = scanner_->CheckTemplateLiteral(token);
+        if (template_literal != nullptr) {
+          token = template_literal;
+        }
+        break;
+      }
+      case TokenKind::kSuper:
+        body->set_uses_super(true);
+        break;
+      case TokenKind::kIdentifier: {
+        if (token->value()->Is(Atom::kYield)) {
+          body->set_uses_yield(true);
+        } else if (token->value()->Is(Atom::kArguments)) {
+          body->set_uses_arguments(true);
+        }
+        break;
+      }
+      case TokenKind::kEof:
+        UnexpectedEndOfInput(token, YATSC_SOURCEINFO_ARGS);
+        return Failed();
+      default:
+        break;
+    }
+
+    if (depth == 0) {
+      body->SetInformationForNode(SourcePosition(start_offset, token->source_position().end_offset()));
+      CloseBraceFound();
+      BalanceEnclosureIfNotBalanced(token, TokenKind::kRightBrace, true);
+      break;
+    }
+    
+    prev_type = token->type();
+    Next();
+  }
+  return Success(body);
+}
+
+
+// The '/' after the operand is the division,
+// and the '/' in the other place is the beginning of the regular expression.
+// The '}' is treated as the end of the block, so the division that follows the object literal is
+// scanned as the regular expression, but it is rare in the function body.
+template <typename UCharInputIterator>
+bool Parser<UCharInputIterator>::IsRegularExpressionAllowed(TokenKind type) {
+  switch (type) {
+    case TokenKind::kIdentifier:
+    case TokenKind::kNumericLiteral:
+    case TokenKind::kOctalLiteral:
+    case TokenKind::kBinaryLiteral:
+    case TokenKind::kStringLiteral:
+    case TokenKind::kRegularExpr:
+    case TokenKind::kTemplateLiteral:
+    case TokenKind::kTrue:
+    case TokenKind::kFalse:
+    case TokenKind::kNull:
+    case TokenKind::kNan:
+    case TokenKind::kUndefined:
+    case TokenKind::kThis:
+    case TokenKind::kSuper:
+    case TokenKind::kRightParen:
+    case TokenKind::kRightBracket:
+    case TokenKind::kIncrement:
+    case TokenKind::kDecrement:
+      return false;
+    default:
+      return true;
+  }
+}
+
+
+template <typename UCharInputIterator>
+ParseResult Parser<UCharInputIterator>::ParseLazyFunctionBody(ir::Node* function) {
+  LOG_PHASE(ParseLazyFunctionBody);
+
+  for (size_t i = 0, size = function->size(); i < size; i++) {
+    ir::Node* child = function->at(i);
+    if (child == nullptr || !child->HasLazyFunctionBodyView()) {
+      continue;
+    }
+    
+    ir::LazyFunctionBodyView* lazy_body = child->ToLazyFunctionBodyView();
+    
+    // The body is parsed from the '{' where it is skipped,
+    // and then the parser goes back to the current position.
+    RecordedParserState rps = CaptureParserState();
+    size_t start_offset = lazy_body->source_position().start_offset();
+    scanner_->Seek(module_info_->source_stream()->at(start_offset), start_offset);
+    Next();
+    scope_ = lazy_body->scope();
+    state_.Rewind(0);
+    OpenBraceFound();
+    ParseResult result = ParseEagerFunctionBody(lazy_body->generator());
+    ApplyParserState(rps);
+
+    if (result) {
+      function->InsertAt(i, result.value());
+      result.value()->set_parent_node(function);
+    }
+    return result;
+  }
+  return Failed();
+}
+
+
 template <typename UCharInputIterator>
 ParseResult Parser<UCharInputIterator>::ParseEmptyStatement() {
   Next();
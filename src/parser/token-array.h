@@ -0,0 +1,209 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2013 Taketoshi Aono(brn)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#ifndef PARSER_TOKEN_ARRAY_H_
+#define PARSER_TOKEN_ARRAY_H_
+
+#include <algorithm>
+#include "./token.h"
+#include "./uchar.h"
+#include "./sourceposition.h"
+#include "../utils/stl.h"
+#include "../utils/utils.h"
+
+
+namespace yatsc {
+
+// The array of the tokens which are scanned before the parsing,
+// like by the ParallelScanner.
+// Scanner::AttachTokenArray makes the scanner return these tokens
+// instead of scanning the source.
+template <typename UCharInputIterator>
+class TokenArray : private Uncopyable {
+ public:
+  // The scanner state just after a token is scanned.
+  class Cursor {
+   public:
+    Cursor(const UCharInputIterator& it, const UChar& current, size_t offset)
+        : it_(it),
+          current_(current),
+          offset_(offset) {}
+
+    YATSC_CONST_GETTER(const UCharInputIterator&, it, it_)
+    YATSC_CONST_GETTER(const UChar&, current, current_)
+    YATSC_CONST_GETTER(size_t, offset, offset_)
+    
+    YATSC_INLINE bool operator < (const Cursor& cursor) YATSC_NO_SE {
+      return offset_ < cursor.offset_;
+    }
+
+   private:
+    UCharInputIterator it_;
+    UChar current_;
+    size_t offset_;
+  };
+
+
+  // The error which is reported while the token is scanned.
+  class Error {
+   public:
+    Error(size_t index, const char* message, const SourcePosition& source_position)
+        : index_(index),
+          message_(message),
+          source_position_(source_position) {}
+
+    YATSC_CONST_GETTER(size_t, index, index_)
+    YATSC_CONST_GETTER(const char*, message, message_.c_str())
+    YATSC_CONST_GETTER(const SourcePosition&, source_position, source_position_)
+    
+   private:
+    size_t index_;
+    String message_;
+    SourcePosition source_position_;
+  };
+
+
+  // The reference path which is found while the token is scanned.
+  class Reference {
+   public:
+    Reference(size_t index, const Literal* path)
+        : index_(index),
+          path_(path) {}
+    
+    YATSC_CONST_GETTER(size_t, index, index_)
+    YATSC_CONST_GETTER(const Literal*, path, path_)
+    
+   private:
+    size_t index_;
+    const Literal* path_;
+  };
+
+  
+  TokenArray() = default;
+
+
+  void Reserve(size_t size) {
+    tokens_.reserve(size);
+    cursors_.reserve(size);
+  }
+  
+
+  // Append the token and the scanner state after the token.
+  // The tokens must be appended in the order of the source position.
+  void Append(const Token& token, const Cursor& cursor) {
+    tokens_.push_back(token);
+    cursors_.push_back(cursor);
+  }
+
+
+  // The errors and the references must be appended in the order of the index.
+  void AppendError(size_t index, const char* message, const SourcePosition& source_position) {
+    errors_.push_back(Error(index, message, source_position));
+  }
+
+
+  void AppendReference(size_t index, const Literal* path) {
+    references_.push_back(Reference(index, path));
+  }
+
+
+  YATSC_CONST_GETTER(size_t, size, tokens_.size())
+
+
+  YATSC_CONST_GETTER(const Vector<Error>&, errors, errors_)
+
+
+  YATSC_CONST_GETTER(const Vector<Reference>&, references, references_)
+
+
+  YATSC_INLINE const Token& token(size_t index) YATSC_NO_SE {return tokens_[index];}
+
+
+  YATSC_INLINE const Cursor& cursor(size_t index) YATSC_NO_SE {return cursors_[index];}
+
+
+  // Append the tokens of the range [begin, end) of the token array,
+  // and the errors and the references which are found while these tokens are scanned.
+  void AppendRange(const TokenArray& token_array, size_t begin, size_t end) {
+    size_t base = tokens_.size();
+    Reserve(base + end - begin);
+    for (size_t i = begin; i < end; i++) {
+      Append(token_array.tokens_[i], token_array.cursors_[i]);
+    }
+
+    for (auto it = LowerBound(token_array.errors_, begin); it != token_array.errors_.end() && it->index() < end; ++it) {
+      AppendError(base + it->index() - begin, it->message(), it->source_position());
+    }
+
+    for (auto it = LowerBound(token_array.references_, begin); it != token_array.references_.end() && it->index() < end; ++it) {
+      AppendReference(base + it->index() - begin, it->path());
+    }
+  }
+
+
+  // Find the index of the token that ends at the same scanner position with the cursor.
+  // Return false if such token is not exists.
+  bool Find(const Cursor& cursor, size_t* index) YATSC_NO_SE {
+    auto found = std::lower_bound(cursors_.begin(), cursors_.end(), cursor);
+    if (found == cursors_.end() || cursor < *found) {
+      return false;
+    }
+    *index = found - cursors_.begin();
+    return true;
+  }
+  
+
+  // Call callbacks with the errors and the references which are found
+  // while the token of the index is scanned.
+  template <typename ErrorCallback, typename ReferenceCallback>
+  void Report(size_t index, ErrorCallback& error_callback, ReferenceCallback& reference_callback) YATSC_NO_SE {
+    if (error_callback) {
+      for (auto it = LowerBound(errors_, index); it != errors_.end() && it->index() == index; ++it) {
+        error_callback(it->message(), it->source_position());
+      }
+    }
+
+    if (reference_callback) {
+      for (auto it = LowerBound(references_, index); it != references_.end() && it->index() == index; ++it) {
+        reference_callback(it->path());
+      }
+    }
+  }
+  
+ private:
+  template <typename T>
+  static typename Vector<T>::const_iterator LowerBound(const Vector<T>& v, size_t index) {
+    return std::lower_bound(v.begin(), v.end(), index, [](const T& item, size_t i) {
+      return item.index() < i;
+    });
+  }
+  
+  Vector<Token> tokens_;
+  Vector<Cursor> cursors_;
+  Vector<Error> errors_;
+  Vector<Reference> references_;
+};
+
+} // namespace yatsc
+
+#endif // PARSER_TOKEN_ARRAY_H_
@@ -166,72 +166,73 @@ static const TokenKind kPunctures[] = {
 // Borrowed from v8 javascript engine.
 #define KEYWORDS(KEYWORD_GROUP, KEYWORD)                                \
   KEYWORD_GROUP('b')                                                    \
-  KEYWORD("break", TokenKind::kBreak)                                   \
+  KEYWORD("break", TokenKind::kBreak, Atom::kBreak)                     \
   KEYWORD_GROUP('c')                                                    \
-  KEYWORD("case", TokenKind::kCase)                                     \
-  KEYWORD("catch", TokenKind::kCatch)                                   \
-  KEYWORD("class", TokenKind::kClass)                                   \
-  KEYWORD("const", LanguageModeUtil::IsES6(co)? TokenKind::kConst: TokenKind::kFutureReservedWord) \
-  KEYWORD("continue", TokenKind::kContinue)                             \
+  KEYWORD("case", TokenKind::kCase, Atom::kCase)                        \
+  KEYWORD("catch", TokenKind::kCatch, Atom::kCatch)                     \
+  KEYWORD("class", TokenKind::kClass, Atom::kClass)                     \
+  KEYWORD("const", LanguageModeUtil::IsES6(co)? TokenKind::kConst: TokenKind::kFutureReservedWord, Atom::kConst) \
+  KEYWORD("continue", TokenKind::kContinue, Atom::kContinue)            \
   KEYWORD_GROUP('d')                                                    \
-  KEYWORD("debugger", TokenKind::kDebugger)                             \
-  KEYWORD("default", TokenKind::kDefault)                               \
-  KEYWORD("delete", TokenKind::kDelete)                                 \
-  KEYWORD("do", TokenKind::kDo)                                         \
+  KEYWORD("debugger", TokenKind::kDebugger, Atom::kDebugger)            \
+  KEYWORD("default", TokenKind::kDefault, Atom::kDefault)               \
+  KEYWORD("delete", TokenKind::kDelete, Atom::kDelete)                  \
+  KEYWORD("do", TokenKind::kDo, Atom::kDo)                              \
   KEYWORD_GROUP('e')                                                    \
-  KEYWORD("else", TokenKind::kElse)                                     \
-  KEYWORD("enum", TokenKind::kEnum)                                     \
-  KEYWORD("export", TokenKind::kExport)                                 \
-  KEYWORD("extends", TokenKind::kExtends)                               \
+  KEYWORD("else", TokenKind::kElse, Atom::kElse)                        \
+  KEYWORD("enum", TokenKind::kEnum, Atom::kEnum)                        \
+  KEYWORD("export", TokenKind::kExport, Atom::kExport)                  \
+  KEYWORD("extends", TokenKind::kExtends, Atom::kExtends)               \
   KEYWORD_GROUP('f')                                                    \
-  KEYWORD("false", TokenKind::kFalse)                                   \
-  KEYWORD("finally", TokenKind::kFinally)                               \
-  KEYWORD("for", TokenKind::kFor)                                       \
-  KEYWORD("function", TokenKind::kFunction)                             \
+  KEYWORD("false", TokenKind::kFalse, Atom::kFalse)                     \
+  KEYWORD("finally", TokenKind::kFinally, Atom::kFinally)               \
+  KEYWORD("for", TokenKind::kFor, Atom::kFor)                           \
+  KEYWORD("function", TokenKind::kFunction, Atom::kFunction)            \
   KEYWORD_GROUP('i')                                                    \
-  KEYWORD("if", TokenKind::kIf)                                         \
-  KEYWORD("implements", TokenKind::kImplements)                         \
-  KEYWORD("import", TokenKind::kImport)                                 \
-  KEYWORD("in", TokenKind::kIn)                                         \
-  KEYWORD("instanceof", TokenKind::kInstanceof)                         \
-  KEYWORD("interface", TokenKind::kInterface)                           \
+  KEYWORD("if", TokenKind::kIf, Atom::kIf)                              \
+  KEYWORD("implements", TokenKind::kImplements, Atom::kImplements)      \
+  KEYWORD("import", TokenKind::kImport, Atom::kImport)                  \
+  KEYWORD("in", TokenKind::kIn, Atom::kIn)                              \
+  KEYWORD("instanceof", TokenKind::kInstanceof, Atom::kInstanceof)      \
+  KEYWORD("interface", TokenKind::kInterface, Atom::kInterface)         \
   KEYWORD_GROUP('l')                                                    \
-  KEYWORD("let", LanguageModeUtil::IsES6(co)? TokenKind::kLet: TokenKind::kIdentifier) \
+  KEYWORD("let", LanguageModeUtil::IsES6(co)? TokenKind::kLet: TokenKind::kIdentifier, Atom::kLet) \
   KEYWORD_GROUP('n')                                                    \
-  KEYWORD("new", TokenKind::kNew)                                       \
-  KEYWORD("null", TokenKind::kNull)                                     \
+  KEYWORD("new", TokenKind::kNew, Atom::kNew)                           \
+  KEYWORD("null", TokenKind::kNull, Atom::kNull)                        \
   KEYWORD_GROUP('N')                                                    \
-  KEYWORD("NaN", TokenKind::kNan)                                       \
+  KEYWORD("NaN", TokenKind::kNan, Atom::kNan)                           \
   KEYWORD_GROUP('p')                                                    \
   KEYWORD("package", LanguageModeUtil::IsFutureReservedWord(co)?        \
-          TokenKind::kFutureStrictReservedWord: TokenKind::kIdentifier) \
-  KEYWORD("private", TokenKind::kPrivate)                               \
-  KEYWORD("protected", TokenKind::kProtected)                           \
-  KEYWORD("public", TokenKind::kPublic)                                 \
+          TokenKind::kFutureStrictReservedWord: TokenKind::kIdentifier, Atom::kPackage) \
+  KEYWORD("private", TokenKind::kPrivate, Atom::kPrivate)               \
+  KEYWORD("protected", TokenKind::kProtected, Atom::kProtected)         \
+  KEYWORD("public", TokenKind::kPublic, Atom::kPublic)                  \
   KEYWORD_GROUP('r')                                                    \
-  KEYWORD("return", TokenKind::kReturn)                                 \
+  KEYWORD("return", TokenKind::kReturn, Atom::kReturn)                  \
   KEYWORD_GROUP('s')                                                    \
-  KEYWORD("static", TokenKind::kStatic)                                 \
-  KEYWORD("super", TokenKind::kSuper)                                   \
-  KEYWORD("switch", TokenKind::kSwitch)                                 \
+  KEYWORD("static", TokenKind::kStatic, Atom::kStatic)                  \
+  KEYWORD("super", TokenKind::kSuper, Atom::kSuper)                     \
+  KEYWORD("switch", TokenKind::kSwitch, Atom::kSwitch)                  \
   KEYWORD_GROUP('t')                                                    \
-  KEYWORD("this", TokenKind::kThis)                                     \
-  KEYWORD("throw", TokenKind::kThrow)                                   \
-  KEYWORD("true", TokenKind::kTrue)                                     \
-  KEYWORD("try", TokenKind::kTry)                                       \
-  KEYWORD("typeof", TokenKind::kTypeof)                                 \
+  KEYWORD("this", TokenKind::kThis, Atom::kThis)                        \
+  KEYWORD("throw", TokenKind::kThrow, Atom::kThrow)                     \
+  KEYWORD("true", TokenKind::kTrue, Atom::kTrue)                        \
+  KEYWORD("try", TokenKind::kTry, Atom::kTry)                           \
+  KEYWORD("typeof", TokenKind::kTypeof, Atom::kTypeof)                  \
   KEYWORD_GROUP('u')                                                    \
-  KEYWORD("undefined", TokenKind::kUndefined)                           \
+  KEYWORD("undefined", TokenKind::kUndefined, Atom::kUndefined)         \
   KEYWORD_GROUP('v')                                                    \
-  KEYWORD("var", TokenKind::kVar)                                       \
-  KEYWORD("void", TokenKind::kVoid)                                     \
+  KEYWORD("var", TokenKind::kVar, Atom::kVar)                           \
+  KEYWORD("void", TokenKind::kVoid, Atom::kVoid)                        \
   KEYWORD_GROUP('w')                                                    \
-  KEYWORD("while", TokenKind::kWhile)                                   \
-  KEYWORD("with", TokenKind::kWith)
+  KEYWORD("while", TokenKind::kWhile, Atom::kWhile)                     \
+  KEYWORD("with", TokenKind::kWith, Atom::kWith)
 
 
 // Get Identifier type from string.
-TokenKind Token::GetIdentifierType(const char* maybe_keyword, const CompilerOption& co) {
+// If the string is the keyword, the atom of the keyword is stored to the atom.
+TokenKind Token::GetIdentifierType(const char* maybe_keyword, const CompilerOption& co, Atom* atom) {
   const size_t input_length = Strlen(maybe_keyword);
   const int min_length = 2;
   const int max_length = 10;
@@ -245,7 +246,7 @@ TokenKind Token::GetIdentifierType(const char* maybe_keyword, const CompilerOpti
 #define KEYWORD_GROUP_CASE(ch)                  \
       break;                                    \
     case ch:
-#define KEYWORD(keyword, token)                                         \
+#define KEYWORD(keyword, token, keyword_atom)                           \
       {                                                                 \
         const int keyword_length = sizeof(keyword) - 1;                 \
         static_assert(keyword_length >= min_length, "The length of the keyword must be greater than 2"); \
@@ -260,6 +261,9 @@ TokenKind Token::GetIdentifierType(const char* maybe_keyword, const CompilerOpti
             (keyword_length <= 7 || maybe_keyword[7] == keyword[7]) &&  \
             (keyword_length <= 8 || maybe_keyword[8] == keyword[8]) &&  \
             (keyword_length <= 9 || maybe_keyword[9] == keyword[9])) {  \
+          if (atom != nullptr) {                                        \
+            *atom = keyword_atom;                                       \
+          }                                                             \
           return token;                                                 \
         }                                                               \
       }
@@ -275,7 +279,7 @@ TokenKind Token::GetPunctureType(const UChar& uchar) {
 }
 
 
-uint8_t GetOperandPriority(TokenKind kind) {
+uint8_t Token::GetOperandPriority(TokenKind kind) {
   switch (kind) {
     case TokenKind::kMod:
     case TokenKind::kDiv:
@@ -309,7 +313,7 @@ uint8_t GetOperandPriority(TokenKind kind) {
     case TokenKind::kLogicalAnd:
       return 9;
     case TokenKind::kLogicalOr:
-      return 10;
+      return kLowestOperandPriority;
     default:
       return 0;
   }
@@ -180,19 +180,51 @@ static const char* kTokenStringList[] = {
 
 
 
+// The byte range of the multi line comment in the source.
+// The text is not copied by the scanner, so resolve it by SourceStream::Slice
+// if needed.
+class CommentRange {
+ public:
+  CommentRange()
+      : begin_(0),
+        end_(0) {}
+
+
+  CommentRange(size_t begin, size_t end)
+      : begin_(begin),
+        end_(end) {}
+
+
+  YATSC_CONST_GETTER(size_t, begin, begin_)
+
+
+  YATSC_CONST_GETTER(size_t, end, end_)
+
+
+  YATSC_INLINE bool IsEmpty() YATSC_NO_SE {return begin_ == end_;}
+
+ private:
+  size_t begin_;
+  size_t end_;
+};
+
+
 class Token {
  public:
 
   // Default constructor.
   Token() :
       literal_(nullptr),
+      numeric_value_(0),
       type_(TokenKind::kEof) {}
   
 
   // Copy constructor
   Token(const Token& token_info)
       : literal_(token_info.literal_),
+        numeric_value_(token_info.numeric_value_),
         multi_line_comment_(token_info.multi_line_comment_),
+        comment_range_(token_info.comment_range_),
         type_(token_info.type_),
         line_terminator_state_(token_info.line_terminator_state_),
         source_position_(token_info.source_position_) {}
@@ -200,7 +232,9 @@ class Token {
 
   Token(Token&& token_info)
       : literal_(std::move(token_info.literal_)),
+        numeric_value_(token_info.numeric_value_),
         multi_line_comment_(std::move(token_info.multi_line_comment_)),
+        comment_range_(token_info.comment_range_),
         type_(token_info.type_),
         line_terminator_state_(token_info.line_terminator_state_),
         source_position_(token_info.source_position_) {}
@@ -208,7 +242,9 @@ class Token {
 
   Token& operator = (const Token& token_info) {
     literal_ = token_info.literal_;
+    numeric_value_ = token_info.numeric_value_;
     multi_line_comment_ = token_info.multi_line_comment_;
+    comment_range_ = token_info.comment_range_;
     type_ = token_info.type_;
     line_terminator_state_ = token_info.line_terminator_state_;
     source_position_ = token_info.source_position_;
@@ -218,7 +254,9 @@ class Token {
 
   Token& operator = (Token&& token_info) {
     literal_ = std::move(token_info.literal_);
+    numeric_value_ = token_info.numeric_value_;
     multi_line_comment_ = std::move(token_info.multi_line_comment_);
+    comment_range_ = token_info.comment_range_;
     type_ = token_info.type_;
     line_terminator_state_ = token_info.line_terminator_state_;
     source_position_ = token_info.source_position_;
@@ -246,10 +284,16 @@ class Token {
     multi_line_comment_ = multi_line_comment;
   }
 
+
+  YATSC_INLINE void set_comment_range(const CommentRange& comment_range) {
+    comment_range_ = comment_range;
+  }
+
   
-  // Remove token value.
+  // Remove token comment.
   YATSC_INLINE void ClearComment() {
     multi_line_comment_.Clear();
+    comment_range_ = CommentRange();
   }
   
 
@@ -271,11 +315,18 @@ class Token {
   }
 
 
+  // Return the text of the multi line comment which precedes this token.
+  // The text is retained only if the comment policy is CommentPolicy::FULL.
   YATSC_INLINE const UtfString* comment() YATSC_NO_SE {
-    return multi_line_comment_.Get();
+    return multi_line_comment_? multi_line_comment_.Get(): nullptr;
   }
 
 
+  // Return the range of the multi line comment which precedes this token.
+  // The range is empty if the comment policy is CommentPolicy::DROP.
+  YATSC_CONST_GETTER(const CommentRange&, comment_range, comment_range_)
+
+
   YATSC_INLINE bool Is(const TokenKind kind) YATSC_NO_SE {return kind == type_;}
 
 
@@ -294,6 +345,11 @@ class Token {
   YATSC_CONST_PROPERTY(TokenKind, type, type_)
 
 
+  // Getter and setter for numeric_value_.
+  // The value is converted by the scanner if the token is numeric literal.
+  YATSC_CONST_PROPERTY(double, numeric_value, numeric_value_)
+
+
   // Setter for source_position_.
   YATSC_SETTER(SourcePosition, source_position, source_position_)
   
@@ -335,7 +391,7 @@ class Token {
 #endif
   
   // Get a type of the identifier like Var
-  static TokenKind GetIdentifierType(const char* maybe_keyword, const CompilerOption& co);
+  static TokenKind GetIdentifierType(const char* maybe_keyword, const CompilerOption& co, Atom* atom = nullptr);
 
 
   // Get a type of the puncture like LeftBrace.
@@ -345,7 +401,13 @@ class Token {
   static Token kNullToken;
 
 
-  static uint8_t GetOperandPriority(Token t);
+  // Return the priority of the binary operator,
+  // 1 is the highest (multiplicative) and kLowestOperandPriority is the lowest (||).
+  // 0 is returned if the kind is not the binary operator.
+  static uint8_t GetOperandPriority(TokenKind kind);
+
+
+  static const uint8_t kLowestOperandPriority = 10;
 
   
   static bool IsKeyword(TokenKind type);
@@ -356,7 +418,9 @@ class Token {
   
  private:  
   const Literal* literal_;
+  double numeric_value_;
   Handle<UtfString> multi_line_comment_;
+  CommentRange comment_range_;
   TokenKind type_;
   LineTerminatorState line_terminator_state_;
   SourcePosition source_position_;
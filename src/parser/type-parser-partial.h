@@ -495,8 +495,8 @@ ParseResult Parser<UCharInputIterator>::ParseIndexSignature() {
     if (cur_token()->type() == TokenKind::kColon) {
       Next();
       if (cur_token()->type() == TokenKind::kIdentifier) {
-        bool string_type = cur_token()->value()->Equals("string");
-        bool number_type = cur_token()->value()->Equals("number");
+        bool string_type = cur_token()->value()->Is(Atom::kString);
+        bool number_type = cur_token()->value()->Is(Atom::kNumber);
         if (string_type || number_type) {
           Next();
           if (cur_token()->type() == TokenKind::kRightBracket) {
@@ -0,0 +1,167 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2013 Taketoshi Aono(brn)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+
+#ifndef UTILS_FLAT_ID_MAP_H
+#define UTILS_FLAT_ID_MAP_H
+
+#include "./utils.h"
+#include "./stl.h"
+
+namespace yatsc {
+
+// The open addressing hash map from the Unique::Id to the index.
+// The entries are stored in the flat array and found by the linear probing,
+// so the lookup touches only a few contiguous entries and allocates nothing.
+// The removed entry is filled by shifting the following entries back,
+// so no tombstone is left in the array.
+class FlatIdMap {
+ public:
+  static const uint32_t kNotFound = ~0u;
+
+  FlatIdMap()
+      : size_(0) {}
+
+
+  YATSC_CONST_GETTER(size_t, size, size_)
+
+
+  YATSC_INLINE bool empty() YATSC_NO_SE {return size_ == 0;}
+
+
+  // The count of the slots of the array.
+  YATSC_INLINE size_t capacity() YATSC_NO_SE {return entries_.size();}
+
+
+  // Return the value of the id or kNotFound.
+  YATSC_INLINE uint32_t Find(Unique::Id id) YATSC_NO_SE {
+    if (size_ == 0) {
+      return kNotFound;
+    }
+    for (size_t i = IndexOf(id);; i = Next(i)) {
+      const Entry& entry = entries_[i];
+      if (entry.id == id) {
+        return entry.value;
+      }
+      if (entry.id == kEmpty) {
+        return kNotFound;
+      }
+    }
+  }
+
+
+  // Insert the value of the id or overwrite the value if the id is already inserted.
+  YATSC_INLINE void Set(Unique::Id id, uint32_t value) {
+    // Keep the load factor under 0.5 to keep the probe sequence short.
+    if ((size_ + 1) * 2 > entries_.size()) {
+      Grow();
+    }
+    size_t i = IndexOf(id);
+    while (entries_[i].id != kEmpty && entries_[i].id != id) {
+      i = Next(i);
+    }
+    if (entries_[i].id == kEmpty) {
+      entries_[i].id = id;
+      size_++;
+    }
+    entries_[i].value = value;
+  }
+
+
+  // Remove the id.
+  void Erase(Unique::Id id) {
+    if (size_ == 0) {
+      return;
+    }
+    size_t i = IndexOf(id);
+    while (entries_[i].id != id) {
+      if (entries_[i].id == kEmpty) {
+        return;
+      }
+      i = Next(i);
+    }
+
+    // Move back the entries that are placed after the hole by the collision.
+    size_t hole = i;
+    for (size_t j = Next(hole); entries_[j].id != kEmpty; j = Next(j)) {
+      size_t home = IndexOf(entries_[j].id);
+      // The entry is able to move to the hole if the home is not in (hole, j].
+      if ((j > hole && (home <= hole || home > j)) ||
+          (j < hole && (home <= hole && home > j))) {
+        entries_[hole] = entries_[j];
+        hole = j;
+      }
+    }
+    entries_[hole].id = kEmpty;
+    size_--;
+  }
+
+
+  void Clear() {
+    entries_.clear();
+    size_ = 0;
+  }
+
+ private:
+  static const Unique::Id kEmpty = ~0ull;
+  static const size_t kInitialCapacity = 16;
+
+  struct Entry {
+    Unique::Id id;
+    uint32_t value;
+  };
+
+
+  // The ids are sequential, so the id is scattered by the fibonacci hashing.
+  YATSC_INLINE size_t IndexOf(Unique::Id id) YATSC_NO_SE {
+    return static_cast<size_t>((id * 11400714819323198485ull) >> 32) & (entries_.size() - 1);
+  }
+
+
+  YATSC_INLINE size_t Next(size_t index) YATSC_NO_SE {
+    return (index + 1) & (entries_.size() - 1);
+  }
+
+
+  void Grow() {
+    Vector<Entry> entries(entries_.empty()? kInitialCapacity: entries_.size() * 2, Entry{kEmpty, 0});
+    entries_.swap(entries);
+    for (auto& entry: entries) {
+      if (entry.id != kEmpty) {
+        size_t i = IndexOf(entry.id);
+        while (entries_[i].id != kEmpty) {
+          i = Next(i);
+        }
+        entries_[i] = entry;
+      }
+    }
+  }
+
+  
+  Vector<Entry> entries_;
+  size_t size_;
+};
+
+}
+
+#endif
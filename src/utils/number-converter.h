@@ -0,0 +1,118 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2013 Taketoshi Aono(brn)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+
+#ifndef UTILS_NUMBER_CONVERTER_H
+#define UTILS_NUMBER_CONVERTER_H
+
+#include <limits>
+#include "./utils.h"
+
+namespace yatsc {
+
+// Converts the ascii representation of the ECMAScript numeric literals
+// to the nearest double value.
+// The decimal conversion uses Eisel-Lemire algorithm, that is
+// "Number Parsing at a Gigabyte per Second" by Daniel Lemire,
+// and falls back to strtod only if the result of the fast path is ambiguous.
+class NumberConverter : private Static {
+ public:
+  // Convert the decimal literal like "1.5", ".5", "15e+10".
+  // Trailing characters which are not a part of the decimal literal are ignored.
+  static double ParseDecimal(const char* begin, const char* end);
+
+
+  // Convert the hex literal like "0xFF".
+  // Return NaN if the literal has the prefix of the other radix.
+  static double ParseHex(const char* begin, const char* end) {
+    return ParseRadixLiteral(begin, end, 'x', 4);
+  }
+
+
+  // Convert the binary literal like "0b101".
+  // Return NaN if the literal has the prefix of the other radix.
+  static double ParseBinary(const char* begin, const char* end) {
+    return ParseRadixLiteral(begin, end, 'b', 1);
+  }
+
+
+  // Convert the octal literal like "0o777".
+  // Return NaN if the literal has the prefix of the other radix.
+  static double ParseOctal(const char* begin, const char* end) {
+    return ParseRadixLiteral(begin, end, 'o', 3);
+  }
+
+
+  // Convert the legacy octal literal like "0777".
+  // If the literal contains '8' or '9', it is treated as the decimal literal
+  // like ECMAScript engines do.
+  static double ParseLegacyOctal(const char* begin, const char* end);
+
+ VISIBLE_FOR_TESTING:
+  // Try to convert the decimal mantissa and exponent, mantissa * 10^exponent,
+  // to the double by Eisel-Lemire algorithm.
+  // Return false if the result can not be decided by the fast path.
+  static bool EiselLemire(uint64_t mantissa, int exponent, double* result);
+  
+ private:
+  static const int kMinDecimalExponent = -342;
+  static const int kMaxDecimalExponent = 308;
+  static const int kMaxMantissaDigits = 19;
+
+  // 128bit approximations of the power of ten that is truncated and normalized
+  // to the most significant bit, from 1e-342 to 1e308.
+  struct PowerOfTen {
+    uint64_t high;
+    uint64_t low;
+  };
+  static const PowerOfTen kPowersOfTen[];
+
+
+  YATSC_INLINE static bool IsDigit(char c) {
+    return c >= '0' && c <= '9';
+  }
+
+
+  // Convert the power of two radix literal after the radix prefix like "0x".
+  // The prefix is optional and compared case insensitively.
+  YATSC_INLINE static double ParseRadixLiteral(const char* begin, const char* end,
+                                               char prefix, int bits_per_digit) {
+    if (end - begin >= 2 && begin[0] == '0' && !IsDigit(begin[1])) {
+      if ((begin[1] | 0x20) != prefix) {
+        return std::numeric_limits<double>::quiet_NaN();
+      }
+      begin += 2;
+    }
+    return ParsePowerOfTwoRadix(begin, end, bits_per_digit);
+  }
+
+  
+  static double ParsePowerOfTwoRadix(const char* begin, const char* end, int bits_per_digit);
+
+
+  static double ParseDecimalSlowPath(const char* begin, const char* end);
+};
+
+} // namespace yatsc
+
+#endif // UTILS_NUMBER_CONVERTER_H
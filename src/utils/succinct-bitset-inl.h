@@ -0,0 +1,148 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2013 Taketoshi Aono(brn)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef UTILS_SUCCINCT_BITSET_INL_H
+#define UTILS_SUCCINCT_BITSET_INL_H
+
+#include <algorithm>
+
+#if defined(HAVE_POPCNT64)
+#include <intrin.h>
+#endif
+
+namespace yatsc {
+
+YATSC_INLINE void SuccinctBitset::Resize(size_t size) {
+  size_ = size;
+  words_.assign((size + kWordBits - 1) / kWordBits, 0);
+  block_ranks_.clear();
+}
+
+
+YATSC_INLINE void SuccinctBitset::Set(size_t index, bool val) {
+  ASSERT(true, index < size_);
+  uint64_t bit = static_cast<uint64_t>(1) << (index % kWordBits);
+  if (val) {
+    words_[index / kWordBits] |= bit;
+  } else {
+    words_[index / kWordBits] &= ~bit;
+  }
+}
+
+
+YATSC_INLINE void SuccinctBitset::SetWord(size_t word_index, uint64_t word) {
+  ASSERT(true, word_index < words_.size());
+  words_[word_index] = word;
+}
+
+
+YATSC_INLINE bool SuccinctBitset::Get(size_t index) YATSC_NO_SE {
+  ASSERT(true, index < size_);
+  return ((words_[index / kWordBits] >> (index % kWordBits)) & 1) == 1;
+}
+
+
+YATSC_INLINE void SuccinctBitset::Build() {
+  size_t block_count = (words_.size() + kBlockWords - 1) / kBlockWords;
+  block_ranks_.resize(block_count + 1);
+  uint32_t rank = 0;
+  for (size_t i = 0; i < words_.size(); i++) {
+    if (i % kBlockWords == 0) {
+      block_ranks_[i / kBlockWords] = rank;
+    }
+    rank += static_cast<uint32_t>(PopCount(words_[i]));
+  }
+  block_ranks_[block_count] = rank;
+}
+
+
+YATSC_INLINE size_t SuccinctBitset::Rank(size_t index) YATSC_NO_SE {
+  ASSERT(true, block_ranks_.size() > 0);
+  index = std::min(index, size_);
+  size_t word_index = index / kWordBits;
+  size_t rank = block_ranks_[word_index / kBlockWords];
+  for (size_t i = word_index - word_index % kBlockWords; i < word_index; i++) {
+    rank += PopCount(words_[i]);
+  }
+  size_t bit = index % kWordBits;
+  if (bit > 0) {
+    rank += PopCount(words_[word_index] & ((static_cast<uint64_t>(1) << bit) - 1));
+  }
+  return rank;
+}
+
+
+YATSC_INLINE size_t SuccinctBitset::Select(size_t n) YATSC_NO_SE {
+  ASSERT(true, block_ranks_.size() > 0);
+  if (n == 0 || n > count()) {
+    return size_;
+  }
+
+  // Find the last block that has less than n flaged bits before it.
+  auto found = std::lower_bound(block_ranks_.begin(), block_ranks_.end(), static_cast<uint32_t>(n));
+  size_t block = (found - block_ranks_.begin()) - 1;
+  n -= block_ranks_[block];
+  
+  for (size_t i = block * kBlockWords; i < words_.size(); i++) {
+    size_t rank = PopCount(words_[i]);
+    if (n <= rank) {
+      return i * kWordBits + SelectInWord(words_[i], n);
+    }
+    n -= rank;
+  }
+  UNREACHABLE;
+}
+
+
+YATSC_INLINE size_t SuccinctBitset::PopCount(uint64_t word) {
+#if defined(HAVE_BUILTIN_POPCOUNT)
+  return __builtin_popcountll(word);
+#elif defined(HAVE_POPCNT64)
+  return __popcnt64(word);
+#else
+  word = word - ((word >> 1) & 0x5555555555555555ULL);
+  word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+  word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return (word * 0x0101010101010101ULL) >> 56;
+#endif
+}
+
+
+YATSC_INLINE size_t SuccinctBitset::SelectInWord(uint64_t word, size_t n) {
+  // Drop the lower n - 1 flaged bits, then the lowest flaged bit is the answer.
+  for (size_t i = 1; i < n; i++) {
+    word &= word - 1;
+  }
+#if defined(HAVE_BUILTIN_POPCOUNT)
+  return __builtin_ctzll(word);
+#elif defined(HAVE_POPCNT64)
+  unsigned long index;
+  _BitScanForward64(&index, word);
+  return index;
+#else
+  return PopCount((word & (~word + 1)) - 1);
+#endif
+}
+
+}
+
+#endif
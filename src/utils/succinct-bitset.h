@@ -0,0 +1,114 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2013 Taketoshi Aono(brn)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef UTILS_SUCCINCT_BITSET_H
+#define UTILS_SUCCINCT_BITSET_H
+
+#include "./stl.h"
+#include "./utils.h"
+
+namespace yatsc {
+
+// The bit vector that answers Rank and Select in constant or logarithmic time.
+// Unlike DynamicBitset, the length is fixed after Resize,
+// and the bits are written in bulk by SetWord then the rank directory is
+// built once by Build, so this class suits immutable indexes
+// like the line break bitmap of the source.
+class SuccinctBitset {
+ public:
+  SuccinctBitset()
+      : size_(0) {}
+
+
+  explicit SuccinctBitset(size_t size)
+      : size_(0) {
+    Resize(size);
+  }
+
+
+  // Resize to hold the specified number of bits, all bits are cleared.
+  YATSC_INLINE void Resize(size_t size);
+
+
+  // Set or unset bit of the specified index.
+  YATSC_INLINE void Set(size_t index, bool val);
+
+
+  // Overwrite the 64 bits of the specified word.
+  // The bit i of the word is the bit (word_index * kWordBits + i) of the bitset.
+  YATSC_INLINE void SetWord(size_t word_index, uint64_t word);
+
+
+  // Get bit value of specified index.
+  YATSC_INLINE bool Get(size_t index) YATSC_NO_SE;
+
+
+  // Build the rank directory.
+  // Must be called after the bits are modified and before Rank or Select.
+  YATSC_INLINE void Build();
+
+
+  // Count flaged bits in the range [0, index).
+  YATSC_INLINE size_t Rank(size_t index) YATSC_NO_SE;
+
+
+  // Return the index of the nth(1-origin) flaged bit.
+  // If the bitset has less than n flaged bits, return size().
+  YATSC_INLINE size_t Select(size_t n) YATSC_NO_SE;
+
+
+  // Return the count of all flaged bits.
+  YATSC_INLINE size_t count() YATSC_NO_SE {
+    return block_ranks_.empty()? 0: block_ranks_.back();
+  }
+
+
+  YATSC_INLINE size_t size() YATSC_NO_SE {return size_;}
+
+
+  YATSC_INLINE size_t word_count() YATSC_NO_SE {return words_.size();}
+
+
+  static const size_t kWordBits = 64;
+
+ private:
+  // The rank is sampled every kBlockWords words.
+  static const size_t kBlockWords = 8;
+
+  
+  YATSC_INLINE static size_t PopCount(uint64_t word);
+
+
+  // Return the index of the nth(1-origin) flaged bit in the word.
+  YATSC_INLINE static size_t SelectInWord(uint64_t word, size_t n);
+
+  
+  Vector<uint64_t> words_;
+  Vector<uint32_t> block_ranks_;
+  size_t size_;
+};
+
+}
+
+#include "./succinct-bitset-inl.h"
+
+#endif
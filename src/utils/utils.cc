@@ -44,6 +44,7 @@ void Assert__(bool ok, const char* result, const char* expect, const char* file,
   }
 }
 
-std::atomic_ullong Unique::id_;
+const Unique::Id Unique::kReservedIdCount;
+std::atomic_ullong Unique::id_(Unique::kReservedIdCount);
 
 }
@@ -255,6 +255,9 @@ class Unmovable {
 class Unique: private Static {
  public:
   typedef unsigned long long Id;
+  // The ids that are smaller than this value are never returned by id(),
+  // they are used as the fixed ids of the atoms.
+  static const Id kReservedIdCount = 256;
   static Id id() {return id_++;}
  private:
   static std::atomic_ullong id_;
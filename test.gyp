@@ -188,6 +188,70 @@
         './test/test-main.cc',
       ],
     },
+    {
+      'target_name': 'flat_id_map_test',
+      'type': 'executable',
+      'product_name': 'FlatIdMapTest',
+      'include_dirs' : ['./lib', '/usr/local/include'],
+      'defines' : ['GTEST_HAS_RTTI=0', 'UNIT_TEST=1'],
+      'sources': [
+        './src/utils/utils.cc',
+        './src/utils/tls.cc',
+        './src/utils/systeminfo.cc',
+        './src/memory/virtual-heap-allocator.cc',
+        './src/memory/aligned-heap-allocator.cc',
+        './src/memory/heap-allocator/chunk-header.cc',
+        './src/memory/heap-allocator/arena.cc',
+        './src/memory/heap-allocator/heap-allocator.cc',
+        './src/utils/os.cc',
+        './test/utils/flat-id-map-test.cc',
+        './lib/gtest/gtest-all.cc',
+        './test/test-main.cc',
+      ],
+    },
+    {
+      'target_name': 'succinct_bitset_test',
+      'type': 'executable',
+      'product_name': 'SuccinctBitsetTest',
+      'include_dirs' : ['./lib', '/usr/local/include'],
+      'defines' : ['GTEST_HAS_RTTI=0', 'UNIT_TEST=1'],
+      'sources': [
+        './src/utils/utils.cc',
+        './src/utils/tls.cc',
+        './src/utils/systeminfo.cc',
+        './src/memory/virtual-heap-allocator.cc',
+        './src/memory/aligned-heap-allocator.cc',
+        './src/memory/heap-allocator/chunk-header.cc',
+        './src/memory/heap-allocator/arena.cc',
+        './src/memory/heap-allocator/heap-allocator.cc',
+        './src/utils/os.cc',
+        './test/utils/succinct-bitset-test.cc',
+        './lib/gtest/gtest-all.cc',
+        './test/test-main.cc',
+      ],
+    },
+    {
+      'target_name': 'number_converter_test',
+      'type': 'executable',
+      'product_name': 'NumberConverterTest',
+      'include_dirs' : ['./lib', '/usr/local/include'],
+      'defines' : ['GTEST_HAS_RTTI=0', 'UNIT_TEST=1'],
+      'sources': [
+        './src/utils/utils.cc',
+        './src/utils/tls.cc',
+        './src/utils/systeminfo.cc',
+        './src/memory/virtual-heap-allocator.cc',
+        './src/memory/aligned-heap-allocator.cc',
+        './src/memory/heap-allocator/chunk-header.cc',
+        './src/memory/heap-allocator/arena.cc',
+        './src/memory/heap-allocator/heap-allocator.cc',
+        './src/utils/os.cc',
+        './src/utils/number-converter.cc',
+        './test/utils/number-converter-test.cc',
+        './lib/gtest/gtest-all.cc',
+        './test/test-main.cc',
+      ],
+    },
     {
       'target_name': 'scanner_test',
       'type': 'executable',
@@ -207,6 +271,7 @@
         './src/compiler-option.cc',
         './src/utils/environment.cc',
         './src/parser/token.cc',
+        './src/utils/number-converter.cc',
         './src/parser/error-reporter.cc',
         './src/parser/error-formatter.cc',
         './src/parser/sourcestream.cc',
@@ -240,6 +305,42 @@
         './test/test-main.cc',
       ],
     },
+    {
+      'target_name': 'literalbuffer_test',
+      'product_name': 'LiteralBufferTest',
+      'type': 'executable',
+      'include_dirs' : ['./lib', '/usr/local/include'],
+      'defines' : ['GTEST_HAS_RTTI=0', 'UNIT_TEST=1'],
+      'sources': [
+        './src/utils/utils.cc',
+        './src/utils/tls.cc',
+        './src/utils/systeminfo.cc',
+        './src/memory/virtual-heap-allocator.cc',
+        './src/memory/aligned-heap-allocator.cc',
+        './src/memory/heap-allocator/chunk-header.cc',
+        './src/memory/heap-allocator/arena.cc',
+        './src/memory/heap-allocator/heap-allocator.cc',
+        './src/utils/os.cc',
+        './lib/gtest/gtest-all.cc',
+        './src/parser/unicode-cache.cc',
+        './test/parser/literalbuffer-test.cc',
+        './test/test-main.cc',
+      ],
+    },
+    {
+      'target_name': 'memo_table_test',
+      'product_name': 'MemoTableTest',
+      'type': 'executable',
+      'include_dirs' : ['./lib', '/usr/local/include'],
+      'defines' : ['GTEST_HAS_RTTI=0', 'UNIT_TEST=1'],
+      'sources': [
+        './src/utils/utils.cc',
+        './src/utils/os.cc',
+        './lib/gtest/gtest-all.cc',
+        './test/parser/memo-table-test.cc',
+        './test/test-main.cc',
+      ],
+    },
     {
       'target_name': 'sourcestream_test',
       'product_name': 'SourceStreamTest',
@@ -288,6 +389,58 @@
         './test/test-main.cc'
       ],
     },
+    {
+      'target_name': 'ast_image_test',
+      'product_name': 'AstImageTest',
+      'type': 'executable',
+      'include_dirs' : ['./lib', '/usr/local/include'],
+      'defines' : ['GTEST_HAS_RTTI=0', 'UNIT_TEST=1'],
+      'sources': [
+        './src/utils/utils.cc',
+        './src/utils/tls.cc',
+        './src/utils/systeminfo.cc',
+        './src/memory/virtual-heap-allocator.cc',
+        './src/memory/aligned-heap-allocator.cc',
+        './src/memory/heap-allocator/chunk-header.cc',
+        './src/memory/heap-allocator/arena.cc',
+        './src/memory/heap-allocator/heap-allocator.cc',
+        './src/parser/unicode-cache.cc',
+        './src/utils/os.cc',
+        './src/utils/environment.cc',
+        './lib/gtest/gtest-all.cc',
+        './src/ir/node.cc',
+        './src/ir/scope.cc',
+        './src/ir/ast-image.cc',
+        './test/ir/ast-image-test.cc',
+        './test/test-main.cc'
+      ],
+    },
+    {
+      'target_name': 'scope_test',
+      'product_name': 'ScopeTest',
+      'type': 'executable',
+      'include_dirs' : ['./lib', '/usr/local/include'],
+      'defines' : ['GTEST_HAS_RTTI=0', 'UNIT_TEST=1'],
+      'sources': [
+        './src/utils/utils.cc',
+        './src/utils/tls.cc',
+        './src/utils/systeminfo.cc',
+        './src/memory/virtual-heap-allocator.cc',
+        './src/memory/aligned-heap-allocator.cc',
+        './src/memory/heap-allocator/chunk-header.cc',
+        './src/memory/heap-allocator/arena.cc',
+        './src/memory/heap-allocator/heap-allocator.cc',
+        './src/parser/unicode-cache.cc',
+        './src/utils/os.cc',
+        './src/utils/environment.cc',
+        './lib/gtest/gtest-all.cc',
+        './src/ir/node.cc',
+        './src/ir/scope.cc',
+        './src/ir/types.cc',
+        './test/ir/scope-test.cc',
+        './test/test-main.cc'
+      ],
+    },
     {
       'target_name': 'type_expression_parser_test',
       'product_name': 'TypeExpressionParserTest',
@@ -308,6 +461,7 @@
         './src/utils/os.cc',
         './src/compiler-option.cc',
         './src/parser/token.cc',
+        './src/utils/number-converter.cc',
         './src/parser/error-reporter.cc',
         './src/parser/error-formatter.cc',
         './src/parser/sourcestream.cc',
@@ -341,6 +495,7 @@
         './src/utils/os.cc',
         './src/compiler-option.cc',
         './src/parser/token.cc',
+        './src/utils/number-converter.cc',
         './src/parser/error-reporter.cc',
         './src/parser/error-formatter.cc',
         './src/parser/sourcestream.cc',
@@ -374,6 +529,7 @@
         './src/utils/os.cc',
         './src/compiler-option.cc',
         './src/parser/token.cc',
+        './src/utils/number-converter.cc',
         './src/parser/error-reporter.cc',
         './src/parser/error-formatter.cc',
         './src/parser/sourcestream.cc',
@@ -408,6 +564,7 @@
         './src/utils/os.cc',
         './src/compiler-option.cc',
         './src/parser/token.cc',
+        './src/utils/number-converter.cc',
         './src/parser/error-reporter.cc',
         './src/parser/error-formatter.cc',
         './src/parser/sourcestream.cc',
@@ -441,6 +598,7 @@
         './src/utils/os.cc',
         './src/compiler-option.cc',
         './src/parser/token.cc',
+        './src/utils/number-converter.cc',
         './src/parser/error-reporter.cc',
         './src/parser/error-formatter.cc',
         './src/parser/sourcestream.cc',
@@ -474,6 +632,7 @@
         './src/utils/os.cc',
         './src/compiler-option.cc',
         './src/parser/token.cc',
+        './src/utils/number-converter.cc',
         './src/parser/error-reporter.cc',
         './src/parser/error-formatter.cc',
         './src/parser/sourcestream.cc',
@@ -507,6 +666,7 @@
         './src/utils/os.cc',
         './src/compiler-option.cc',
         './src/parser/token.cc',
+        './src/utils/number-converter.cc',
         './src/parser/error-reporter.cc',
         './src/parser/error-formatter.cc',
         './src/parser/sourcestream.cc',
@@ -520,6 +680,113 @@
         './test/test-main.cc'
       ],
     },
+    {
+      'target_name': 'parallel_scanner_test',
+      'product_name': 'ParallelScannerTest',
+      'type': 'executable',
+      'include_dirs' : ['./lib', '/usr/local/include'],
+      'defines' : ['GTEST_HAS_RTTI=0', 'UNIT_TEST=1'],
+      'sources': [
+        './src/utils/utils.cc',
+        './src/utils/tls.cc',
+        './src/utils/systeminfo.cc',
+        './src/memory/virtual-heap-allocator.cc',
+        './src/memory/aligned-heap-allocator.cc',
+        './src/memory/heap-allocator/chunk-header.cc',
+        './src/memory/heap-allocator/arena.cc',
+        './src/memory/heap-allocator/heap-allocator.cc',
+        './src/compiler/module-info.cc',
+        './src/utils/path.cc',
+        './src/utils/os.cc',
+        './src/compiler-option.cc',
+        './src/parser/token.cc',
+        './src/utils/number-converter.cc',
+        './src/parser/error-reporter.cc',
+        './src/parser/error-formatter.cc',
+        './src/parser/sourcestream.cc',
+        './src/parser/unicode-cache.cc',
+        './src/parser/parallel-scanner.cc',
+        './src/utils/environment.cc',
+        './lib/gtest/gtest-all.cc',
+        './src/ir/node.cc',
+        './src/ir/scope.cc',
+        './src/ir/types.cc',
+        './test/parser/parallel-scanner-test.cc',
+        './test/test-main.cc'
+      ],
+    },
+    {
+      'target_name': 'parallel_parser_test',
+      'product_name': 'ParallelParserTest',
+      'type': 'executable',
+      'include_dirs' : ['./lib', '/usr/local/include'],
+      'defines' : ['GTEST_HAS_RTTI=0', 'UNIT_TEST=1'],
+      'sources': [
+        './src/utils/utils.cc',
+        './src/utils/tls.cc',
+        './src/utils/systeminfo.cc',
+        './src/memory/virtual-heap-allocator.cc',
+        './src/memory/aligned-heap-allocator.cc',
+        './src/memory/heap-allocator/chunk-header.cc',
+        './src/memory/heap-allocator/arena.cc',
+        './src/memory/heap-allocator/heap-allocator.cc',
+        './src/compiler/module-info.cc',
+        './src/utils/path.cc',
+        './src/utils/os.cc',
+        './src/compiler-option.cc',
+        './src/parser/token.cc',
+        './src/utils/number-converter.cc',
+        './src/parser/error-reporter.cc',
+        './src/parser/error-formatter.cc',
+        './src/parser/sourcestream.cc',
+        './src/parser/unicode-cache.cc',
+        './src/parser/parallel-scanner.cc',
+        './src/parser/parallel-parser.cc',
+        './src/utils/environment.cc',
+        './lib/gtest/gtest-all.cc',
+        './src/ir/node.cc',
+        './src/ir/scope.cc',
+        './src/ir/types.cc',
+        './test/parser/parallel-parser-test.cc',
+        './test/test-main.cc'
+      ],
+    },
+    {
+      'target_name': 'dependency_scanner_test',
+      'product_name': 'DependencyScannerTest',
+      'type': 'executable',
+      'include_dirs' : ['./lib', '/usr/local/include'],
+      'defines' : ['GTEST_HAS_RTTI=0', 'UNIT_TEST=1'],
+      'sources': [
+        './src/utils/utils.cc',
+        './src/utils/tls.cc',
+        './src/utils/systeminfo.cc',
+        './src/memory/virtual-heap-allocator.cc',
+        './src/memory/aligned-heap-allocator.cc',
+        './src/memory/heap-allocator/chunk-header.cc',
+        './src/memory/heap-allocator/arena.cc',
+        './src/memory/heap-allocator/heap-allocator.cc',
+        './src/compiler/module-info.cc',
+        './src/utils/path.cc',
+        './src/utils/os.cc',
+        './src/compiler-option.cc',
+        './src/parser/token.cc',
+        './src/utils/number-converter.cc',
+        './src/parser/error-reporter.cc',
+        './src/parser/error-formatter.cc',
+        './src/parser/sourcestream.cc',
+        './src/parser/unicode-cache.cc',
+        './src/parser/parallel-scanner.cc',
+        './src/parser/dependency-scanner.cc',
+        './src/utils/environment.cc',
+        './lib/gtest/gtest-all.cc',
+        './src/ir/node.cc',
+        './src/ir/scope.cc',
+        './src/ir/types.cc',
+        './test/parser/dependency-scanner-test.cc',
+        './test/test-main.cc'
+      ],
+    },
     {
       'target_name': 'compiler_test',
       'product_name': 'CompilerTest',
@@ -540,6 +807,9 @@
         './src/compiler-option.cc',
         './src/compiler/module-info.cc',
         './src/compiler/compiler.cc',
+        './src/parser/dependency-scanner.cc',
+        './src/parser/parallel-scanner.cc',
+        './src/parser/parallel-parser.cc',
         './src/compiler/compilation-unit.cc',
         './src/compiler/thread-pool.cc',
         './src/compiler/channel.cc',
@@ -547,6 +817,7 @@
         './src/compiler/thread-pool-queue.cc',
         './src/parser/sourcestream.cc',
         './src/parser/token.cc',
+        './src/utils/number-converter.cc',
         './src/parser/error-reporter.cc',
         './src/parser/error-formatter.cc',
         './src/parser/unicode-cache.cc',
@@ -555,6 +826,7 @@
         './src/ir/node.cc',
         './src/ir/scope.cc',
         './src/ir/types.cc',
+        './src/ir/ast-image.cc',
         './test/compiler/compiler-test.cc',
         './test/test-main.cc'
       ],
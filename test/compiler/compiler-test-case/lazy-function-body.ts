@@ -0,0 +1,23 @@
+var count = 0;
+
+function add(x: number, y: number): number {
+  var z = x + y;
+  count++;
+  return z;
+}
+
+function outer(values) {
+  var re = /}/g;
+  function inner(value) {
+    return {value: value, matched: re.test(String(value))};
+  }
+  return values.map(inner);
+}
+
+class Counter {
+  constructor(private start: number) {}
+
+  next() {
+    return this.start + add(count, 1);
+  }
+}
@@ -70,3 +70,92 @@ TEST(Compiler, Compile_Ambient) {
   RunCompiler(PRODUCT_DIR"/test/microsoft/typescript/src/lib/webworker.generated.d.ts");
   RunCompiler(PRODUCT_DIR"/test/microsoft/typescript/src/lib/webworker.importscripts.d.ts");
 }
+
+
+TEST(Compiler, GetMemoryUsage) {
+  yatsc::CompilerOption compiler_option;
+  yatsc::Compiler compiler(compiler_option);
+  yatsc::Vector<yatsc::Handle<yatsc::CompilationUnit>> cu = compiler.Compile(PRODUCT_DIR"/test/promises-typescript/lib/Promises.ts");
+  ASSERT_TRUE(CheckCompilationResult(cu));
+  yatsc::MemoryUsage total;
+  for (auto i: cu) {
+    yatsc::MemoryUsage memory_usage = i->GetMemoryUsage();
+    ASSERT_GT(memory_usage.source(), 0u);
+    ASSERT_GT(memory_usage.ir_nodes(), 0u);
+    ASSERT_GT(memory_usage.scopes(), 0u);
+    ASSERT_GE(memory_usage.ir_zone(), memory_usage.ir_nodes() + memory_usage.child_lists() + memory_usage.symbols());
+    total += memory_usage;
+  }
+  ASSERT_EQ(compiler.GetMemoryUsage().total(), total.total());
+}
+
+
+// Return the first node that has the LazyFunctionBodyView child.
+static yatsc::ir::Node* FindLazyFunction(yatsc::ir::Node* node) {
+  for (auto child: node->node_list()) {
+    if (child == nullptr) {
+      continue;
+    }
+    if (child->HasLazyFunctionBodyView()) {
+      return node;
+    }
+    yatsc::ir::Node* found = FindLazyFunction(child);
+    if (found != nullptr) {
+      return found;
+    }
+  }
+  return nullptr;
+}
+
+
+// Count the variable names in the tree that are not bound to any declaration.
+static size_t CountUnresolvedNames(yatsc::ir::Node* node) {
+  size_t count = 0;
+  if (node->HasNameView() && node->symbol()->type() == yatsc::ir::SymbolType::kVariableName &&
+      !node->ToNameView()->binding().resolved()) {
+    count++;
+  }
+  for (auto child: node->node_list()) {
+    if (child != nullptr) {
+      count += CountUnresolvedNames(child);
+    }
+  }
+  return count;
+}
+
+
+TEST(Compiler, ParseLazyFunctionBody) {
+  const char* filename = PRODUCT_DIR"/test/compiler/compiler-test-case/lazy-function-body.ts";
+  yatsc::CompilerOption eager_option;
+  yatsc::Compiler eager_compiler(eager_option);
+  yatsc::Vector<yatsc::Handle<yatsc::CompilationUnit>> eager_cu = eager_compiler.Compile(filename);
+  ASSERT_EQ(eager_cu.size(), 1u);
+  ASSERT_TRUE(CheckCompilationResult(eager_cu));
+  
+  yatsc::CompilerOption compiler_option;
+  compiler_option.set_lazy_function_body(true);
+  yatsc::Compiler compiler(compiler_option);
+  yatsc::Vector<yatsc::Handle<yatsc::CompilationUnit>> cu = compiler.Compile(filename);
+  ASSERT_EQ(cu.size(), 1u);
+  ASSERT_TRUE(CheckCompilationResult(cu));
+
+  // The parser of the module is already destroyed here.
+  yatsc::Handle<yatsc::CompilationUnit> unit = cu[0];
+  size_t expanded = 0;
+  yatsc::ir::Node* function = FindLazyFunction(unit->root());
+  while (function != nullptr) {
+    auto result = compiler.ParseLazyFunctionBody(unit, function);
+    ASSERT_TRUE(result);
+    ASSERT_TRUE(result.value()->HasBlockView());
+    ASSERT_EQ(result.value()->parent_node(), function);
+    ASSERT_TRUE(unit->success());
+    expanded++;
+    function = FindLazyFunction(unit->root());
+  }
+  
+  // add, outer, inner that is found in the body of outer, constructor and next.
+  ASSERT_EQ(expanded, 5u);
+  // The expanded tree is same as the tree that is parsed eagerly, and the names are bound same.
+  ASSERT_STREQ(eager_cu[0]->root()->ToStringTree().c_str(), unit->root()->ToStringTree().c_str());
+  ASSERT_EQ(CountUnresolvedNames(eager_cu[0]->root()), CountUnresolvedNames(unit->root()));
+}
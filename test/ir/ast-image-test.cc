@@ -0,0 +1,137 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) Taketoshi Aono(brn)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "../gtest-header.h"
+#include "../../src/ir/node.h"
+#include "../../src/ir/irfactory.h"
+#include "../../src/ir/ast-image.h"
+#include "../../src/parser/literalbuffer.h"
+
+
+class AstImageTest: public ::testing::Test {
+ protected:
+  AstImageTest()
+      : literal_buffer_(yatsc::Heap::NewHandle<yatsc::LiteralBuffer>()) {}
+
+
+  const yatsc::Literal* NewLiteral(const char* value) {
+    yatsc::UtfString utf_string(value);
+    return literal_buffer_->InsertValue(utf_string);
+  }
+  
+  
+  yatsc::ir::IRFactory irfactory_;
+  yatsc::Handle<yatsc::LiteralBuffer> literal_buffer_;
+};
+
+
+TEST_F(AstImageTest, Write) {
+  auto name = irfactory_.New<yatsc::ir::NameView>(
+      irfactory_.NewSymbol(yatsc::ir::SymbolType::kVariableName, NewLiteral("foo")));
+  auto number = irfactory_.New<yatsc::ir::NumberView>(NewLiteral("1.5"), 1.5);
+  auto value = irfactory_.New<yatsc::ir::BinaryExprView>(yatsc::TokenKind::kPlus, number, number->Clone());
+  auto var = irfactory_.New<yatsc::ir::VariableView>(name, value, yatsc::ir::Node::Null());
+  var->SetInformationForNode(yatsc::SourcePosition(4, 15));
+
+  yatsc::Vector<yatsc::Byte> buffer = yatsc::ir::AstImage::Write(var);
+  // The image has no pointer, so the copy in the other memory is readable.
+  yatsc::Vector<yatsc::Byte> copied(buffer);
+  buffer.clear();
+  yatsc::ir::AstImage image(copied.data(), copied.size());
+  ASSERT_TRUE(image.IsValid());
+  ASSERT_EQ(image.node_count(), 5u);
+  // The literal of the numbers is shared.
+  ASSERT_EQ(image.literal_count(), 2u);
+
+  auto root = image.root();
+  ASSERT_EQ(root.node_type(), yatsc::ir::NodeType::kVariableView);
+  ASSERT_EQ(root.size(), 3u);
+  ASSERT_EQ(root.source_position().start_offset(), 4u);
+  ASSERT_EQ(root.source_position().end_offset(), 15u);
+  ASSERT_FALSE(root.at(2));
+
+  auto name_ref = root.at(0);
+  ASSERT_TRUE(name_ref.HasSymbol());
+  ASSERT_EQ(name_ref.symbol_type(), yatsc::ir::SymbolType::kVariableName);
+  ASSERT_STREQ(name_ref.utf8_symbol_value(), "foo");
+
+  auto value_ref = root.at(1);
+  ASSERT_EQ(value_ref.node_type(), yatsc::ir::NodeType::kBinaryExprView);
+  ASSERT_EQ(value_ref.operand(), yatsc::TokenKind::kPlus);
+  ASSERT_EQ(value_ref.at(1).double_value(), 1.5);
+  ASSERT_STREQ(value_ref.at(1).utf8_string_value(), "1.5");
+}
+
+
+TEST_F(AstImageTest, Invalid) {
+  yatsc::Vector<yatsc::Byte> buffer = yatsc::ir::AstImage::Write(irfactory_.New<yatsc::ir::ThisView>());
+  ASSERT_TRUE(yatsc::ir::AstImage(buffer.data(), buffer.size()).IsValid());
+  ASSERT_FALSE(yatsc::ir::AstImage(buffer.data(), buffer.size() - 1).IsValid());
+  buffer[0] = 0;
+  ASSERT_FALSE(yatsc::ir::AstImage(buffer.data(), buffer.size()).IsValid());
+
+  yatsc::Vector<yatsc::Byte> empty = yatsc::ir::AstImage::Write(nullptr);
+  yatsc::ir::AstImage empty_image(empty.data(), empty.size());
+  ASSERT_TRUE(empty_image.IsValid());
+  ASSERT_FALSE(empty_image.root());
+}
+
+
+TEST_F(AstImageTest, Corrupted) {
+  auto name = irfactory_.New<yatsc::ir::NameView>(
+      irfactory_.NewSymbol(yatsc::ir::SymbolType::kVariableName, NewLiteral("foo")));
+  auto number = irfactory_.New<yatsc::ir::NumberView>(NewLiteral("1.5"), 1.5);
+  auto var = irfactory_.New<yatsc::ir::VariableView>(name, number, yatsc::ir::Node::Null());
+  const yatsc::Vector<yatsc::Byte> buffer = yatsc::ir::AstImage::Write(var);
+  ASSERT_TRUE(yatsc::ir::AstImage(buffer.data(), buffer.size()).IsValid());
+
+  yatsc::ir::AstImageHeader header;
+  memcpy(&header, buffer.data(), sizeof(yatsc::ir::AstImageHeader));
+  uint32_t name_offset = header.header_size;
+  uint32_t number_offset = name_offset + sizeof(yatsc::ir::AstImageNode);
+  uint32_t children = header.root + sizeof(yatsc::ir::AstImageNode);
+
+  auto corrupt = [&](size_t offset, uint32_t value) {
+    yatsc::Vector<yatsc::Byte> corrupted(buffer);
+    memcpy(corrupted.data() + offset, &value, sizeof(uint32_t));
+    return yatsc::ir::AstImage(corrupted.data(), corrupted.size()).IsValid();
+  };
+
+  // The unchanged value keeps the image valid.
+  ASSERT_TRUE(corrupt(children, name_offset));
+  // The child points to the middle of the record.
+  ASSERT_FALSE(corrupt(children, number_offset + 4));
+  // The child points to the parent itself.
+  ASSERT_FALSE(corrupt(children + sizeof(uint32_t), header.root));
+  // The child points outside of the image.
+  ASSERT_FALSE(corrupt(children, 0xFFFFFF00));
+  // The child count runs over the position table.
+  ASSERT_FALSE(corrupt(header.root + offsetof(yatsc::ir::AstImageNode, child_count), 0x40000000));
+  ASSERT_FALSE(corrupt(name_offset + offsetof(yatsc::ir::AstImageNode, index), header.node_count));
+  ASSERT_FALSE(corrupt(name_offset + offsetof(yatsc::ir::AstImageNode, symbol), header.literal_count));
+  ASSERT_FALSE(corrupt(number_offset + offsetof(yatsc::ir::AstImageNode, value), header.literal_count));
+  ASSERT_FALSE(corrupt(number_offset + offsetof(yatsc::ir::AstImageNode, number), header.number_count));
+  ASSERT_FALSE(corrupt(offsetof(yatsc::ir::AstImageHeader, root), number_offset + 4));
+  // The string runs over the string area.
+  ASSERT_FALSE(corrupt(header.literal_table + offsetof(yatsc::ir::AstImageLiteral, length), header.image_size));
+  ASSERT_FALSE(corrupt(header.literal_table + offsetof(yatsc::ir::AstImageLiteral, offset), 0));
+}
@@ -24,12 +24,13 @@
 #include "../gtest-header.h"
 #include "../../src/ir/node.h"
 #include "../../src/ir/irfactory.h"
+#include "../../src/ir/node-visitor.h"
 
 
 class DummyView: public yatsc::ir::Node {
  public:
   DummyView():
-      Node(yatsc::ir::NodeType::kUndefinedView, 0) {}
+      Node(yatsc::ir::NodeType::kUndefinedView) {}
 };
 
 
@@ -233,3 +234,190 @@ TEST_F(NodeTest, ReturnStatementView_test) {
   rn->set_expr(yatsc::ir::Node::Null());
   ASSERT_FALSE(rn->expr());
 }
+
+
+TEST_F(NodeTest, VariableDeclView_InsertLast_grow_test) {
+  yatsc::ir::VariableDeclView* var_decl = irfactory.New<yatsc::ir::VariableDeclView>();
+  yatsc::ir::Node* nodes[100];
+  for (int i = 0; i < 100; i++) {
+    nodes[i] = irfactory.New<DummyView>();
+    var_decl->InsertLast(nodes[i]);
+  }
+  ASSERT_EQ(var_decl->size(), 100u);
+  for (int i = 0; i < 100; i++) {
+    ASSERT_EQ(var_decl->at(i), nodes[i]);
+  }
+}
+
+
+TEST_F(NodeTest, IfStatementView_InsertLast_test) {
+  yatsc::ir::Node* then_block = irfactory.New<DummyView>();
+  yatsc::ir::Node* else_block = irfactory.New<DummyView>();
+  yatsc::ir::Node* expr = irfactory.New<DummyView>();
+  yatsc::ir::Node* last = irfactory.New<DummyView>();
+  yatsc::ir::IfStatementView* ifv = irfactory.New<yatsc::ir::IfStatementView>(expr, then_block, else_block);
+  // The children are moved out of the inline array.
+  ifv->InsertLast(last);
+  ASSERT_EQ(ifv->size(), 4u);
+  ASSERT_EQ(ifv->then_block(), then_block);
+  ASSERT_EQ(ifv->else_block(), else_block);
+  ASSERT_EQ(ifv->at(3), last);
+}
+
+
+TEST_F(NodeTest, BlockView_InsertLast_reserve_test) {
+  yatsc::ir::BlockView* block = irfactory.New<yatsc::ir::BlockView>(yatsc::Heap::NewHandle<yatsc::ir::Scope>());
+  ASSERT_EQ(block->node_list().capacity(), 0u);
+  // The first child reserves the slots by the arity of the VIEW_LIST.
+  block->InsertLast(irfactory.New<DummyView>());
+  ASSERT_EQ(block->node_list().capacity(), yatsc::ir::kNodeArityList[static_cast<uint8_t>(yatsc::ir::NodeType::kBlockView)]);
+
+  yatsc::ir::CallArgsView* args = irfactory.New<yatsc::ir::CallArgsView>();
+  args->InsertFront(irfactory.New<DummyView>());
+  ASSERT_EQ(args->node_list().capacity(), yatsc::ir::kNodeArityList[static_cast<uint8_t>(yatsc::ir::NodeType::kCallArgsView)]);
+}
+
+
+TEST_F(NodeTest, Clone_test) {
+  yatsc::ir::Node* expr = irfactory.New<yatsc::ir::NumberView>(nullptr, 1);
+  yatsc::ir::Node* then_block = irfactory.New<DummyView>();
+  yatsc::ir::IfStatementView* ifv = irfactory.New<yatsc::ir::IfStatementView>(expr, then_block, yatsc::ir::Node::Null());
+  yatsc::ir::Node* cloned = ifv->Clone();
+  ASSERT_EQ(cloned->size(), 3u);
+  ASSERT_TRUE(cloned->HasIfStatementView());
+  ASSERT_TRUE(cloned->at(0)->HasNumberView());
+  ASSERT_EQ(cloned->at(0)->double_value(), 1);
+  ASSERT_EQ(cloned->at(2), yatsc::ir::Node::Null());
+}
+
+
+TEST_F(NodeTest, Clone_Equals_deep_tree_test) {
+  // The tree that is deeper than the native stack can walk recursively.
+  static const size_t kDepth = 1000000u;
+  yatsc::ir::Node* root = irfactory.New<DummyView>();
+  yatsc::ir::Node* current = root;
+  for (size_t i = 0u; i < kDepth; i++) {
+    yatsc::ir::Node* child = irfactory.New<DummyView>();
+    current->InsertLast(child);
+    current = child;
+  }
+  yatsc::ir::Node* cloned = root->Clone();
+  ASSERT_TRUE(root->Equals(cloned));
+  current->InsertLast(irfactory.New<DummyView>());
+  ASSERT_FALSE(root->Equals(cloned));
+}
+
+
+TEST_F(NodeTest, ToStringTree_test) {
+  yatsc::ir::Node* expr = irfactory.New<yatsc::ir::NumberView>(nullptr, 1);
+  yatsc::ir::Node* then_block = irfactory.New<DummyView>();
+  then_block->InsertLast(irfactory.New<DummyView>());
+  yatsc::ir::IfStatementView* ifv = irfactory.New<yatsc::ir::IfStatementView>(expr, then_block, yatsc::ir::Node::Null());
+  ASSERT_STREQ(ifv->ToStringTree().c_str(),
+               "[IfStatementView]\n"
+               "  [NumberView][1]\n"
+               "  [UndefinedView]\n"
+               "    [UndefinedView]\n"
+               "  [Empty]");
+}
+
+
+class CountingVisitor: public yatsc::ir::NodeVisitor<CountingVisitor> {
+ public:
+  CountingVisitor()
+      : if_count(0),
+        node_count(0),
+        leave_count(0) {}
+  
+  
+  yatsc::ir::VisitResult EnterIfStatementView(yatsc::ir::IfStatementView* node) {
+    if_count++;
+    return yatsc::ir::VisitResult::kContinue;
+  }
+
+
+  yatsc::ir::VisitResult EnterNode(yatsc::ir::Node* node) {
+    node_count++;
+    return node->HasBlockView()? yatsc::ir::VisitResult::kSkipChildren: yatsc::ir::VisitResult::kContinue;
+  }
+
+
+  void LeaveNode(yatsc::ir::Node* node) {
+    leave_count++;
+  }
+
+  
+  int if_count;
+  int node_count;
+  int leave_count;
+};
+
+
+TEST_F(NodeTest, NodeVisitor_test) {
+  yatsc::ir::BlockView* block = irfactory.New<yatsc::ir::BlockView>(yatsc::Heap::NewHandle<yatsc::ir::Scope>());
+  block->InsertLast(irfactory.New<DummyView>());
+  yatsc::ir::IfStatementView* ifv = irfactory.New<yatsc::ir::IfStatementView>(
+      irfactory.New<DummyView>(), block, yatsc::ir::Node::Null());
+  CountingVisitor visitor;
+  ASSERT_TRUE(visitor.Walk(ifv));
+  // The IfStatementView is dispatched to the specific hook and the children of the BlockView are skipped.
+  ASSERT_EQ(visitor.if_count, 1);
+  ASSERT_EQ(visitor.node_count, 2);
+  ASSERT_EQ(visitor.leave_count, 3);
+}
+
+
+TEST_F(NodeTest, structural_hash_test) {
+  yatsc::ir::Node* a = irfactory.New<yatsc::ir::IfStatementView>(
+      irfactory.New<yatsc::ir::NumberView>(nullptr, 1), irfactory.New<DummyView>(), yatsc::ir::Node::Null());
+  yatsc::ir::Node* b = irfactory.New<yatsc::ir::IfStatementView>(
+      irfactory.New<yatsc::ir::NumberView>(nullptr, 2), irfactory.New<DummyView>(), yatsc::ir::Node::Null());
+  yatsc::ir::Node* c = irfactory.New<yatsc::ir::IfStatementView>(
+      irfactory.New<yatsc::ir::NumberView>(nullptr, 1), irfactory.New<DummyView>(), irfactory.New<DummyView>());
+  // The values are not the part of the shape.
+  ASSERT_NE(a->structural_hash(), 0u);
+  ASSERT_EQ(a->structural_hash(), b->structural_hash());
+  ASSERT_NE(a->structural_hash(), c->structural_hash());
+  ASSERT_FALSE(a->Equals(c));
+
+  // The change of the descendant clears the cache of the ancestors.
+  uint16_t hash = a->structural_hash();
+  a->node_list()[1]->InsertLast(irfactory.New<DummyView>());
+  ASSERT_NE(a->structural_hash(), hash);
+  ASSERT_FALSE(a->Equals(b));
+  b->node_list()[1]->InsertLast(irfactory.New<DummyView>());
+  ASSERT_EQ(a->structural_hash(), b->structural_hash());
+}
+
+
+TEST_F(NodeTest, InternSubtree_test) {
+  yatsc::ir::IRFactory irfactory;
+  auto new_tree = [&](double value) {
+    yatsc::ir::Node* block = irfactory.New<DummyView>();
+    block->InsertLast(irfactory.New<yatsc::ir::NumberView>(nullptr, value));
+    block->InsertLast(irfactory.New<DummyView>());
+    return block;
+  };
+  yatsc::ir::Node* a = new_tree(1);
+  yatsc::ir::Node* a2 = new_tree(1);
+  yatsc::ir::Node* b = new_tree(2);
+  ASSERT_TRUE(a->Identical(a2));
+  ASSERT_FALSE(a->Identical(b));
+  ASSERT_EQ(a->IdentityHash(), a2->IdentityHash());
+  ASSERT_EQ(irfactory.InternSubtree(a), a);
+  ASSERT_EQ(irfactory.InternSubtree(a2), a);
+  ASSERT_EQ(irfactory.InternSubtree(b), b);
+}
+
+
+TEST_F(NodeTest, AllocatedSize_test) {
+  yatsc::ir::Node* ifv = irfactory.New<yatsc::ir::IfStatementView>(
+      irfactory.New<DummyView>(), irfactory.New<DummyView>(), yatsc::ir::Node::Null());
+  // The children of the fixed arity view are in the view.
+  ASSERT_EQ(ifv->AllocatedSize(), sizeof(yatsc::ir::IfStatementView));
+  ASSERT_EQ(ifv->node_list().zone_storage_size(), 0u);
+
+  yatsc::ir::Node* block = irfactory.New<yatsc::ir::BlockView>(yatsc::Heap::NewHandle<yatsc::ir::Scope>());
+  block->InsertLast(irfactory.New<DummyView>());
+  ASSERT_EQ(block->node_list().zone_storage_size(), block->node_list().capacity() * sizeof(yatsc::ir::Node*));
+}
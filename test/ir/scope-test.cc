@@ -21,5 +21,188 @@
 // THE SOFTWARE.
 
 #include "../gtest-header.h"
+#include "../../src/ir/node.h"
+#include "../../src/ir/irfactory.h"
+#include "../../src/ir/scope.h"
+#include "../../src/ir/scope-resolver.h"
+#include "../../src/parser/literalbuffer.h"
 
 
+class ScopeTest: public ::testing::Test {
+ protected:
+  ScopeTest()
+      : literal_buffer_(yatsc::Heap::NewHandle<yatsc::LiteralBuffer>()),
+        global_scope_(yatsc::Heap::NewHandle<yatsc::ir::GlobalScope>(literal_buffer_)),
+        scope_(yatsc::Heap::NewHandle<yatsc::ir::Scope>(global_scope_, global_scope_)) {}
+
+
+  yatsc::ir::Node* NewVariable(const char* name) {
+    yatsc::UtfString utf_string(name);
+    auto symbol = irfactory_.NewSymbol(
+        yatsc::ir::SymbolType::kVariableName, literal_buffer_->InsertValue(utf_string));
+    return irfactory_.New<yatsc::ir::VariableView>(
+        irfactory_.New<yatsc::ir::NameView>(symbol), nullptr, nullptr);
+  }
+
+
+  bool IsDeclared(yatsc::ir::Node* var) {
+    return scope_->FindDeclaredItem(var->first_child()->symbol());
+  }
+  
+  
+  yatsc::ir::IRFactory irfactory_;
+  yatsc::Handle<yatsc::LiteralBuffer> literal_buffer_;
+  yatsc::Handle<yatsc::ir::GlobalScope> global_scope_;
+  yatsc::Handle<yatsc::ir::Scope> scope_;
+};
+
+
+TEST_F(ScopeTest, Declare) {
+  auto a = NewVariable("a");
+  scope_->Declare(a);
+  ASSERT_EQ(scope_->declaration_count(), 1u);
+  ASSERT_TRUE(IsDeclared(a));
+}
+
+
+TEST_F(ScopeTest, UndoDeclarations) {
+  auto a = NewVariable("a");
+  auto b = NewVariable("b");
+  auto a2 = NewVariable("a");
+  scope_->Declare(a);
+  size_t count = scope_->declaration_count();
+  scope_->Declare(b);
+  scope_->Declare(a2);
+  ASSERT_EQ(scope_->declaration_count(), 3u);
+
+  scope_->UndoDeclarations(count);
+  ASSERT_EQ(scope_->declaration_count(), count);
+  ASSERT_FALSE(IsDeclared(b));
+  ASSERT_TRUE(IsDeclared(a));
+
+  // Only the item declared before the count is left.
+  auto range = scope_->FindDeclaredItem(a->first_child()->symbol()).value();
+  ASSERT_EQ(std::distance(range.first, range.second), 1);
+}
+
+
+TEST_F(ScopeTest, Merge) {
+  auto child = yatsc::Heap::NewHandle<yatsc::ir::Scope>(scope_, global_scope_);
+  auto a = NewVariable("a");
+  auto b = NewVariable("b");
+  child->Declare(a);
+  child->Declare(b);
+  ASSERT_FALSE(IsDeclared(a));
+
+  scope_->Merge(child);
+  ASSERT_EQ(scope_->declaration_count(), 2u);
+  ASSERT_TRUE(IsDeclared(a));
+  ASSERT_TRUE(IsDeclared(b));
+
+  // The merged items are undone in the merged order.
+  scope_->UndoDeclarations(1);
+  ASSERT_TRUE(IsDeclared(a));
+  ASSERT_FALSE(IsDeclared(b));
+}
+
+
+TEST_F(ScopeTest, InternedSymbol) {
+  auto a = NewVariable("a");
+  auto a2 = NewVariable("a");
+  auto b = NewVariable("b");
+  // The same name shares the symbol and the different name or type does not.
+  ASSERT_EQ(a->first_child()->symbol(), a2->first_child()->symbol());
+  ASSERT_NE(a->first_child()->symbol(), b->first_child()->symbol());
+  ASSERT_NE(a->first_child()->symbol(),
+            irfactory_.NewSymbol(yatsc::ir::SymbolType::kLabelName, a->first_child()->symbol()->value()));
+}
+
+
+TEST_F(ScopeTest, ManyDeclarations) {
+  // The scope that has many items finds the item by the index.
+  static const int kCount = 100;
+  yatsc::Vector<yatsc::ir::Node*> vars;
+  for (int i = 0; i < kCount; i++) {
+    vars.push_back(NewVariable(("v" + std::to_string(i)).c_str()));
+    scope_->Declare(vars.back());
+  }
+  size_t count = scope_->declaration_count();
+  auto shadow = NewVariable("v0");
+  scope_->Declare(shadow);
+  for (auto var: vars) {
+    ASSERT_TRUE(IsDeclared(var));
+  }
+  ASSERT_FALSE(IsDeclared(NewVariable("v100")));
+
+  // The newest item is found first.
+  auto range = scope_->FindDeclaredItem(shadow->first_child()->symbol()).value();
+  ASSERT_EQ(std::distance(range.first, range.second), 2);
+  ASSERT_EQ(range.first->info().node(), shadow);
+
+  scope_->UndoDeclarations(count);
+  range = scope_->FindDeclaredItem(shadow->first_child()->symbol()).value();
+  ASSERT_EQ(std::distance(range.first, range.second), 1);
+  ASSERT_EQ(range.first->info().node(), vars[0]);
+
+  scope_->UndoDeclarations(1);
+  ASSERT_TRUE(IsDeclared(vars[0]));
+  ASSERT_FALSE(IsDeclared(vars[1]));
+  ASSERT_FALSE(IsDeclared(vars[kCount - 1]));
+}
+
+
+TEST_F(ScopeTest, Resolve) {
+  auto child = yatsc::Heap::NewHandle<yatsc::ir::Scope>(scope_, global_scope_);
+  auto a = NewVariable("a");
+  auto b = NewVariable("b");
+  auto a2 = NewVariable("a");
+  scope_->Declare(a);
+  scope_->Declare(b);
+  child->Declare(a2);
+
+  // The name of the inner scope shadows the outer name.
+  auto binding = child->Resolve(a->first_child()->symbol()->value());
+  ASSERT_EQ(binding.depth(), 0u);
+  ASSERT_EQ(child->ItemAt(binding).info().node(), a2);
+
+  binding = child->Resolve(b->first_child()->symbol()->value());
+  ASSERT_EQ(binding.depth(), 1u);
+  ASSERT_EQ(binding.slot(), 1u);
+  ASSERT_EQ(child->ItemAt(binding).info().node(), b);
+
+  ASSERT_FALSE(child->Resolve(NewVariable("c")->first_child()->symbol()->value()).resolved());
+}
+
+
+TEST_F(ScopeTest, ScopeResolver) {
+  // file scope {var a; var b; {var a; a; b; a; c;}}
+  auto a = NewVariable("a");
+  auto b = NewVariable("b");
+  auto a2 = NewVariable("a");
+  scope_->Declare(a);
+  scope_->Declare(b);
+  auto block_scope = yatsc::Heap::NewHandle<yatsc::ir::Scope>(scope_, global_scope_);
+  block_scope->Declare(a2);
+
+  auto file_scope = irfactory_.New<yatsc::ir::FileScopeView>(scope_);
+  auto block = irfactory_.New<yatsc::ir::BlockView>(block_scope);
+  file_scope->InsertLast(a);
+  file_scope->InsertLast(b);
+  file_scope->InsertLast(block);
+  block->InsertLast(a2);
+  yatsc::ir::Node* refs[] = {NewVariable("a")->first_child(), NewVariable("b")->first_child(),
+                             NewVariable("a")->first_child(), NewVariable("c")->first_child()};
+  for (auto ref: refs) {
+    block->InsertLast(ref);
+  }
+
+  yatsc::ir::ScopeResolver scope_resolver;
+  // The declarations a, b, a2 and the references except c are resolved.
+  ASSERT_EQ(scope_resolver.Resolve(file_scope), 6u);
+  ASSERT_EQ(block_scope->ItemAt(refs[0]->ToNameView()->binding()).info().node(), a2);
+  ASSERT_EQ(refs[1]->ToNameView()->binding().depth(), 1u);
+  ASSERT_EQ(block_scope->ItemAt(refs[1]->ToNameView()->binding()).info().node(), b);
+  ASSERT_EQ(block_scope->ItemAt(refs[2]->ToNameView()->binding()).info().node(), a2);
+  ASSERT_FALSE(refs[3]->ToNameView()->binding().resolved());
+  ASSERT_EQ(scope_->ItemAt(a->first_child()->ToNameView()->binding()).info().node(), a);
+}
@@ -24,6 +24,7 @@
 
 
 #include "../../gtest-header.h"
+#include <string.h>
 #include <thread>
 #include "../../../src/memory/heap-allocator/arena.h"
 
@@ -131,3 +132,83 @@ TEST(CentralArena, Dealloc_thread) {
   while (x.load() != 2) {}
 }
 
+
+TEST(CentralArena, Dealloc_large_same_size) {
+  yatsc::heap::CentralArena arena;
+  const size_t size = 128 * 1024;
+  void* older = arena.Allocate(size);
+  void* newer = arena.Allocate(size);
+  memset(older, 1, size);
+  memset(newer, 2, size);
+
+  // The older heap is linked from the newer heap that has the same size,
+  // so the link must be removed before the older heap is unmapped.
+  arena.Dealloc(older);
+  ASSERT_EQ(static_cast<yatsc::Byte*>(newer)[size - 1], 2);
+  arena.Dealloc(newer);
+
+  void* again = arena.Allocate(size);
+  memset(again, 3, size);
+  arena.Dealloc(again);
+}
+
+
+TEST(CentralArena, Allocate_near_small_object_limit) {
+  yatsc::heap::CentralArena arena;
+  const size_t limit = yatsc::heap::ChunkHeader::kChunkMaxAllocatableSmallObjectSize;
+  const size_t sizes[] = {limit - 64, limit - 16, limit - 8, limit - 1, limit};
+  for (size_t size: sizes) {
+    // The whole block is written, so the block that overflows the heap breaks the next block.
+    yatsc::Byte* a = static_cast<yatsc::Byte*>(arena.Allocate(size));
+    yatsc::Byte* b = static_cast<yatsc::Byte*>(arena.Allocate(size));
+    memset(a, 1, size);
+    memset(b, 2, size);
+    ASSERT_EQ(a[0], 1);
+    ASSERT_EQ(a[size - 1], 1);
+    ASSERT_EQ(b[0], 2);
+    ASSERT_EQ(b[size - 1], 2);
+    arena.Dealloc(a);
+    arena.Dealloc(b);
+  }
+}
+
+
+TEST(CentralArena, Allocate_large_page_size) {
+  yatsc::heap::CentralArena arena;
+  // The header and the body fill the pages exactly,
+  // so the last byte is only writable if the tag bit is reserved.
+  const size_t size = 256 * 1024 - sizeof(yatsc::heap::LargeHeader);
+  yatsc::Byte* large = static_cast<yatsc::Byte*>(arena.Allocate(size));
+  large[size - 1] = 1;
+  ASSERT_EQ(large[size - 1], 1);
+  arena.Dealloc(large);
+}
+
+
+TEST(CentralArena, Dealloc_large_mixed_order) {
+  yatsc::heap::CentralArena arena;
+  const size_t sizes[] = {96 * 1024, 128 * 1024, 96 * 1024, 256 * 1024, 128 * 1024, 96 * 1024};
+  const size_t count = sizeof(sizes) / sizeof(size_t);
+  void* heaps[count];
+  for (size_t i = 0; i < count; i++) {
+    heaps[i] = arena.Allocate(sizes[i]);
+    memset(heaps[i], static_cast<int>(i), sizes[i]);
+  }
+
+  // Free the heaps from the middle, the oldest and the newest,
+  // the other heaps must keep their contents.
+  const size_t order[] = {2, 0, 5, 3, 1, 4};
+  for (size_t i = 0; i < count; i++) {
+    arena.Dealloc(heaps[order[i]]);
+    heaps[order[i]] = nullptr;
+    for (size_t j = 0; j < count; j++) {
+      if (heaps[j] != nullptr) {
+        ASSERT_EQ(static_cast<yatsc::Byte*>(heaps[j])[sizes[j] - 1], static_cast<yatsc::Byte>(j));
+      }
+    }
+  }
+
+  void* again = arena.Allocate(128 * 1024);
+  memset(again, 0, 128 * 1024);
+  arena.Dealloc(again);
+}
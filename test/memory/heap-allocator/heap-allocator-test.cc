@@ -167,6 +167,34 @@ TEST_F(Heap, NewHandle) {
 }
 
 
+TEST_F(Heap, NewLocalHandle) {
+  uint64_t ok = 0u;
+  for (size_t i = 0u; i < kSize; i++) {
+    yatsc::LocalHandle<Test1<uint64_t>> a = yatsc::Heap::NewLocalHandle<Test1D<uint64_t>>(&ok);
+    yatsc::LocalHandle<Test1<uint64_t>> b = a;
+    yatsc::LocalHandle<Base> c = b;
+  }
+  ASSERT_EQ(ok, kSize);
+}
+
+
+TEST_F(Heap, LocalHandle_Share) {
+  uint64_t ok = 0u;
+  {
+    yatsc::Handle<Test1<uint64_t>> shared;
+    {
+      auto a = yatsc::Heap::NewLocalHandle<Test1<uint64_t>>(&ok);
+      shared = a.Share();
+      ASSERT_FALSE(a);
+    }
+    // The shared object is released by the Handle.
+    ASSERT_EQ(ok, 0u);
+    ASSERT_EQ(shared->x, 1);
+  }
+  ASSERT_EQ(ok, 1u);
+}
+
+
 TEST_F(Heap, Allocate_loop) {
   volatile TestClass* v;
   for (uint64_t i = 0; i < kSize;i++) {
@@ -284,6 +312,19 @@ TEST_F(Heap, New_allocate_many_big_object_and_dealloc) {
 }
 
 
+TEST_F(Heap, UnsafeZoneAllocator_NewLargePtr) {
+  yatsc::UnsafeZoneAllocator zone(1 KB);
+  auto small = reinterpret_cast<uint64_t*>(zone.NewPtr(sizeof(uint64_t)));
+  auto large = reinterpret_cast<char*>(zone.NewPtr(4 KB));
+  memset(large, 1, 4 KB);
+  auto next = reinterpret_cast<uint64_t*>(zone.NewPtr(sizeof(uint64_t)));
+  // The large allocation does not consume the current zone.
+  ASSERT_EQ(small + 1, next);
+  zone.Reset();
+  ASSERT_EQ(small, reinterpret_cast<uint64_t*>(zone.NewPtr(sizeof(uint64_t))));
+}
+
+
 
 TEST_F(Heap, New_thread_random_dealloc) {
   std::atomic<uint64_t> ok(0u);
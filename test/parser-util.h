@@ -23,6 +23,7 @@
  */
 
 
+#include <memory>
 #include "../src/ir/node.h"
 #include "../src/parser/parser.h"
 #include "../src/parser/literalbuffer.h"
@@ -46,6 +47,65 @@ bool compare_node = true;
   }
 
 
+// The module and the objects that the parser needs.
+// The ir that is returned by the parser is allocated in the irfactory of this environment,
+// so the result must not be used after this environment is destroyed.
+class ParserEnvironment: private yatsc::Uncopyable, private yatsc::Unmovable {
+ public:
+  typedef yatsc::SourceStream::iterator Iterator;
+  
+  ParserEnvironment(const char* name, const yatsc::String& code, const yatsc::CompilerOption& compiler_option)
+      : compiler_option_(compiler_option),
+        module_info_(yatsc::Heap::NewHandle<yatsc::ModuleInfo>(yatsc::String(name), code, true)),
+        literal_buffer_(yatsc::Heap::NewHandle<yatsc::LiteralBuffer>()),
+        global_scope_(yatsc::Heap::NewHandle<yatsc::ir::GlobalScope>(literal_buffer_)),
+        irfactory_(yatsc::Heap::NewHandle<yatsc::ir::IRFactory>()),
+        scanner_(module_info_->source_stream()->begin(), module_info_->source_stream()->end(),
+                 literal_buffer_.Get(), compiler_option_) {}
+
+
+  // The parser scans the first token when it is created,
+  // so the scanner and the notificator must be set up before the first call.
+  yatsc::Parser<Iterator>* parser() {
+    if (!parser_) {
+      parser_.reset(new yatsc::Parser<Iterator>(compiler_option_, &scanner_, notificator_, irfactory_, module_info_, global_scope_));
+    }
+    return parser_.get();
+  }
+
+
+  YATSC_CONST_GETTER(const yatsc::CompilerOption&, compiler_option, compiler_option_)
+
+  
+  YATSC_GETTER(yatsc::Handle<yatsc::ModuleInfo>, module_info, module_info_)
+
+
+  YATSC_GETTER(yatsc::Handle<yatsc::LiteralBuffer>, literal_buffer, literal_buffer_)
+
+
+  YATSC_GETTER(yatsc::Handle<yatsc::ir::GlobalScope>, global_scope, global_scope_)
+
+
+  YATSC_GETTER(yatsc::Handle<yatsc::ir::IRFactory>, irfactory, irfactory_)
+
+
+  YATSC_GETTER(yatsc::Scanner<Iterator>*, scanner, &scanner_)
+
+
+  YATSC_GETTER(yatsc::Notificator<void(const yatsc::String&)>*, notificator, &notificator_)
+  
+ private:
+  yatsc::CompilerOption compiler_option_;
+  yatsc::Handle<yatsc::ModuleInfo> module_info_;
+  yatsc::Handle<yatsc::LiteralBuffer> literal_buffer_;
+  yatsc::Handle<yatsc::ir::GlobalScope> global_scope_;
+  yatsc::Handle<yatsc::ir::IRFactory> irfactory_;
+  yatsc::Scanner<Iterator> scanner_;
+  yatsc::Notificator<void(const yatsc::String&)> notificator_;
+  std::unique_ptr<yatsc::Parser<Iterator>> parser_;
+};
+
+
 template <typename T>
 void YatscParserTest(const char* name,
                      T fn,
@@ -55,17 +115,11 @@ void YatscParserTest(const char* name,
                      bool error,
                      int line_num) {
   using namespace yatsc;
-  typedef yatsc::SourceStream::iterator Iterator;
-  auto module_info = Heap::NewHandle<ModuleInfo>(String(name), String(code), true);
   CompilerOption compiler_option;
   compiler_option.set_language_mode(type);
-  auto lb = Heap::NewHandle<yatsc::LiteralBuffer>();
-  auto global_scope = Heap::NewHandle<yatsc::ir::GlobalScope>(lb);
-  auto irfactory = Heap::NewHandle<ir::IRFactory>();
-  
-  Scanner<Iterator> scanner(module_info->source_stream()->begin(), module_info->source_stream()->end(), lb.Get(), compiler_option);
-  Notificator<void(const yatsc::String&)> notificator;
-  Parser<Iterator> parser(compiler_option, &scanner, notificator, irfactory, module_info, global_scope);
+  ParserEnvironment env(name, String(code), compiler_option);
+  auto module_info = env.module_info();
+  Parser<ParserEnvironment::Iterator>& parser = *env.parser();
   ErrorFormatter error_formatter(module_info);
 
   ParseResult result;
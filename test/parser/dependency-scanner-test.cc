@@ -0,0 +1,80 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2013 Taketoshi Aono(brn)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#include "../gtest-header.h"
+#include "../parser-util.h"
+#include "../../src/parser/dependency-scanner.h"
+#include "../../src/parser/parallel-scanner.h"
+#include "../../src/utils/path.h"
+
+
+static void DependencyScannerTest(const char* code, std::initializer_list<const char*> expected) {
+  using namespace yatsc;
+  auto module_info = Heap::NewHandle<ModuleInfo>(String("/src/main.ts"), String(code), true);
+  CompilerOption compiler_option;
+  LiteralBuffer lb;
+  ParallelScanner parallel_scanner(module_info->source_stream(), &lb, compiler_option, 1);
+  DependencyScanner dependency_scanner(module_info, parallel_scanner.Scan());
+  
+  Vector<String> module_names = dependency_scanner.Scan();
+  ASSERT_EQ(expected.size(), module_names.size());
+  size_t i = 0;
+  for (auto path: expected) {
+    ASSERT_STREQ(Path::Join("/src", path).c_str(), module_names[i++].c_str());
+  }
+}
+
+
+TEST(DependencyScanner, Scan_import) {
+  DependencyScannerTest("import a from './a';", {"./a"});
+  DependencyScannerTest("import {a, b as c} from './b';", {"./b"});
+  DependencyScannerTest("import * as d from './d'", {"./d"});
+  DependencyScannerTest("import e, {f} from './e';\nimport './g';", {"./e", "./g"});
+  DependencyScannerTest("import h = require('./h');", {"./h"});
+  DependencyScannerTest("import i = module('./i');", {"./i"});
+}
+
+
+TEST(DependencyScanner, Scan_export) {
+  DependencyScannerTest("export * from './a';", {"./a"});
+  DependencyScannerTest("export {a, b as c} from './b';", {"./b"});
+  DependencyScannerTest("export var from = './c';", {});
+  DependencyScannerTest("export import d = require('./d');", {"./d"});
+}
+
+
+TEST(DependencyScanner, Scan_reference_path) {
+  DependencyScannerTest("/// <reference path='./a.d.ts' />\n"
+                        "import b from './b';\n"
+                        "/// <reference path='c.d.ts' />\n"
+                        "var c = 1;\n", {"./a.d.ts", "./b", "c.d.ts"});
+}
+
+
+TEST(DependencyScanner, Scan_not_module) {
+  DependencyScannerTest("import a from 'a';\n"
+                        "import b = require('b');\n"
+                        "var c = require('./c');\n"
+                        "var d = from('./d');\n"
+                        "var e = 'import f from \"./f\"';\n", {});
+}
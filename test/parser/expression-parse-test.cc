@@ -857,6 +857,28 @@ TEST(ExpressionParseTest, ParseExpression_assignment_expr) {
 }
 
 
+TEST(ExpressionParseTest, ParseExpression_nested_assignment_pattern) {
+  // The inner assignment is parsed again
+  // after the outer object literal is turned to the assignment pattern.
+  EXPR_TEST(yatsc::LanguageMode::ES6, "({a: ({a: x} = y)} = z)",
+            "[AssignmentView][Assign]\n"
+            "  [BindingPropListView]\n"
+            "    [BindingElementView]\n"
+            "      [NameView][a]\n"
+            "      [BindingElementView]\n"
+            "        [AssignmentView][Assign]\n"
+            "          [BindingPropListView]\n"
+            "            [BindingElementView]\n"
+            "              [NameView][a]\n"
+            "              [BindingElementView]\n"
+            "                [NameView][x]\n"
+            "                [Empty]\n"
+            "          [NameView][y]\n"
+            "        [Empty]\n"
+            "  [NameView][z]");
+}
+
+
 TEST(ExpressionParseTest, ParseExpression_condition_expr) {
   EXPR_TEST(yatsc::LanguageMode::ES3, "x? y: z",
             "[TemaryExprView]\n"
@@ -0,0 +1,185 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2013 Taketoshi Aono(brn)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#include <thread>
+#include "../gtest-header.h"
+#include "../../src/parser/literalbuffer.h"
+
+
+TEST(LiteralBuffer, InsertValue) {
+  yatsc::LiteralBuffer literal_buffer;
+  auto a = literal_buffer.InsertValue(yatsc::UtfString("foo"));
+  auto b = literal_buffer.InsertValue(yatsc::UtfString("bar"));
+  auto c = literal_buffer.InsertValue(yatsc::UtfString("foo"));
+  ASSERT_EQ(a, c);
+  ASSERT_NE(a, b);
+  ASSERT_TRUE(a->Equals(c));
+  ASSERT_FALSE(a->Equals(b));
+  ASSERT_STREQ("foo", a->utf8_value());
+  ASSERT_STREQ("bar", b->utf8_value());
+  ASSERT_EQ(2u, literal_buffer.size());
+}
+
+
+TEST(LiteralBuffer, InsertValue_grow) {
+  static const int kSize = 10000;
+  yatsc::LiteralBuffer literal_buffer;
+  yatsc::Vector<yatsc::Literal*> literals;
+  for (int i = 0; i < kSize; i++) {
+    yatsc::StringStream ss;
+    ss << "name" << i;
+    literals.push_back(literal_buffer.InsertValue(yatsc::UtfString(ss.str())));
+  }
+  ASSERT_EQ(static_cast<size_t>(kSize), literal_buffer.size());
+
+  // The address of the literal must not be changed by the rehash.
+  for (int i = 0; i < kSize; i++) {
+    yatsc::StringStream ss;
+    ss << "name" << i;
+    ASSERT_EQ(literals[i], literal_buffer.InsertValue(yatsc::UtfString(ss.str())));
+    ASSERT_STREQ(ss.str().c_str(), literals[i]->utf8_value());
+  }
+}
+
+
+TEST(LiteralBuffer, InsertValue_threaded) {
+  static const int kThreadCount = 8;
+  static const int kSize = 5000;
+  yatsc::LiteralBuffer literal_buffer;
+  yatsc::Vector<yatsc::Vector<yatsc::Literal*>> results(kThreadCount);
+  yatsc::Vector<yatsc::Handle<std::thread>> threads;
+  
+  for (int i = 0; i < kThreadCount; i++) {
+    yatsc::Vector<yatsc::Literal*>* result = &results[i];
+    result->resize(kSize);
+    threads.push_back(yatsc::Heap::NewHandle<std::thread>([&literal_buffer, result, i]() {
+      // Each thread interns the same names in the different order.
+      for (int j = 0; j < kSize; j++) {
+        int k = (j + i * 997) % kSize;
+        yatsc::StringStream ss;
+        ss << "name" << k;
+        (*result)[k] = literal_buffer.InsertValue(yatsc::UtfString(ss.str()));
+      }
+    }));
+  }
+  
+  for (auto& th: threads) {
+    th->join();
+  }
+
+  ASSERT_EQ(static_cast<size_t>(kSize), literal_buffer.size());
+  for (int i = 1; i < kThreadCount; i++) {
+    for (int j = 0; j < kSize; j++) {
+      ASSERT_EQ(results[0][j], results[i][j]);
+    }
+  }
+}
+
+
+TEST(LiteralBuffer, InsertValue_cached) {
+  yatsc::LiteralBuffer literal_buffer;
+  yatsc::LiteralCache* cache = yatsc::LiteralCache::Current();
+  cache->ResetStats();
+  auto a = literal_buffer.InsertValue(yatsc::UtfString("width"));
+  ASSERT_EQ(0u, cache->hit_count());
+  ASSERT_EQ(1u, cache->miss_count());
+  
+  auto b = literal_buffer.InsertValue(yatsc::UtfString("width"));
+  ASSERT_EQ(a, b);
+  ASSERT_EQ(1u, cache->hit_count());
+  ASSERT_EQ(1u, cache->miss_count());
+  ASSERT_DOUBLE_EQ(0.5, cache->hit_rate());
+  ASSERT_EQ(1u, literal_buffer.size());
+}
+
+
+TEST(LiteralBuffer, InsertValue_cached_owner) {
+  // The cache is shared by all LiteralBuffers of the thread,
+  // so the literal of the other buffer must not be returned.
+  yatsc::LiteralBuffer first;
+  yatsc::LiteralBuffer second;
+  auto a = first.InsertValue(yatsc::UtfString("this"));
+  auto b = second.InsertValue(yatsc::UtfString("this"));
+  ASSERT_NE(a, b);
+  ASSERT_EQ(a, first.InsertValue(yatsc::UtfString("this")));
+  ASSERT_EQ(b, second.InsertValue(yatsc::UtfString("this")));
+}
+
+
+TEST(LiteralBuffer, InsertValue_cached_collision) {
+  // The evicted literal must be found from the shared table.
+  static const int kSize = static_cast<int>(yatsc::LiteralCache::kCacheSize) * 4;
+  yatsc::LiteralBuffer literal_buffer;
+  yatsc::Vector<yatsc::Literal*> literals;
+  for (int i = 0; i < kSize; i++) {
+    yatsc::StringStream ss;
+    ss << "type" << i;
+    literals.push_back(literal_buffer.InsertValue(yatsc::UtfString(ss.str())));
+  }
+  for (int i = 0; i < kSize; i++) {
+    yatsc::StringStream ss;
+    ss << "type" << i;
+    ASSERT_EQ(literals[i], literal_buffer.InsertValue(yatsc::UtfString(ss.str())));
+  }
+  ASSERT_EQ(static_cast<size_t>(kSize), literal_buffer.size());
+}
+
+
+TEST(LiteralBuffer, atom) {
+  yatsc::LiteralBuffer literal_buffer;
+  auto a = literal_buffer.atom(yatsc::Atom::kConstructor);
+  ASSERT_STREQ("constructor", a->utf8_value());
+  ASSERT_TRUE(a->Is(yatsc::Atom::kConstructor));
+  ASSERT_FALSE(a->Is(yatsc::Atom::kPrototype));
+  ASSERT_EQ(a, literal_buffer.InsertValue(yatsc::UtfString("constructor")));
+  ASSERT_EQ(0u, literal_buffer.size());
+
+  auto b = literal_buffer.InsertValue(yatsc::UtfString("constructors"));
+  ASSERT_FALSE(b->Is(yatsc::Atom::kConstructor));
+  ASSERT_LE(yatsc::Unique::kReservedIdCount, b->id());
+  ASSERT_EQ(1u, literal_buffer.size());
+}
+
+
+TEST(LiteralBuffer, atom_id) {
+  // The atoms of the different buffers have the same id.
+  yatsc::LiteralBuffer first;
+  yatsc::LiteralBuffer second;
+  for (size_t i = 0; i < yatsc::kAtomCount; i++) {
+    auto atom = static_cast<yatsc::Atom>(i);
+    ASSERT_NE(first.atom(atom), second.atom(atom));
+    ASSERT_TRUE(first.atom(atom)->Equals(second.atom(atom)));
+    ASSERT_EQ(yatsc::AtomId(atom), first.atom(atom)->id());
+  }
+}
+
+
+TEST(LiteralBuffer, atom_hash) {
+  // The hash of the static atom table must be the same as the runtime hash.
+  for (size_t i = 0; i < yatsc::kAtomCount; i++) {
+    const yatsc::atoms::AtomEntry& entry = yatsc::atoms::kAtomTable[i];
+    yatsc::UtfString value(entry.value);
+    ASSERT_EQ(yatsc::LiteralBuffer::Hash(value.utf16_string()), entry.hash);
+    ASSERT_EQ(value.utf16_string().size(), entry.length);
+  }
+}
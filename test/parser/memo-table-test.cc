@@ -0,0 +1,67 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2013 Taketoshi Aono(brn)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "../gtest-header.h"
+#include "../../src/parser/memo-table.h"
+
+
+typedef yatsc::MemoTable<int, 4> Table;
+
+
+TEST(MemoTable, Insert) {
+  Table table;
+  uint64_t a = Table::MakeKey(1, 0, 10);
+  uint64_t b = Table::MakeKey(2, 0, 10);
+  uint64_t c = Table::MakeKey(1, 1, 10);
+  ASSERT_EQ(nullptr, table.Find(a));
+  table.Insert(a) = 1;
+  table.Insert(b) = 2;
+  table.Insert(c) = 3;
+  ASSERT_EQ(1, *table.Find(a));
+  ASSERT_EQ(2, *table.Find(b));
+  ASSERT_EQ(3, *table.Find(c));
+  ASSERT_EQ(3u, table.size());
+
+  // The same key returns the same slot.
+  table.Insert(a) = 4;
+  ASSERT_EQ(4, *table.Find(a));
+  ASSERT_EQ(3u, table.size());
+  ASSERT_EQ(4u, table.hit_count());
+  ASSERT_EQ(1u, table.miss_count());
+}
+
+
+TEST(MemoTable, Insert_bounded) {
+  Table table;
+  for (uint32_t i = 0; i < Table::kCapacity * 4; i++) {
+    int& slot = table.Insert(Table::MakeKey(1, 0, i));
+    slot = static_cast<int>(i);
+  }
+  // The table never grows, and the latest entries are kept.
+  ASSERT_LE(table.size(), Table::kCapacity);
+  uint32_t last = Table::kCapacity * 4 - 1;
+  ASSERT_EQ(static_cast<int>(last), *table.Find(Table::MakeKey(1, 0, last)));
+
+  size_t count = 0;
+  table.ForEach([&](int) {count++;});
+  ASSERT_EQ(table.size(), count);
+}
@@ -391,3 +391,55 @@ TEST(ModuleParser, ParseArrayExport) {
                   "            [NameView][A]\n"
                   "    [Empty]");
 }
+
+
+// Parse the code in the environment, the errors are reported to the module info of the environment.
+yatsc::ParseResult ParseForSyntaxCheck(ParserEnvironment* env) {
+  try {
+    return env->parser()->Parse();
+  } catch(const yatsc::FatalParseError& fpe) {}
+  return yatsc::ParseResult();
+}
+
+
+// The syntax check must report the same errors as the parser that builds the ir.
+void SyntaxCheckTest(const char* code, bool error) {
+  yatsc::CompilerOption checked_option;
+  checked_option.set_language_mode(yatsc::LanguageMode::ES6);
+  checked_option.set_syntax_check_only(true);
+  yatsc::CompilerOption built_option;
+  built_option.set_language_mode(yatsc::LanguageMode::ES6);
+  
+  ParserEnvironment checked_env("anonymous", yatsc::String(code), checked_option);
+  ParserEnvironment built_env("anonymous", yatsc::String(code), built_option);
+  yatsc::ParseResult checked = ParseForSyntaxCheck(&checked_env);
+  yatsc::ParseResult built = ParseForSyntaxCheck(&built_env);
+  auto checked_info = checked_env.module_info();
+  auto built_info = built_env.module_info();
+
+  ASSERT_EQ(error, checked_info->HasError());
+  ASSERT_EQ(built_info->error_reporter()->size(), checked_info->error_reporter()->size());
+  auto it = built_info->error_reporter()->begin();
+  for (auto& errd: *checked_info->error_reporter()) {
+    ASSERT_STREQ((*it)->message().c_str(), errd->message().c_str());
+    ASSERT_EQ((*it)->source_position().start_offset(), errd->source_position().start_offset());
+    ++it;
+  }
+
+  if (!error) {
+    ASSERT_TRUE(checked);
+    ASSERT_EQ(0u, checked.value()->size());
+  }
+}
+
+
+TEST(ModuleParser, ParseModule_syntax_check_only) {
+  SyntaxCheckTest("import a from 'foo/bar/baz.js';\n"
+                  "export function foo(x: number): number {return x * 2;}\n"
+                  "var b = (x => x + 1)(foo(a));\n"
+                  "class Foo extends Bar {constructor() {super();}}", false);
+  SyntaxCheckTest("var a = 1;\n"
+                  "var b = ;\n"
+                  "function foo() {return (1 +;}\n"
+                  "var c = 3;", true);
+}
@@ -0,0 +1,193 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2013 Taketoshi Aono(brn)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#include "../gtest-header.h"
+#include "../parser-util.h"
+#include "../../src/parser/parallel-parser.h"
+#include "../../src/parser/parallel-scanner.h"
+
+
+static const char* kSnippet =
+    "import {x} from './m%d';\n"
+    "var a%d = 1, b = [1, 2, 3];\n"
+    "var o = {x: function() {return a%d;}, y: 't;x'};\n"
+    "class C%d<T> {m(x: T): T {return x;}}\n"
+    "function f%d(): number;\n"
+    "function f%d(a?: number) {return a;}\n"
+    "export var e%d = f%d(1);\n"
+    "interface I%d {a: number; b(): string;}\n"
+    "enum E%d {A, B}\n"
+    "if (a%d) {b = 2;} else a%d = 3;\n"
+    "for (var i = 0; i < 3; i++) b += i;\n";
+
+
+static yatsc::String Repeat(const char* code, int count) {
+  yatsc::String ret;
+  char buffer[1024];
+  for (int i = 0; i < count; i++) {
+    snprintf(buffer, sizeof(buffer), code, i, i, i, i, i, i, i, i, i, i, i, i);
+    ret += buffer;
+  }
+  return std::move(ret);
+}
+
+
+struct ParsedModule {
+  yatsc::String tree;
+  yatsc::String errors;
+  yatsc::Vector<yatsc::String> module_names;
+  size_t segment_count;
+  bool sequential;
+};
+
+
+static ParsedModule Parse(const yatsc::String& code, size_t thread_count) {
+  using namespace yatsc;
+  CompilerOption compiler_option;
+  ParserEnvironment env("anonymous", code, compiler_option);
+  auto module_info = env.module_info();
+  ParsedModule parsed_module = {String(), String(), Vector<String>(), 0, true};
+  
+  env.notificator()->AddListener("Parser::ModuleFound", [&](const String& module_name) {
+    parsed_module.module_names.push_back(module_name);
+  });
+  
+  ParseResult result;
+  try {
+    if (thread_count == 0) {
+      result = env.parser()->Parse();
+    } else {
+      ParallelScanner parallel_scanner(module_info->source_stream(), env.literal_buffer().Get(), env.compiler_option(), 1);
+      ParallelParser parallel_parser(env.compiler_option(), *env.notificator(), env.irfactory(), module_info, env.global_scope(),
+                                     env.literal_buffer().Get(), parallel_scanner.Scan(), thread_count, 16);
+      result = parallel_parser.Parse();
+      parsed_module.segment_count = parallel_parser.segment_count();
+      parsed_module.sequential = parallel_parser.sequential();
+    }
+  } catch(const FatalParseError& fpe) {}
+
+  for (auto& errd: *module_info->error_reporter()) {
+    parsed_module.errors += errd->message();
+    parsed_module.errors += "@";
+    parsed_module.errors += std::to_string(errd->source_position().start_offset()).c_str();
+    parsed_module.errors += "\n";
+  }
+  if (result && result.value()) {
+    parsed_module.tree = result.value()->ToStringTree();
+  }
+  return parsed_module;
+}
+
+
+static void CompareModule(const yatsc::String& code, size_t thread_count, bool sequential) {
+  ParsedModule expected = Parse(code, 0);
+  ParsedModule parsed_module = Parse(code, thread_count);
+  ASSERT_FALSE(expected.tree.empty());
+  ASSERT_EQ(sequential, parsed_module.sequential);
+  if (!sequential) {
+    ASSERT_GT(parsed_module.segment_count, 1u);
+  }
+  ASSERT_STREQ(expected.tree.c_str(), parsed_module.tree.c_str());
+  ASSERT_STREQ(expected.errors.c_str(), parsed_module.errors.c_str());
+  ASSERT_EQ(expected.module_names.size(), parsed_module.module_names.size());
+  for (size_t i = 0; i < expected.module_names.size(); i++) {
+    ASSERT_STREQ(expected.module_names[i].c_str(), parsed_module.module_names[i].c_str());
+  }
+}
+
+
+TEST(ParallelParser, Parse) {
+  yatsc::String code = Repeat(kSnippet, 50);
+  CompareModule(code, 4, false);
+  CompareModule(code, 16, false);
+}
+
+
+TEST(ParallelParser, Parse_small_module) {
+  CompareModule("var x = 1;", 8, true);
+  CompareModule("function f(): number;\nfunction f() {return 1;}\n", 8, true);
+}
+
+
+TEST(ParallelParser, Parse_error) {
+  yatsc::String code = Repeat(kSnippet, 20);
+  code += "var x = ;\n";
+  code += Repeat(kSnippet, 20);
+  CompareModule(code, 8, true);
+}
+
+
+TEST(ParallelParser, Parse_regular_expression) {
+  // The tokens in the regular expression seem to be the statements,
+  // but the regular expression is scanned same as the parser, so the module is split outside of it.
+  yatsc::String code = Repeat(kSnippet, 20);
+  code += "var r = /a;";
+  code += Repeat(" var b = 1;", 100);
+  code += "/;\n";
+  code += Repeat(kSnippet, 20);
+  CompareModule(code, 8, false);
+}
+
+
+TEST(ParallelParser, Parse_regular_expression_brace) {
+  // The braces in the regular expressions are not counted.
+  yatsc::String code = "var s = /}/g;\n";
+  code += Repeat(kSnippet, 20);
+  code += "var r = /{/g;\n";
+  code += Repeat(kSnippet, 20);
+  CompareModule(code, 8, false);
+}
+
+
+TEST(ParallelParser, Parse_ambiguous_regular_expression) {
+  // The '/' after ')' is the regular expression here, but it is the division after the parenthesized expression,
+  // so the module is not split after it.
+  yatsc::String code = "if (a) /;/.test(b);\n";
+  code += Repeat(kSnippet, 20);
+  CompareModule(code, 8, true);
+}
+
+
+TEST(ParallelParser, Parse_scope) {
+  yatsc::CompilerOption compiler_option;
+  ParserEnvironment env("anonymous", Repeat(kSnippet, 50), compiler_option);
+  yatsc::ParallelScanner parallel_scanner(env.module_info()->source_stream(), env.literal_buffer().Get(), env.compiler_option(), 1);
+  yatsc::ParallelParser parallel_parser(env.compiler_option(), *env.notificator(), env.irfactory(), env.module_info(), env.global_scope(),
+                                        env.literal_buffer().Get(), parallel_scanner.Scan(), 4, 16);
+  yatsc::ParseResult result = parallel_parser.Parse();
+  ASSERT_TRUE(result);
+  ASSERT_FALSE(parallel_parser.sequential());
+
+  // The scopes of the file scope statements are the children of the module scope,
+  // same as the scopes that are made by the sequential parser.
+  yatsc::ir::FileScopeView* file_scope = result.value()->ToFileScopeView();
+  size_t block_count = 0;
+  for (auto node: file_scope->node_list()) {
+    if (node->HasIfStatementView()) {
+      yatsc::ir::BlockView* block = node->at(1)->ToBlockView();
+      ASSERT_TRUE(block->scope()->parent_scope() == file_scope->scope());
+      block_count++;
+    }
+  }
+  ASSERT_EQ(block_count, 50u);
+}
@@ -0,0 +1,155 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2013 Taketoshi Aono(brn)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#include "../gtest-header.h"
+#include "../parser-util.h"
+#include "../../src/parser/parallel-scanner.h"
+
+
+static const char* kSnippet =
+    "/**\n"
+    " * A comment which contains 'quotes\" and code like var x = 1;\n"
+    " */\n"
+    "module M {\n"
+    "  export class Foo<T> {\n"
+    "    private values: Array<Array<T>> = [];\n"
+    "    find(re = /ab+c\\/*d/g, n = 0x1F) {\n"
+    "      var s = \"it's /* not a comment */ // neither\";\n"
+    "      n >>= 1;\n"
+    "      return re.test(s) ? n * 1.5e3 : n >>> 2;\n"
+    "    }\n"
+    "  }\n"
+    "}\n";
+
+
+static yatsc::String Repeat(const char* code, int count) {
+  yatsc::String ret;
+  for (int i = 0; i < count; i++) {
+    ret += code;
+  }
+  return std::move(ret);
+}
+
+
+static void CompareTokens(const yatsc::String& code, size_t thread_count, size_t minimum_chunk_size) {
+  using namespace yatsc;
+  typedef SourceStream::iterator Iterator;
+  auto module_info = Heap::NewHandle<ModuleInfo>(String("anonymous"), code, true);
+  CompilerOption compiler_option;
+  LiteralBuffer lb;
+  size_t error_count = 0;
+
+  Scanner<Iterator> scanner(module_info->source_stream()->begin(), module_info->source_stream()->end(), &lb, compiler_option);
+  scanner.SetErrorCallback([&](const char* message, const SourcePosition& source_position) {
+    error_count++;
+  });
+  
+  Vector<Token> expected;
+  while (1) {
+    Token* token = scanner.Scan();
+    expected.push_back(*token);
+    if (token->Is(TokenKind::kEof)) {
+      break;
+    }
+  }
+
+  ParallelScanner parallel_scanner(module_info->source_stream(), &lb, compiler_option, thread_count, minimum_chunk_size);
+  auto token_array = parallel_scanner.Scan();
+  
+  ASSERT_EQ(expected.size(), token_array->size());
+  ASSERT_EQ(error_count, token_array->errors().size());
+  
+  for (size_t i = 0; i < expected.size(); i++) {
+    const Token& token = token_array->token(i);
+    const SourcePosition& expected_sp = expected[i].source_position();
+    const SourcePosition& sp = token.source_position();
+    ASSERT_EQ(expected[i].type(), token.type()) << "token " << i;
+    ASSERT_EQ(expected[i].value(), token.value()) << "token " << i;
+    ASSERT_EQ(expected_sp.start_offset(), sp.start_offset()) << "token " << i;
+    ASSERT_EQ(expected_sp.end_offset(), sp.end_offset()) << "token " << i;
+    ASSERT_EQ(expected[i].has_line_break_before_next(), token.has_line_break_before_next()) << "token " << i;
+    ASSERT_EQ(expected[i].has_line_terminator_before_next(), token.has_line_terminator_before_next()) << "token " << i;
+    ASSERT_EQ(expected[i].comment_range().begin(), token.comment_range().begin()) << "token " << i;
+    ASSERT_EQ(expected[i].comment_range().end(), token.comment_range().end()) << "token " << i;
+  }
+}
+
+
+static yatsc::String Parse(const yatsc::String& code, bool parallel) {
+  using namespace yatsc;
+  CompilerOption compiler_option;
+  ParserEnvironment env("anonymous", code, compiler_option);
+  if (parallel) {
+    ParallelScanner parallel_scanner(env.module_info()->source_stream(), env.literal_buffer().Get(), compiler_option, 8, 256);
+    env.scanner()->AttachTokenArray(parallel_scanner.Scan());
+  }
+  
+  ParseResult result;
+  try {
+    result = env.parser()->Parse();
+  } catch(const FatalParseError& fpe) {}
+  
+  EXPECT_FALSE(env.module_info()->HasError());
+  if (!result || !result.value()) {
+    return String();
+  }
+  return result.value()->ToStringTree();
+}
+
+
+TEST(ParallelScanner, Scan) {
+  yatsc::String code = Repeat(kSnippet, 100);
+  CompareTokens(code, 1, 1);
+  CompareTokens(code, 4, 1024);
+  CompareTokens(code, 8, 64);
+  CompareTokens(code, 16, 1);
+}
+
+
+TEST(ParallelScanner, Scan_seam_in_comment) {
+  yatsc::String code = "var x = 1;\n/*\n";
+  code += Repeat("  var y = 'unterminated;\n  \"string\" /* nested */\n", 200);
+  code += "*/\nvar z = x;\n";
+  CompareTokens(code, 8, 64);
+}
+
+
+TEST(ParallelScanner, Scan_seam_in_string) {
+  yatsc::String code = Repeat("var x = 'a\\\n  b = c;\\\n  var d = \"e\";';\n", 200);
+  CompareTokens(code, 8, 64);
+}
+
+
+TEST(ParallelScanner, Scan_small_source) {
+  CompareTokens("", 8, 1);
+  CompareTokens("var x = 1;", 8, 1);
+  CompareTokens("\n\n\nvar x = 1;\n\n", 8, 1);
+}
+
+
+TEST(ParallelScanner, Parse) {
+  yatsc::String code = Repeat(kSnippet, 50);
+  yatsc::String expected = Parse(code, false);
+  ASSERT_FALSE(expected.empty());
+  ASSERT_STREQ(expected.c_str(), Parse(code, true).c_str());
+}
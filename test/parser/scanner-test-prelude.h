@@ -81,6 +81,16 @@
 #define INIT_ES6_ERROR(var, str) INIT__(SCAN_ERROR__, var, str, yatsc::LanguageMode::ES6)
 
 
+#define INIT_COMMENT_POLICY(var, str, policy)                           \
+  typedef yatsc::Vector<yatsc::UChar>::iterator Iterator;               \
+  yatsc::String n = "anonymous";                                        \
+  yatsc::Handle<yatsc::ModuleInfo> module_info = yatsc::Heap::NewHandle<yatsc::ModuleInfo>(n, yatsc::String(str), true); \
+  yatsc::Vector<yatsc::UChar> v__ = yatsc::testing::AsciiToUCharVector(yatsc::String(module_info->raw_source_code())); \
+  yatsc::CompilerOption compiler_option;                                \
+  compiler_option.set_comment_policy(policy);                           \
+  SCAN__(var)
+
+
 #define END_SCAN                                          \
   {                                                       \
     auto t = scanner.Scan();                              \
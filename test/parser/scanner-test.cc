@@ -110,6 +110,7 @@ TEST(ScannerTest, ScanDigit_double) {
   INIT(token, ".3032")
   ASSERT_EQ(token->type(), yatsc::TokenKind::kNumericLiteral);
   ASSERT_STREQ(token->utf8_value(), ".3032");
+  ASSERT_EQ(token->numeric_value(), .3032);
   END_SCAN;
 }
 
@@ -123,6 +124,7 @@ TEST(ScannerTest, ScanDigit_hex) {
   INIT(token, "0xFFCC33")
   ASSERT_EQ(token->type(), yatsc::TokenKind::kNumericLiteral);
   ASSERT_STREQ(token->utf8_value(), "0xFFCC33");
+  ASSERT_EQ(token->numeric_value(), 0xFFCC33);
   END_SCAN;
 }
 
@@ -131,6 +133,7 @@ TEST(ScannerTest, ScanDigit_int) {
   INIT(token, "1349075")
   ASSERT_EQ(token->type(), yatsc::TokenKind::kNumericLiteral);
   ASSERT_STREQ(token->utf8_value(), "1349075");
+  ASSERT_EQ(token->numeric_value(), 1349075);
   END_SCAN;
 }
 
@@ -139,6 +142,7 @@ TEST(ScannerTest, ScanDigit_double2) {
   INIT(token, "1349.075")
   ASSERT_EQ(token->type(), yatsc::TokenKind::kNumericLiteral);
   ASSERT_STREQ(token->utf8_value(), "1349.075");
+  ASSERT_EQ(token->numeric_value(), 1349.075);
   END_SCAN;
 }
 
@@ -152,6 +156,7 @@ TEST(ScannerTest, ScanDigit_exponent) {
   INIT(token, "1349e+2")
   ASSERT_EQ(token->type(), yatsc::TokenKind::kNumericLiteral);
   ASSERT_STREQ(token->utf8_value(), "1349e+2");
+  ASSERT_EQ(token->numeric_value(), 134900);
   END_SCAN;
 }
 
@@ -160,6 +165,7 @@ TEST(ScannerTest, ScanDigit_exponent2) {
   INIT(token, "1.3e+1")
   ASSERT_EQ(token->type(), yatsc::TokenKind::kNumericLiteral);
   ASSERT_STREQ(token->utf8_value(), "1.3e+1");
+  ASSERT_EQ(token->numeric_value(), 13);
   END_SCAN;
 }
 
@@ -178,6 +184,7 @@ TEST(ScannerTest, ScanOcatalLiteral_valid) {
   INIT(token, "07771");
   ASSERT_EQ(token->type(), yatsc::TokenKind::kOctalLiteral);
   ASSERT_STREQ(token->utf8_value(), "07771");
+  ASSERT_EQ(token->numeric_value(), 4089);
   END_SCAN;
 }
 
@@ -187,46 +194,97 @@ TEST(ScannerTest, ScanOcatalLiteral_invalid) {
 }
 
 
+TEST(ScannerTest, ScanES6OctalLiteral_valid1) {
+  const char* octal = "0o01111001";
+  INIT_ES6(token, octal);
+  ASSERT_EQ(token->type(), yatsc::TokenKind::kOctalLiteral);
+  ASSERT_STREQ(token->utf8_value(), octal);
+  ASSERT_EQ(token->value()->utf8_length(), strlen(octal));
+  ASSERT_EQ(token->numeric_value(), 299521);
+  END_SCAN;
+}
+
+
+TEST(ScannerTest, ScanES6OctalLiteral_valid2) {
+  const char* octal = "0O01111001";
+  INIT_ES6(token, octal);
+  ASSERT_EQ(token->type(), yatsc::TokenKind::kOctalLiteral);
+  ASSERT_STREQ(token->utf8_value(), octal);
+  ASSERT_EQ(token->value()->utf8_length(), strlen(octal));
+  ASSERT_EQ(token->numeric_value(), 299521);
+  END_SCAN;
+}
+
+
+TEST(ScannerTest, ScanES6OctalLiteral_invalid1) {
+  INIT_STRICT_ERROR(token, "0o0011101");
+}
+
+
+TEST(ScannerTest, ScanES6OctalLiteral_invalid2) {
+  INIT_ERROR(token, "0o0011101");
+}
+
+
+TEST(ScannerTest, ScanES6OctalLiteral_invalid3) {
+  INIT_ES6_ERROR(token, "0ox");
+}
+
+
+TEST(ScannerTest, ScanES6OctalLiteral_invalid4) {
+  INIT_ES6_ERROR(token, "0o8");
+}
+
+
+TEST(ScannerTest, ScanES6OctalLiteral_invalid5) {
+  INIT_ES6_ERROR(token, "0o!");
+}
+
+
 TEST(ScannerTest, ScanBinaryLiteral_valid1) {
-  const char* binary = "0o01111001";
+  const char* binary = "0b01111001";
   INIT_ES6(token, binary);
   ASSERT_EQ(token->type(), yatsc::TokenKind::kBinaryLiteral);
   ASSERT_STREQ(token->utf8_value(), binary);
   ASSERT_EQ(token->value()->utf8_length(), strlen(binary));
+  ASSERT_EQ(token->numeric_value(), 121);
+  END_SCAN;
 }
 
 
 TEST(ScannerTest, ScanBinaryLiteral_valid2) {
-  const char* binary = "0O01111001";
+  const char* binary = "0B01111001";
   INIT_ES6(token, binary);
   ASSERT_EQ(token->type(), yatsc::TokenKind::kBinaryLiteral);
   ASSERT_STREQ(token->utf8_value(), binary);
   ASSERT_EQ(token->value()->utf8_length(), strlen(binary));
+  ASSERT_EQ(token->numeric_value(), 121);
+  END_SCAN;
 }
 
 
 TEST(ScannerTest, ScanBinaryLiteral_invalid1) {
-  INIT_STRICT_ERROR(token, "0o0011101");
+  INIT_STRICT_ERROR(token, "0b0011101");
 }
 
 
 TEST(ScannerTest, ScanBinaryLiteral_invalid2) {
-  INIT_ERROR(token, "0o0011101");
+  INIT_ERROR(token, "0b0011101");
 }
 
 
 TEST(ScannerTest, ScanBinaryLiteral_invalid3) {
-  INIT_ES6_ERROR(token, "0ox");
+  INIT_ES6_ERROR(token, "0b2");
 }
 
 
 TEST(ScannerTest, ScanBinaryLiteral_invalid4) {
-  INIT_ES6_ERROR(token, "0o2");
+  INIT_ES6_ERROR(token, "0bx");
 }
 
 
 TEST(ScannerTest, ScanBinaryLiteral_invalid5) {
-  INIT_ES6_ERROR(token, "0o!");
+  INIT_ES6_ERROR(token, "0b!");
 }
 
 
@@ -279,6 +337,24 @@ TEST(ScannerTest, ScanIdentifier_identifier_unicode_escape_with_ascii) {
 }
 
 
+TEST(ScannerTest, ScanIdentifier_keyword_atom) {
+  INIT(token, "this");
+  ASSERT_EQ(token->type(), yatsc::TokenKind::kThis);
+  ASSERT_TRUE(token->value()->Is(yatsc::Atom::kThis));
+  ASSERT_STREQ(token->utf8_value(), "this");
+  END_SCAN;
+}
+
+
+TEST(ScannerTest, ScanIdentifier_identifier_atom) {
+  INIT(token, "constructor");
+  ASSERT_EQ(token->type(), yatsc::TokenKind::kIdentifier);
+  ASSERT_TRUE(token->value()->Is(yatsc::Atom::kConstructor));
+  ASSERT_FALSE(token->value()->Is(yatsc::Atom::kModule));
+  END_SCAN;
+}
+
+
 TEST(ScannerTest, ScanLineTerminator_line_terminator) {
   INIT(token, "aaa;");
   ASSERT_EQ(token->type(), yatsc::TokenKind::kIdentifier);
@@ -398,7 +474,7 @@ TEST(ScannerTest, SkipMultiLineComment) {
   ASSERT_STREQ("aaa", token->utf8_value());
   const yatsc::UtfString* utf_string = token->comment();
   ASSERT_STREQ(comment_part, utf_string->utf8_value());
-  ASSERT_EQ(4u, token->source_position().start_line_number());
+  ASSERT_EQ(4u, module_info->source_stream()->GetLineNumber(token->source_position().start_offset()));
   END_SCAN;
 }
 
@@ -413,7 +489,68 @@ TEST(ScannerTest, SkipMultiLineComment_2) {
   ASSERT_STREQ("aaa", token->utf8_value());
   const yatsc::UtfString* utf_string = token->comment();
   ASSERT_STREQ(comment_part, utf_string->utf8_value());
-  ASSERT_EQ(4u, token->source_position().start_line_number());
+  ASSERT_EQ(4u, module_info->source_stream()->GetLineNumber(token->source_position().start_offset()));
+  END_SCAN;
+}
+
+
+TEST(ScannerTest, SkipMultiLineComment_span) {
+  const char* comment = "foo/*aaaaaaaa\nbbbbbbbbbb\ncccccccccccc\nddddddddddddd*/aaa";
+  const char* comment_part = "/*aaaaaaaa\nbbbbbbbbbb\ncccccccccccc\nddddddddddddd*/";
+  INIT_COMMENT_POLICY(token, comment, yatsc::CommentPolicy::SPAN);
+  ASSERT_STREQ("foo", token->utf8_value());
+  ASSERT_TRUE(token->comment_range().IsEmpty());
+  token = scanner.Scan();
+  ASSERT_STREQ("aaa", token->utf8_value());
+  ASSERT_EQ(nullptr, token->comment());
+  const yatsc::CommentRange& range = token->comment_range();
+  ASSERT_EQ(3u, range.begin());
+  ASSERT_EQ(3u + strlen(comment_part), range.end());
+  yatsc::UtfString utf_string = module_info->source_stream()->Slice(range.begin(), range.end());
+  ASSERT_STREQ(comment_part, utf_string.utf8_value());
+  ASSERT_EQ(4u, module_info->source_stream()->GetLineNumber(token->source_position().start_offset()));
+  END_SCAN;
+}
+
+
+TEST(ScannerTest, SkipMultiLineComment_span_multibyte) {
+  const char* comment = "'\xe3\x81\x82'/*\xe3\x81\x84\xe3\x81\x86*/aaa";
+  const char* comment_part = "/*\xe3\x81\x84\xe3\x81\x86*/";
+  INIT_COMMENT_POLICY(token, comment, yatsc::CommentPolicy::SPAN);
+  token = scanner.Scan();
+  ASSERT_STREQ("aaa", token->utf8_value());
+  const yatsc::CommentRange& range = token->comment_range();
+  ASSERT_EQ(5u, range.begin());
+  yatsc::UtfString utf_string = module_info->source_stream()->Slice(range.begin(), range.end());
+  ASSERT_STREQ(comment_part, utf_string.utf8_value());
+  END_SCAN;
+}
+
+
+TEST(ScannerTest, SkipMultiLineComment_drop) {
+  const char* comment = "foo/*aaaaaaaa\nbbbbbbbbbb\ncccccccccccc\nddddddddddddd*/aaa";
+  INIT_COMMENT_POLICY(token, comment, yatsc::CommentPolicy::DROP);
+  ASSERT_STREQ("foo", token->utf8_value());
+  token = scanner.Scan();
+  ASSERT_STREQ("aaa", token->utf8_value());
+  ASSERT_EQ(nullptr, token->comment());
+  ASSERT_TRUE(token->comment_range().IsEmpty());
+  ASSERT_EQ(4u, module_info->source_stream()->GetLineNumber(token->source_position().start_offset()));
+  END_SCAN;
+}
+
+
+TEST(ScannerTest, SkipMultiLineComment_full) {
+  const char* comment = "/*aaa*/foo bar";
+  INIT_COMMENT_POLICY(token, comment, yatsc::CommentPolicy::FULL);
+  ASSERT_STREQ("foo", token->utf8_value());
+  ASSERT_STREQ("/*aaa*/", token->comment()->utf8_value());
+  ASSERT_EQ(0u, token->comment_range().begin());
+  ASSERT_EQ(7u, token->comment_range().end());
+  token = scanner.Scan();
+  ASSERT_STREQ("bar", token->utf8_value());
+  ASSERT_EQ(nullptr, token->comment());
+  ASSERT_TRUE(token->comment_range().IsEmpty());
   END_SCAN;
 }
 
@@ -60,3 +60,63 @@ TEST(SourceStream, load_error) {
   ASSERT_EQ(st.size(), 0u);
   ASSERT_GT(st.failed_message().size(), 0U);
 }
+
+
+TEST(SourceStream, line_number) {
+  auto st = yatsc::SourceStream::FromSourceCode("anonymous", "var x;\nvar y;\r\nvar z;\rvar w;\n");
+  ASSERT_EQ(5u, st->line_count());
+  ASSERT_EQ(1u, st->GetLineNumber(0));
+  ASSERT_EQ(1u, st->GetLineNumber(6));
+  ASSERT_EQ(2u, st->GetLineNumber(7));
+  ASSERT_EQ(2u, st->GetLineNumber(14));
+  ASSERT_EQ(3u, st->GetLineNumber(15));
+  ASSERT_EQ(4u, st->GetLineNumber(22));
+  ASSERT_EQ(5u, st->GetLineNumber(29));
+  ASSERT_EQ(0u, st->GetLineStart(1));
+  ASSERT_EQ(7u, st->GetLineStart(2));
+  ASSERT_EQ(15u, st->GetLineStart(3));
+  ASSERT_EQ(22u, st->GetLineStart(4));
+  ASSERT_EQ(1u, st->GetColumn(0));
+  ASSERT_EQ(5u, st->GetColumn(11));
+  ASSERT_EQ(3u, st->GetColumn(24));
+}
+
+
+TEST(SourceStream, line_number_crlf_across_word) {
+  // The CRLF lies across the 64 bytes boundary of the line break bitmap.
+  yatsc::String code(63, 'a');
+  code += "\r\nb\r";
+  code += yatsc::String(64, 'c');
+  auto st = yatsc::SourceStream::FromSourceCode("anonymous", code);
+  ASSERT_EQ(3u, st->line_count());
+  ASSERT_EQ(1u, st->GetLineNumber(63));
+  ASSERT_EQ(1u, st->GetLineNumber(64));
+  ASSERT_EQ(2u, st->GetLineNumber(65));
+  ASSERT_EQ(3u, st->GetLineNumber(67));
+  ASSERT_EQ(65u, st->GetLineStart(2));
+  ASSERT_EQ(67u, st->GetLineStart(3));
+  ASSERT_EQ(st->size(), st->GetLineStart(4));
+}
+
+
+TEST(SourceStream, line_number_large) {
+  yatsc::SourceStream st(filename);
+  ASSERT_TRUE(st.success());
+  const char* buffer = st.raw_buffer();
+  size_t line_number = 1;
+  for (size_t i = 0; i < st.size(); i++) {
+    ASSERT_EQ(line_number, st.GetLineNumber(i));
+    if (buffer[i] == '\n' || (buffer[i] == '\r' && buffer[i + 1] != '\n')) {
+      line_number++;
+      ASSERT_EQ(i + 1, st.GetLineStart(line_number));
+    }
+  }
+  ASSERT_EQ(line_number, st.line_count());
+}
+
+
+TEST(SourceStream, slice) {
+  auto st = yatsc::SourceStream::FromSourceCode("anonymous", "var x = '\xe3\x81\x82';");
+  ASSERT_STREQ("x = '\xe3\x81\x82'", st->Slice(4, 13).utf8_value());
+  ASSERT_STREQ("", st->Slice(4, 4).utf8_value());
+}
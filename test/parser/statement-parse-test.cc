@@ -405,3 +405,80 @@ TEST(StatementParseTest, ParseBlockStatement) {
                      "      [NumberView][0]\n"
                      "      [Empty]");
 }
+
+
+// Parse the statement with the function bodies skipped by the preparser.
+template <typename Fn>
+void LazyStatementTest(const char* code, Fn fn) {
+  using namespace yatsc;
+  CompilerOption compiler_option;
+  compiler_option.set_language_mode(LanguageMode::ES6);
+  compiler_option.set_lazy_function_body(true);
+  ParserEnvironment env("anonymous", String(code), compiler_option);
+
+  ParseResult result = env.parser()->ParseStatement();
+  ASSERT_TRUE(result);
+  ASSERT_FALSE(env.module_info()->HasError());
+  fn(env.parser(), result.value());
+}
+
+
+TEST(StatementParseTest, ParseFunctionBody_lazy) {
+  LazyStatementTest("var x = function() {return {a: '}'} /* } */;} + 1",
+                    [](yatsc::Parser<yatsc::SourceStream::iterator>* parser, yatsc::ir::Node* node) {
+    yatsc::testing::CompareNode(__LINE__, node->ToStringTree(), yatsc::String(
+        "[VariableDeclView]\n"
+        "  [VariableView]\n"
+        "    [NameView][x]\n"
+        "    [BinaryExprView][Plus]\n"
+        "      [FunctionView]\n"
+        "        [Empty]\n"
+        "        [Empty]\n"
+        "        [CallSignatureView]\n"
+        "          [ParamList]\n"
+        "          [Empty]\n"
+        "          [Empty]\n"
+        "        [LazyFunctionBodyView]\n"
+        "      [NumberView][1]\n"
+        "    [Empty]"));
+
+    yatsc::ir::Node* function = node->first_child()->at(1)->first_child();
+    ASSERT_TRUE(parser->ParseLazyFunctionBody(function));
+    ASSERT_FALSE(parser->ParseLazyFunctionBody(function));
+    yatsc::testing::CompareNode(__LINE__, function->ToStringTree(), yatsc::String(
+        "[FunctionView]\n"
+        "  [Empty]\n"
+        "  [Empty]\n"
+        "  [CallSignatureView]\n"
+        "    [ParamList]\n"
+        "    [Empty]\n"
+        "    [Empty]\n"
+        "  [BlockView]\n"
+        "    [ReturnStatementView]\n"
+        "      [ObjectLiteralView]\n"
+        "        [ObjectElementView]\n"
+        "          [NameView][a]\n"
+        "          [StringView]['}']"));
+  });
+}
+
+
+TEST(StatementParseTest, PreparseFunctionBody_uses) {
+  LazyStatementTest("var x = function() {var r = /}/g; return `${'}'}` + arguments.length;}",
+                    [](yatsc::Parser<yatsc::SourceStream::iterator>* parser, yatsc::ir::Node* node) {
+    yatsc::ir::LazyFunctionBodyView* body = node->first_child()->at(1)->last_child()->ToLazyFunctionBodyView();
+    ASSERT_TRUE(body != nullptr);
+    ASSERT_TRUE(body->uses_arguments());
+    ASSERT_FALSE(body->uses_yield());
+    ASSERT_FALSE(body->uses_super());
+    ASSERT_FALSE(body->generator());
+  });
+
+  LazyStatementTest("var x = function* () {yield {a: 1};}",
+                    [](yatsc::Parser<yatsc::SourceStream::iterator>* parser, yatsc::ir::Node* node) {
+    yatsc::ir::LazyFunctionBodyView* body = node->first_child()->at(1)->last_child()->ToLazyFunctionBodyView();
+    ASSERT_TRUE(body != nullptr);
+    ASSERT_TRUE(body->uses_yield());
+    ASSERT_TRUE(body->generator());
+  });
+}
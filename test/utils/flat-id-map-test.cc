@@ -21,22 +21,46 @@
 // THE SOFTWARE.
 
 
-#ifndef IR_DEPTH_FIRST_CALLBACK_H
-#define IR_DEPTH_FIRST_CALLBACK_H
+#include "../gtest-header.h"
+#include "../../src/utils/flat-id-map.h"
 
-namespace yatsc {
 
-class DepthFirstCallback {
- public:
-  DepthFirstCallback() = default;
+static const uint32_t kCount = 1000;
+static const uint32_t kNotFound = yatsc::FlatIdMap::kNotFound;
 
 
-  ~DepthFirstCallback() = default;
+TEST(FlatIdMap, Set) {
+  yatsc::FlatIdMap map;
+  ASSERT_EQ(map.Find(1), kNotFound);
+  for (uint32_t i = 0; i < kCount; i++) {
+    map.Set(i + 256, i);
+  }
+  ASSERT_EQ(map.size(), kCount);
+  for (uint32_t i = 0; i < kCount; i++) {
+    ASSERT_EQ(map.Find(i + 256), i);
+  }
+  ASSERT_EQ(map.Find(kCount + 256), kNotFound);
 
+  // The value of the same id is overwritten.
+  map.Set(256, 10);
+  ASSERT_EQ(map.size(), kCount);
+  ASSERT_EQ(map.Find(256), 10u);
+}
 
-  void Visit(Handle<ir::Node> node, Handle<ir::Node> root);
-};
 
+TEST(FlatIdMap, Erase) {
+  yatsc::FlatIdMap map;
+  for (uint32_t i = 0; i < kCount; i++) {
+    map.Set(i + 256, i);
+  }
+  // The entries that are moved back by the erase are still found.
+  for (uint32_t i = 0; i < kCount; i += 2) {
+    map.Erase(i + 256);
+  }
+  ASSERT_EQ(map.size(), kCount / 2);
+  for (uint32_t i = 0; i < kCount; i++) {
+    ASSERT_EQ(map.Find(i + 256), i % 2 == 0? kNotFound: i);
+  }
+  map.Erase(kCount + 256);
+  ASSERT_EQ(map.size(), kCount / 2);
 }
-
-#endif
@@ -0,0 +1,149 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2013 Taketoshi Aono(brn)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include "../gtest-header.h"
+#include "../../src/utils/number-converter.h"
+
+
+static double ParseDecimal(const char* str) {
+  return yatsc::NumberConverter::ParseDecimal(str, str + strlen(str));
+}
+
+
+#define DECIMAL_TEST(str) ASSERT_EQ(ParseDecimal(str), strtod(str, nullptr)) << str;
+
+
+TEST(NumberConverter, ParseDecimal) {
+  DECIMAL_TEST("0");
+  DECIMAL_TEST("0.0");
+  DECIMAL_TEST("12345");
+  DECIMAL_TEST("1.5");
+  DECIMAL_TEST(".3032");
+  DECIMAL_TEST("1349.075");
+  DECIMAL_TEST("1349e+2");
+  DECIMAL_TEST("1.3e-10");
+  DECIMAL_TEST("0.1");
+  DECIMAL_TEST("0.3");
+  DECIMAL_TEST("9007199254740993");
+  DECIMAL_TEST("123456789012345678901234567890");
+  DECIMAL_TEST("0.000000000000000000000000000000000000001234");
+  DECIMAL_TEST("1.7976931348623157e308");
+  DECIMAL_TEST("2.2250738585072014e-308");
+}
+
+
+TEST(NumberConverter, ParseDecimal_hard_cases) {
+  // Just on the half way between the two doubles.
+  DECIMAL_TEST("9007199254740993.0");
+  DECIMAL_TEST("9007199254740993.00000000000000000000000001");
+  DECIMAL_TEST("2.4703282292062327e-324");
+  DECIMAL_TEST("4.9406564584124654e-324");
+  DECIMAL_TEST("7.2057594037927933e16");
+  DECIMAL_TEST("1e-400");
+  DECIMAL_TEST("1e400");
+  DECIMAL_TEST("8.98846567431158e307");
+}
+
+
+TEST(NumberConverter, ParseDecimal_trailing_characters) {
+  const char* str = "1e5+";
+  ASSERT_EQ(yatsc::NumberConverter::ParseDecimal(str, str + strlen(str)), 100000);
+  str = "1.5;";
+  ASSERT_EQ(yatsc::NumberConverter::ParseDecimal(str, str + strlen(str)), 1.5);
+}
+
+
+TEST(NumberConverter, ParseDecimal_random) {
+  std::mt19937_64 engine(1234);
+  char buffer[64];
+  for (int i = 0; i < 100000; i++) {
+    uint64_t bits = engine();
+    double expected;
+    memcpy(&expected, &bits, sizeof(double));
+    if (std::isnan(expected) || std::isinf(expected)) {
+      continue;
+    }
+    expected = fabs(expected);
+    snprintf(buffer, sizeof(buffer), "%.17g", expected);
+    ASSERT_EQ(ParseDecimal(buffer), expected) << buffer;
+    snprintf(buffer, sizeof(buffer), "%.*g", static_cast<int>(engine() % 17) + 1, expected);
+    DECIMAL_TEST(buffer);
+  }
+}
+
+
+TEST(NumberConverter, EiselLemire) {
+  double result;
+  ASSERT_TRUE(yatsc::NumberConverter::EiselLemire(1, 0, &result));
+  ASSERT_EQ(result, 1.0);
+  ASSERT_TRUE(yatsc::NumberConverter::EiselLemire(3, -1, &result));
+  ASSERT_EQ(result, 0.3);
+  ASSERT_FALSE(yatsc::NumberConverter::EiselLemire(1, 400, &result));
+}
+
+
+TEST(NumberConverter, ParseHex) {
+  const char* str = "0xFFCC33";
+  ASSERT_EQ(yatsc::NumberConverter::ParseHex(str, str + strlen(str)), 0xFFCC33);
+  str = "0Xff";
+  ASSERT_EQ(yatsc::NumberConverter::ParseHex(str, str + strlen(str)), 255);
+  str = "0x20000000000001";
+  ASSERT_EQ(yatsc::NumberConverter::ParseHex(str, str + strlen(str)), 9007199254740992.0);
+  str = "0x20000000000003";
+  ASSERT_EQ(yatsc::NumberConverter::ParseHex(str, str + strlen(str)), 9007199254740996.0);
+  str = "0x200000000000010000000000000000001";
+  ASSERT_EQ(yatsc::NumberConverter::ParseHex(str, str + strlen(str)), ldexp(0x20000000000002, 76));
+  str = "0xFFFFFFFFFFFFFFFFFF";
+  ASSERT_EQ(yatsc::NumberConverter::ParseHex(str, str + strlen(str)), ldexp(1.0, 72));
+}
+
+
+TEST(NumberConverter, ParseOctal) {
+  const char* str = "0o777";
+  ASSERT_EQ(yatsc::NumberConverter::ParseOctal(str, str + strlen(str)), 511);
+  str = "0O01111001";
+  ASSERT_EQ(yatsc::NumberConverter::ParseOctal(str, str + strlen(str)), 299521);
+  str = "0b0111";
+  ASSERT_TRUE(std::isnan(yatsc::NumberConverter::ParseOctal(str, str + strlen(str))));
+  str = "07771";
+  ASSERT_EQ(yatsc::NumberConverter::ParseLegacyOctal(str, str + strlen(str)), 4089);
+  str = "0779";
+  ASSERT_EQ(yatsc::NumberConverter::ParseLegacyOctal(str, str + strlen(str)), 779);
+}
+
+
+TEST(NumberConverter, ParseBinary) {
+  const char* str = "0b01111001";
+  ASSERT_EQ(yatsc::NumberConverter::ParseBinary(str, str + strlen(str)), 121);
+  str = "0B01111001";
+  ASSERT_EQ(yatsc::NumberConverter::ParseBinary(str, str + strlen(str)), 121);
+  str = "0o01111001";
+  ASSERT_TRUE(std::isnan(yatsc::NumberConverter::ParseBinary(str, str + strlen(str))));
+  str = "0x0111";
+  ASSERT_TRUE(std::isnan(yatsc::NumberConverter::ParseBinary(str, str + strlen(str))));
+}
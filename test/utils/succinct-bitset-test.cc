@@ -0,0 +1,112 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2013 Taketoshi Aono(brn)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#include <random>
+#include "../gtest-header.h"
+#include "../../src/utils/succinct-bitset.h"
+
+
+// Build the bitset and the expected flaged positions by the random bits.
+void SetRandomBits(yatsc::SuccinctBitset* bitset, yatsc::Vector<size_t>* positions, size_t size, unsigned density) {
+  std::mt19937 random(size);
+  bitset->Resize(size);
+  for (size_t i = 0; i < size; i++) {
+    if (random() % density == 0) {
+      bitset->Set(i, true);
+      positions->push_back(i);
+    }
+  }
+  bitset->Build();
+}
+
+
+TEST(SuccinctBitset, Set) {
+  yatsc::SuccinctBitset bitset(200);
+  bitset.Set(0, true);
+  bitset.Set(63, true);
+  bitset.Set(64, true);
+  bitset.Set(199, true);
+  bitset.Set(64, false);
+  ASSERT_TRUE(bitset.Get(0));
+  ASSERT_TRUE(bitset.Get(63));
+  ASSERT_FALSE(bitset.Get(64));
+  ASSERT_TRUE(bitset.Get(199));
+  ASSERT_FALSE(bitset.Get(100));
+}
+
+
+TEST(SuccinctBitset, SetWord) {
+  yatsc::SuccinctBitset bitset(128);
+  bitset.SetWord(1, 0x8000000000000001ULL);
+  bitset.Build();
+  ASSERT_TRUE(bitset.Get(64));
+  ASSERT_TRUE(bitset.Get(127));
+  ASSERT_EQ(2u, bitset.count());
+}
+
+
+TEST(SuccinctBitset, Rank) {
+  yatsc::SuccinctBitset bitset;
+  yatsc::Vector<size_t> positions;
+  SetRandomBits(&bitset, &positions, 5000, 7);
+  size_t rank = 0;
+  for (size_t i = 0; i <= bitset.size(); i++) {
+    ASSERT_EQ(rank, bitset.Rank(i));
+    if (i < bitset.size() && bitset.Get(i)) {
+      rank++;
+    }
+  }
+  ASSERT_EQ(positions.size(), bitset.count());
+}
+
+
+TEST(SuccinctBitset, Select) {
+  yatsc::SuccinctBitset bitset;
+  yatsc::Vector<size_t> positions;
+  SetRandomBits(&bitset, &positions, 5000, 7);
+  for (size_t i = 0; i < positions.size(); i++) {
+    ASSERT_EQ(positions[i], bitset.Select(i + 1));
+  }
+  ASSERT_EQ(bitset.size(), bitset.Select(positions.size() + 1));
+  ASSERT_EQ(bitset.size(), bitset.Select(0));
+}
+
+
+TEST(SuccinctBitset, Select_sparse) {
+  yatsc::SuccinctBitset bitset;
+  yatsc::Vector<size_t> positions;
+  SetRandomBits(&bitset, &positions, 100000, 3000);
+  for (size_t i = 0; i < positions.size(); i++) {
+    ASSERT_EQ(positions[i], bitset.Select(i + 1));
+    ASSERT_EQ(i, bitset.Rank(positions[i]));
+  }
+}
+
+
+TEST(SuccinctBitset, Empty) {
+  yatsc::SuccinctBitset bitset;
+  bitset.Build();
+  ASSERT_EQ(0u, bitset.count());
+  ASSERT_EQ(0u, bitset.Rank(0));
+  ASSERT_EQ(0u, bitset.Select(1));
+}